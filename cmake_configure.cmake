@@ -126,6 +126,13 @@ if(ENABLE_SCRIPT_DEBUG)
     )
 endif()
 
+if(ENABLE_SCRIPT_PROFILING)
+    target_compile_definitions(rw_interface
+        INTERFACE
+            "RW_SCRIPT_PROFILER"
+    )
+endif()
+
 if(FAILED_CHECK_ACTION STREQUAL "IGNORE")
     target_compile_definitions(rw_interface INTERFACE "RW_FAILED_CHECK_ACTION=0")
 elseif(FAILED_CHECK_ACTION STREQUAL "ABORT")
@@ -136,6 +143,18 @@ else()
     message(FATAL_ERROR "Illegal FAILED_CHECK_ACTION option. (was '${FAILED_CHECK_ACTION}')")
 endif()
 
+if(LOG_MIN_SEVERITY STREQUAL "VERBOSE")
+    target_compile_definitions(rw_interface INTERFACE "RW_LOG_MIN_SEVERITY=0")
+elseif(LOG_MIN_SEVERITY STREQUAL "INFO")
+    target_compile_definitions(rw_interface INTERFACE "RW_LOG_MIN_SEVERITY=1")
+elseif(LOG_MIN_SEVERITY STREQUAL "WARNING")
+    target_compile_definitions(rw_interface INTERFACE "RW_LOG_MIN_SEVERITY=2")
+elseif(LOG_MIN_SEVERITY STREQUAL "ERROR")
+    target_compile_definitions(rw_interface INTERFACE "RW_LOG_MIN_SEVERITY=3")
+else()
+    message(FATAL_ERROR "Illegal LOG_MIN_SEVERITY option. (was '${LOG_MIN_SEVERITY}')")
+endif()
+
 if(TEST_COVERAGE)
     include(CodeCoverage)
     codecoverage_enable("${PROJECT_BINARY_DIR}" "${PROJECT_BINARY_DIR}/codecoverage")
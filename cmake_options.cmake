@@ -5,6 +5,7 @@ option(BUILD_TESTS "Build test suite")
 option(BUILD_VIEWER "Build GUI data viewer")
 
 option(ENABLE_SCRIPT_DEBUG "Enable verbose script execution")
+option(ENABLE_SCRIPT_PROFILING "Enable per-opcode and per-thread script profiling")
 option(ENABLE_PROFILING "Enable detailed profiling metrics")
 
 option(TEST_DATA "Enable tests that require game data")
@@ -12,6 +13,9 @@ option(TEST_DATA "Enable tests that require game data")
 set(FAILED_CHECK_ACTION "IGNORE" CACHE STRING "What action to perform on a failed RW_CHECK (in debug mode)")
 set_property(CACHE FAILED_CHECK_ACTION PROPERTY STRINGS "IGNORE" "ABORT" "BREAKPOINT")
 
+set(LOG_MIN_SEVERITY "VERBOSE" CACHE STRING "Log messages below this severity are compiled out")
+set_property(CACHE LOG_MIN_SEVERITY PROPERTY STRINGS "VERBOSE" "INFO" "WARNING" "ERROR")
+
 set(CMAKE_CONFIGURATION_TYPES "Release;Debug;RelWithDebInfo;MinSizeRel" CACHE INTERNAL "Build types supported by this project.")
 if(NOT CMAKE_BUILD_TYPE)
     set(CMAKE_BUILD_TYPE Release CACHE STRING "Choose the type of build, options are: ${CMAKE_CONFIGURATION_TYPES}")
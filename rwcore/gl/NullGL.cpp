@@ -0,0 +1,78 @@
+#include "gl/NullGL.hpp"
+
+#include <atomic>
+
+#include "gl/gl_core_3_3.h"
+
+namespace {
+std::atomic<GLuint> nextName{1};
+
+void CODEGEN_FUNCPTR genNames(GLsizei n, GLuint* names) {
+    for (GLsizei i = 0; i < n; ++i) {
+        names[i] = nextName++;
+    }
+}
+
+void CODEGEN_FUNCPTR deleteNames(GLsizei, const GLuint*) {
+}
+
+void CODEGEN_FUNCPTR bindName(GLenum, GLuint) {
+}
+
+void CODEGEN_FUNCPTR bindVertexArray(GLuint) {
+}
+
+void CODEGEN_FUNCPTR bufferData(GLenum, GLsizeiptr, const void*, GLenum) {
+}
+
+void CODEGEN_FUNCPTR bufferSubData(GLenum, GLintptr, GLsizeiptr,
+                                   const void*) {
+}
+
+void CODEGEN_FUNCPTR texImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint,
+                                GLenum, GLenum, const void*) {
+}
+
+void CODEGEN_FUNCPTR texImage3D(GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei,
+                                GLint, GLenum, GLenum, const void*) {
+}
+
+void CODEGEN_FUNCPTR texParameteri(GLenum, GLenum, GLint) {
+}
+
+void CODEGEN_FUNCPTR generateMipmap(GLenum) {
+}
+
+void CODEGEN_FUNCPTR pixelStorei(GLenum, GLint) {
+}
+
+void CODEGEN_FUNCPTR enableVertexAttribArray(GLuint) {
+}
+
+void CODEGEN_FUNCPTR vertexAttribPointer(GLuint, GLint, GLenum, GLboolean,
+                                         GLsizei, const void*) {
+}
+}  // namespace
+
+void installNullGL() {
+    _ptrc_glGenBuffers = genNames;
+    _ptrc_glDeleteBuffers = deleteNames;
+    _ptrc_glBindBuffer = bindName;
+    _ptrc_glBufferData = bufferData;
+    _ptrc_glBufferSubData = bufferSubData;
+
+    _ptrc_glGenTextures = genNames;
+    _ptrc_glDeleteTextures = deleteNames;
+    _ptrc_glBindTexture = bindName;
+    _ptrc_glTexImage2D = texImage2D;
+    _ptrc_glTexImage3D = texImage3D;
+    _ptrc_glTexParameteri = texParameteri;
+    _ptrc_glGenerateMipmap = generateMipmap;
+    _ptrc_glPixelStorei = pixelStorei;
+
+    _ptrc_glGenVertexArrays = genNames;
+    _ptrc_glDeleteVertexArrays = deleteNames;
+    _ptrc_glBindVertexArray = bindVertexArray;
+    _ptrc_glEnableVertexAttribArray = enableVertexAttribArray;
+    _ptrc_glVertexAttribPointer = vertexAttribPointer;
+}
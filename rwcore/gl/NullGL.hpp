@@ -0,0 +1,14 @@
+#ifndef _LIBRW_NULLGL_HPP_
+#define _LIBRW_NULLGL_HPP_
+
+/**
+ * Replaces the GL functions used by the loaders and buffers with stubs that
+ * do nothing, so models and textures can be loaded without a GL context.
+ * Generated names are still unique and non-zero.
+ *
+ * Must be called before anything is loaded, and only by programs that never
+ * render.
+ */
+void installNullGL();
+
+#endif
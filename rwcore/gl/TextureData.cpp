@@ -1 +1,39 @@
 #include "gl/TextureData.hpp"
+
+#include "gl/TextureUploader.hpp"
+
+TextureData::~TextureData() {
+    if (uploader) {
+        uploader->cancel(this);
+    }
+    // Layers share the name of the array
+    if (!array) {
+        glDeleteTextures(1, &texName);
+    }
+    if (paletteName) {
+        glDeleteTextures(1, &paletteName);
+    }
+}
+
+std::unique_ptr<TextureData> TextureData::createLayer(
+    std::shared_ptr<TextureData> array, int layer, int layerCount,
+    bool transparent) {
+    auto data = create(array->getName(), array->getSize(), transparent);
+    data->target = array->getTarget();
+    data->memorySize = array->getMemorySize() / layerCount;
+    data->layer = layer;
+    data->array = std::move(array);
+    return data;
+}
+
+void TextureMemoryReport::add(const TextureData& texture) {
+    if (texture.isPaletted()) {
+        paletted.count++;
+        paletted.bytes += texture.getMemorySize() - DecodedTexture::kPaletteSize;
+        palettes.count++;
+        palettes.bytes += DecodedTexture::kPaletteSize;
+    } else {
+        rgba.count++;
+        rgba.bytes += texture.getMemorySize();
+    }
+}
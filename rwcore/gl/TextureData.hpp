@@ -4,22 +4,28 @@
 #include <gl/gl_core_3_3.h>
 #include <glm/vec2.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+class TextureUploader;
 
 /**
  * Stores a handle and metadata about a loaded texture.
  */
 class TextureData {
+    friend class TextureUploader;
+
 public:
     TextureData(GLuint name, const glm::ivec2& dims, bool alpha)
         : texName(name), size(dims), hasAlpha(alpha) {
     }
 
-    ~TextureData() {
-        glDeleteTextures(1, &texName);
-    }
+    ~TextureData();
 
     GLuint getName() const {
         return texName;
@@ -33,16 +39,150 @@ public:
         return hasAlpha;
     }
 
+    /**
+     * @return false while larger mip levels are still waiting to be uploaded
+     */
+    bool isComplete() const {
+        return array ? array->isComplete() : uploader == nullptr;
+    }
+
+    /**
+     * @return GL_TEXTURE_2D_ARRAY for texture arrays and their layers
+     */
+    GLenum getTarget() const {
+        return target;
+    }
+
+    /**
+     * @return true if the texture is a layer of a texture array, getName()
+     * is the array then
+     */
+    bool isArrayLayer() const {
+        return array != nullptr;
+    }
+
+    int getLayer() const {
+        return layer;
+    }
+
+    /**
+     * @return true if the texture holds 8 bit palette indices, which the
+     * shaders look up in the palette texture
+     */
+    bool isPaletted() const {
+        return paletteName != 0;
+    }
+
+    GLuint getPaletteName() const {
+        return paletteName;
+    }
+
+    /**
+     * @return Bytes used by all mip levels and the palette once uploaded
+     */
+    std::size_t getMemorySize() const {
+        return memorySize;
+    }
+
+    /**
+     * Record that the texture is drawn in frame
+     */
+    void markUsed(std::uint64_t frame) {
+        lastUsedFrame = frame;
+    }
+
+    std::uint64_t getLastUsedFrame() const {
+        return lastUsedFrame;
+    }
+
     static auto create(GLuint name, const glm::ivec2& size,
                          bool transparent) {
         return std::make_unique<TextureData>(name, size, transparent);
     }
 
+    /**
+     * Create a texture for one layer of array, which it keeps alive
+     */
+    static std::unique_ptr<TextureData> createLayer(
+        std::shared_ptr<TextureData> array, int layer, int layerCount,
+        bool transparent);
+
 private:
     GLuint texName;
+    GLuint paletteName = 0;
+    GLenum target = GL_TEXTURE_2D;
+    /// The texture array this is a layer of
+    std::shared_ptr<TextureData> array;
+    int layer = 0;
     glm::ivec2 size;
     bool hasAlpha;
+    std::size_t memorySize = 0;
+    std::uint64_t lastUsedFrame = 0;
+    /// Set while the uploader still has levels of this texture
+    TextureUploader* uploader = nullptr;
 };
 using TextureArchive = std::unordered_map<std::string, std::unique_ptr<TextureData>>;
 
+/**
+ * Counts the memory used by textures, by how they are stored.
+ */
+struct TextureMemoryReport {
+    struct Entry {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+    };
+
+    Entry rgba;
+    /// Palette indices, without the palettes
+    Entry paletted;
+    Entry palettes;
+
+    void add(const TextureData& texture);
+
+    std::size_t getTotalBytes() const {
+        return rgba.bytes + paletted.bytes + palettes.bytes;
+    }
+};
+
+/**
+ * Pixels and sampling parameters of a texture that isn't uploaded yet.
+ * Creating one doesn't need GL, so it can happen on any thread.
+ */
+struct DecodedTexture {
+    std::string name;
+    glm::ivec2 size{};
+    bool transparent = false;
+    GLenum magFilter = GL_LINEAR;
+    GLenum wrapS = GL_REPEAT;
+    GLenum wrapT = GL_REPEAT;
+    /// Pixels of each mip level, down to 1x1, the full size first.
+    /// RGBA8, or 8 bit indices if the texture has a palette.
+    std::vector<std::vector<std::uint8_t>> levels;
+    /// 256 RGBA8 entries, empty unless the texture keeps its palette
+    std::vector<std::uint8_t> palette;
+
+    /// A texture packed into a texture array
+    struct Layer {
+        std::string name;
+        bool transparent;
+    };
+    /// Textures in each layer of a texture array, each level then holds
+    /// the pixels of all layers one after the other. Empty for 2D textures.
+    std::vector<Layer> layers;
+
+    static constexpr std::size_t kPaletteSize = 256 * 4;
+
+    bool isPaletted() const {
+        return !palette.empty();
+    }
+
+    bool isArray() const {
+        return !layers.empty();
+    }
+
+    glm::ivec2 getLevelSize(std::size_t level) const {
+        return {std::max(size.x >> level, 1), std::max(size.y >> level, 1)};
+    }
+};
+
 #endif
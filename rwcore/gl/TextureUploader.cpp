@@ -0,0 +1,157 @@
+#include "gl/TextureUploader.hpp"
+
+#include <algorithm>
+
+#include "rw/debug.hpp"
+
+namespace {
+GLenum getTarget(const DecodedTexture& texture) {
+    return texture.isArray() ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+}
+
+GLuint createTexture(const DecodedTexture& texture) {
+    const auto target = getTarget(texture);
+    GLuint name = 0;
+    glGenTextures(1, &name);
+    glBindTexture(target, name);
+    if (texture.isPaletted()) {
+        // Filtering happens in the shader, after the palette lookup
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER,
+                        GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    } else {
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER,
+                        GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, texture.magFilter);
+    }
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, texture.wrapS);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, texture.wrapT);
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL,
+                    static_cast<GLint>(texture.levels.size()) - 1);
+    return name;
+}
+
+GLuint createPalette(const DecodedTexture& texture) {
+    GLuint name = 0;
+    glGenTextures(1, &name);
+    glBindTexture(GL_TEXTURE_2D, name);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 1, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, texture.palette.data());
+    return name;
+}
+
+/// Upload one level of the bound texture and make it the base level
+void uploadLevel(const DecodedTexture& texture, int level) {
+    const auto size = texture.getLevelSize(level);
+    const auto target = getTarget(texture);
+    if (texture.isPaletted()) {
+        // Rows of indices aren't padded to 4 bytes
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, level, GL_R8, size.x, size.y, 0, GL_RED,
+                     GL_UNSIGNED_BYTE, texture.levels[level].data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    } else if (texture.isArray()) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA, size.x, size.y,
+                     static_cast<GLsizei>(texture.layers.size()), 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, texture.levels[level].data());
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, size.x, size.y, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, texture.levels[level].data());
+    }
+    glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, level);
+}
+}  // namespace
+
+std::unique_ptr<TextureData> TextureUploader::createTextureData(
+    const DecodedTexture& texture) {
+    std::size_t memorySize = texture.palette.size();
+    for (const auto& level : texture.levels) {
+        memorySize += level.size();
+    }
+
+    GLuint palette = 0;
+    if (texture.isPaletted()) {
+        palette = createPalette(texture);
+    }
+    // Created last, so it stays bound for the uploads
+    auto data = TextureData::create(createTexture(texture), texture.size,
+                                    texture.transparent);
+    data->paletteName = palette;
+    data->target = getTarget(texture);
+    data->memorySize = memorySize;
+    return data;
+}
+
+TextureUploader::~TextureUploader() {
+    for (auto& p : pending) {
+        p.texture->uploader = nullptr;
+    }
+}
+
+std::unique_ptr<TextureData> TextureUploader::add(DecodedTexture&& texture) {
+    RW_ASSERT(!texture.levels.empty());
+    auto data = createTextureData(texture);
+
+    // The smallest level always goes up, so the texture is complete
+    int level = static_cast<int>(texture.levels.size()) - 1;
+    do {
+        uploadLevel(texture, level--);
+    } while (level >= 0 &&
+             texture.levels[level].size() <= kImmediateLevelBytes);
+
+    if (level >= 0) {
+        for (int i = 0; i <= level; ++i) {
+            pendingBytes += texture.levels[i].size();
+        }
+        data->uploader = this;
+        pending.push_back({data.get(), std::move(texture), level});
+    }
+    return data;
+}
+
+std::unique_ptr<TextureData> TextureUploader::upload(
+    const DecodedTexture& texture) {
+    auto data = createTextureData(texture);
+    for (int level = static_cast<int>(texture.levels.size()) - 1; level >= 0;
+         --level) {
+        uploadLevel(texture, level);
+    }
+    return data;
+}
+
+std::size_t TextureUploader::process(std::size_t byteBudget) {
+    std::size_t uploaded = 0;
+    while (!pending.empty() && (uploaded == 0 || uploaded < byteBudget)) {
+        auto& next = pending.front();
+        glBindTexture(next.texture->getTarget(), next.texture->getName());
+        while (next.level >= 0) {
+            const auto bytes = next.decoded.levels[next.level].size();
+            // A level larger than the budget still goes up on its own
+            if (uploaded != 0 && uploaded + bytes > byteBudget) {
+                return uploaded;
+            }
+            uploadLevel(next.decoded, next.level--);
+            uploaded += bytes;
+            pendingBytes -= bytes;
+        }
+        next.texture->uploader = nullptr;
+        pending.pop_front();
+    }
+    return uploaded;
+}
+
+void TextureUploader::cancel(TextureData* texture) {
+    auto it = std::find_if(
+        pending.begin(), pending.end(),
+        [&](const PendingTexture& p) { return p.texture == texture; });
+    if (it == pending.end()) {
+        return;
+    }
+    for (int i = 0; i <= it->level; ++i) {
+        pendingBytes -= it->decoded.levels[i].size();
+    }
+    texture->uploader = nullptr;
+    pending.erase(it);
+}
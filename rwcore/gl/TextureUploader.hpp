@@ -0,0 +1,78 @@
+#ifndef _LIBRW_TEXTUREUPLOADER_HPP_
+#define _LIBRW_TEXTUREUPLOADER_HPP_
+
+#include <gl/TextureData.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+/**
+ * Uploads decoded textures on the GL thread, spread over several frames.
+ *
+ * A texture can be used as soon as it's added: its small mip levels are
+ * uploaded right away, and the larger ones follow within the byte budget of
+ * each process() call, lowering the texture's base level as they arrive.
+ */
+class TextureUploader {
+public:
+    /// Levels up to this size are uploaded when a texture is added
+    static constexpr std::size_t kImmediateLevelBytes = 16 * 1024;
+    /// Bytes to upload per frame
+    static constexpr std::size_t kDefaultFrameBudget = 2 * 1024 * 1024;
+
+    TextureUploader() = default;
+    ~TextureUploader();
+
+    TextureUploader(const TextureUploader&) = delete;
+    TextureUploader& operator=(const TextureUploader&) = delete;
+
+    /**
+     * Create the texture and upload its smallest levels, the rest is
+     * uploaded by process()
+     */
+    std::unique_ptr<TextureData> add(DecodedTexture&& texture);
+
+    /**
+     * Create the texture with all of its levels
+     */
+    static std::unique_ptr<TextureData> upload(const DecodedTexture& texture);
+
+    /**
+     * Upload the pending levels, from the oldest texture, without going over
+     * byteBudget. At least one level is uploaded if any is pending, even if
+     * it's larger than the budget.
+     * @return Number of bytes uploaded
+     */
+    std::size_t process(std::size_t byteBudget);
+
+    /**
+     * Forget the pending levels of texture, called when it's destroyed
+     */
+    void cancel(TextureData* texture);
+
+    std::size_t getPendingCount() const {
+        return pending.size();
+    }
+
+    std::size_t getPendingBytes() const {
+        return pendingBytes;
+    }
+
+private:
+    /// Create the texture and its palette, without uploading any level
+    static std::unique_ptr<TextureData> createTextureData(
+        const DecodedTexture& texture);
+
+    struct PendingTexture {
+        TextureData* texture;
+        DecodedTexture decoded;
+        /// Next level to upload, uploaded from the smallest to level 0
+        int level;
+    };
+
+    std::deque<PendingTexture> pending;
+    std::size_t pendingBytes = 0;
+};
+
+#endif
@@ -81,6 +81,12 @@ public:
     size_t getAssetCount() const;
 
     Version getVersion() const;
+
+    /// Path to the raw archive holding the samples
+    const std::string& getArchivePath() const {
+        return m_archive;
+    }
+
     LoaderSDTFile assetInfo{};
 private:
     Version m_version{GTAIIIVC};      ///< Version of this SDT archive
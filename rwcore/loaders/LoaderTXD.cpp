@@ -4,58 +4,174 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
+#include "gl/TextureUploader.hpp"
 #include "gl/gl_core_3_3.h"
 #include "loaders/RWBinaryStream.hpp"
 #include "platform/FileHandle.hpp"
 #include "rw/debug.hpp"
 
 namespace {
-constexpr GLuint gErrorTextureData[] = {0xFFFF00FF, 0xFF000000, 0xFF000000, 0xFFFF00FF};
-constexpr GLuint gDebugTextureData[] = {0xFF0000FF, 0xFF00FF00};
-constexpr GLuint gTextureRed[] = {0xFF0000FF};
-constexpr GLuint gTextureGreen[] = {0xFF00FF00};
-constexpr GLuint gTextureBlue[] = {0xFFFF0000};
-}  // namespace
+constexpr uint32_t gErrorTextureData[] = {0xFFFF00FF, 0xFF000000, 0xFF000000, 0xFFFF00FF};
+
+const size_t paletteSize = 1024;
+
+using Level = std::vector<uint8_t>;
+
+DecodedTexture getErrorTexture() {
+    DecodedTexture texture;
+    texture.size = {2, 2};
+    texture.levels.emplace_back(sizeof(gErrorTextureData));
+    std::memcpy(texture.levels[0].data(), gErrorTextureData,
+                sizeof(gErrorTextureData));
+    return texture;
+}
+
+uint32_t readU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
 
-static
-std::unique_ptr<TextureData> getErrorTexture() {
-    GLuint errTexName = 0;
-    std::unique_ptr<TextureData> tex = nullptr;
-    if (errTexName == 0) {
-        glGenTextures(1, &errTexName);
-        glBindTexture(GL_TEXTURE_2D, errTexName);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA,
-                     GL_UNSIGNED_BYTE, gErrorTextureData);
-        glGenerateMipmap(GL_TEXTURE_2D);
+/// Palette entries are stored as RGBA already, so each index becomes one
+/// 32 bit copy
+void expandPalette(const uint8_t* indices, size_t count,
+                   const uint8_t* paletteData, Level& out) {
+    uint32_t palette[256];
+    std::memcpy(palette, paletteData, sizeof(palette));
 
-        tex = TextureData::create(errTexName, {2, 2}, false);
+    out.resize(count * 4);
+    auto pixels = reinterpret_cast<uint32_t*>(out.data());
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        pixels[i + 0] = palette[indices[i + 0]];
+        pixels[i + 1] = palette[indices[i + 1]];
+        pixels[i + 2] = palette[indices[i + 2]];
+        pixels[i + 3] = palette[indices[i + 3]];
+    }
+    for (; i < count; ++i) {
+        pixels[i] = palette[indices[i]];
     }
-    return tex;
 }
 
-const size_t paletteSize = 1024;
+/// D3D A8R8G8B8 and X8R8G8B8 are BGRA in memory
+void convertBGRA(const uint8_t* in, size_t count, bool hasAlpha, Level& out) {
+    out.resize(count * 4);
+    auto pixels = out.data();
+    for (size_t i = 0; i < count; ++i, in += 4, pixels += 4) {
+        pixels[0] = in[2];
+        pixels[1] = in[1];
+        pixels[2] = in[0];
+        pixels[3] = hasAlpha ? in[3] : 0xFF;
+    }
+}
+
+/// D3D A1R5G5B5
+void convert1555(const uint8_t* in, size_t count, Level& out) {
+    out.resize(count * 4);
+    auto pixels = out.data();
+    for (size_t i = 0; i < count; ++i, in += 2, pixels += 4) {
+        const uint32_t v = in[0] | (in[1] << 8);
+        const uint32_t r = (v >> 10) & 0x1F;
+        const uint32_t g = (v >> 5) & 0x1F;
+        const uint32_t b = v & 0x1F;
+        pixels[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+        pixels[1] = static_cast<uint8_t>((g << 3) | (g >> 2));
+        pixels[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        pixels[3] = (v & 0x8000) ? 0xFF : 0x00;
+    }
+}
+
+/// Box filter a level down to the next one
+Level downsample(const Level& in, const glm::ivec2& inSize,
+                 const glm::ivec2& outSize) {
+    Level out(static_cast<size_t>(outSize.x) * outSize.y * 4);
+    const int stepX = inSize.x > outSize.x ? 2 : 1;
+    const int stepY = inSize.y > outSize.y ? 2 : 1;
+    for (int y = 0; y < outSize.y; ++y) {
+        for (int x = 0; x < outSize.x; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                unsigned sum = 0;
+                for (int dy = 0; dy < stepY; ++dy) {
+                    for (int dx = 0; dx < stepX; ++dx) {
+                        const auto sx = x * stepX + dx;
+                        const auto sy = y * stepY + dy;
+                        sum += in[(static_cast<size_t>(sy) * inSize.x + sx) * 4 +
+                                  c];
+                    }
+                }
+                const unsigned count = stepX * stepY;
+                out[(static_cast<size_t>(y) * outSize.x + x) * 4 + c] =
+                    static_cast<uint8_t>((sum + count / 2) / count);
+            }
+        }
+    }
+    return out;
+}
 
-static
-void processPalette(uint32_t* fullColor, RW::BinaryStreamSection& rootSection) {
-    uint8_t* dataBase = reinterpret_cast<uint8_t*>(
-        rootSection.raw() + sizeof(RW::BSSectionHeader) +
-        sizeof(RW::BSTextureNative) - 4);
+/// Downsample palette indices, each block is averaged in colour and
+/// replaced by the closest palette entry
+Level downsampleIndices(const Level& in, const glm::ivec2& inSize,
+                        const glm::ivec2& outSize, const uint8_t* palette) {
+    Level out(static_cast<size_t>(outSize.x) * outSize.y);
+    const int stepX = inSize.x > outSize.x ? 2 : 1;
+    const int stepY = inSize.y > outSize.y ? 2 : 1;
+    const int count = stepX * stepY;
+    for (int y = 0; y < outSize.y; ++y) {
+        for (int x = 0; x < outSize.x; ++x) {
+            int sum[4] = {};
+            for (int dy = 0; dy < stepY; ++dy) {
+                for (int dx = 0; dx < stepX; ++dx) {
+                    const auto index =
+                        in[static_cast<size_t>(y * stepY + dy) * inSize.x +
+                           x * stepX + dx];
+                    for (int c = 0; c < 4; ++c) {
+                        sum[c] += palette[index * 4 + c];
+                    }
+                }
+            }
 
-    uint8_t* coldata = (dataBase + paletteSize + sizeof(uint32_t));
-    uint32_t raster_size = *reinterpret_cast<uint32_t*>(dataBase + paletteSize);
-    uint32_t* palette = reinterpret_cast<uint32_t*>(dataBase);
+            int best = 0;
+            int bestDistance = std::numeric_limits<int>::max();
+            for (int i = 0; i < 256 && bestDistance > 0; ++i) {
+                int distance = 0;
+                for (int c = 0; c < 4; ++c) {
+                    const int d = palette[i * 4 + c] * count - sum[c];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = i;
+                }
+            }
+            out[static_cast<size_t>(y) * outSize.x + x] =
+                static_cast<uint8_t>(best);
+        }
+    }
+    return out;
+}
 
-    for (size_t j = 0; j < raster_size; ++j) {
-        *(fullColor++) = palette[coldata[j]];
+GLenum getWrap(uint8_t wrap) {
+    switch (wrap) {
+        default:
+        case RW::BSTextureNative::WRAP_WRAP:
+            return GL_REPEAT;
+        case RW::BSTextureNative::WRAP_CLAMP:
+            return GL_CLAMP_TO_EDGE;
+        case RW::BSTextureNative::WRAP_MIRROR:
+            return GL_MIRRORED_REPEAT;
     }
 }
 
-static std::unique_ptr<TextureData> createTexture(
-    RW::BSTextureNative& texNative, RW::BinaryStreamSection& rootSection) {
-    // TODO: Exception handling.
+DecodedTexture decodeTexture(const RW::BSTextureNative& texNative,
+                             RW::BinaryStreamSection& rootSection,
+                             bool keepPalettes) {
     if (texNative.platform != 8) {
         RW_ERROR("Unsupported texture platform " << std::dec
                   << texNative.platform);
@@ -65,9 +181,10 @@ static std::unique_ptr<TextureData> createTexture(
     bool isPal8 =
         (texNative.rasterformat & RW::BSTextureNative::FORMAT_EXT_PAL8) ==
         RW::BSTextureNative::FORMAT_EXT_PAL8;
-    bool isFulc = texNative.rasterformat == RW::BSTextureNative::FORMAT_1555 ||
-                  texNative.rasterformat == RW::BSTextureNative::FORMAT_8888 ||
-                  texNative.rasterformat == RW::BSTextureNative::FORMAT_888;
+    const auto baseFormat = texNative.rasterformat & 0x0F00;
+    bool isFulc = !isPal8 && (baseFormat == RW::BSTextureNative::FORMAT_1555 ||
+                              baseFormat == RW::BSTextureNative::FORMAT_8888 ||
+                              baseFormat == RW::BSTextureNative::FORMAT_888);
     // Export this value
     bool transparent =
         !((texNative.rasterformat & RW::BSTextureNative::FORMAT_888) ==
@@ -79,102 +196,102 @@ static std::unique_ptr<TextureData> createTexture(
         return getErrorTexture();
     }
 
-    GLuint textureName = 0;
+    DecodedTexture texture;
+    texture.size = {texNative.width, texNative.height};
+    texture.transparent = transparent;
+    texture.magFilter =
+        (texNative.filterflags & 0xFF) == RW::BSTextureNative::FILTER_NEAREST
+            ? GL_NEAREST
+            : GL_LINEAR;
+    texture.wrapS = getWrap(texNative.wrapU);
+    texture.wrapT = getWrap(texNative.wrapV);
+
+    // The raster follows the structure, which ends with the size of the
+    // first level, or with the palette for palettized rasters
+    auto structHeader =
+        reinterpret_cast<const RW::BSSectionHeader*>(rootSection.raw());
+    auto structData =
+        reinterpret_cast<const uint8_t*>(rootSection.raw()) +
+        sizeof(RW::BSSectionHeader);
+    const auto structEnd = structData + structHeader->size;
+    auto raster = structData + offsetof(RW::BSTextureNative, datasize);
 
+    const uint8_t* palette = nullptr;
     if (isPal8) {
-        std::vector<uint32_t> fullColor(texNative.width * texNative.height);
-
-        processPalette(fullColor.data(), rootSection);
-
-        glGenTextures(1, &textureName);
-        glBindTexture(GL_TEXTURE_2D, textureName);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texNative.width,
-                     texNative.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                     fullColor.data());
-    } else if (isFulc) {
-        auto coldata = rootSection.raw() + sizeof(RW::BSTextureNative);
-        coldata += sizeof(uint32_t);
-
-        GLenum type = GL_UNSIGNED_BYTE, format = GL_RGBA;
-        switch (texNative.rasterformat) {
-            case RW::BSTextureNative::FORMAT_1555:
-                format = GL_RGBA;
-                type = GL_UNSIGNED_SHORT_1_5_5_5_REV;
-                break;
-            case RW::BSTextureNative::FORMAT_8888:
-                format = GL_BGRA;
-                // type = GL_UNSIGNED_INT_8_8_8_8_REV;
-                coldata += 8;
-                type = GL_UNSIGNED_BYTE;
-                break;
-            case RW::BSTextureNative::FORMAT_888:
-                format = GL_BGRA;
-                type = GL_UNSIGNED_BYTE;
-                break;
-            default:
-                break;
+        if (raster + paletteSize > structEnd) {
+            RW_ERROR("Truncated palette for " << texNative.diffuseName);
+            return getErrorTexture();
+        }
+        palette = raster;
+        raster += paletteSize;
+        if (keepPalettes) {
+            texture.palette.assign(palette, palette + paletteSize);
         }
-
-        glGenTextures(1, &textureName);
-        glBindTexture(GL_TEXTURE_2D, textureName);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texNative.width,
-                     texNative.height, 0, format, type, coldata);
-    } else {
-        return getErrorTexture();
     }
 
-    GLenum texFilter = GL_LINEAR;
-    switch (texNative.filterflags & 0xFF) {
-        default:
-        case RW::BSTextureNative::FILTER_LINEAR:
-            texFilter = GL_LINEAR;
+    const bool hasAlpha = baseFormat != RW::BSTextureNative::FORMAT_888;
+    const size_t bytesPerPixel =
+        isPal8 ? 1 : (baseFormat == RW::BSTextureNative::FORMAT_1555 ? 2 : 4);
+    const bool hasMipmaps =
+        (texNative.rasterformat & RW::BSTextureNative::FORMAT_EXT_MIPMAP) != 0;
+    const size_t storedLevels =
+        hasMipmaps ? std::max<size_t>(texNative.nummipmaps, 1) : 1;
+
+    // Use the levels stored in the file as long as they are intact
+    for (size_t level = 0; level < storedLevels; ++level) {
+        const auto size = texture.getLevelSize(level);
+        const size_t count = static_cast<size_t>(size.x) * size.y;
+        if (raster + sizeof(uint32_t) > structEnd) {
             break;
-        case RW::BSTextureNative::FILTER_NEAREST:
-            texFilter = GL_NEAREST;
+        }
+        const auto levelSize = readU32(raster);
+        raster += sizeof(uint32_t);
+        if (levelSize < count * bytesPerPixel ||
+            raster + levelSize > structEnd) {
             break;
-    }
+        }
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, texFilter);
+        Level pixels;
+        if (texture.isPaletted()) {
+            pixels.assign(raster, raster + count);
+        } else if (isPal8) {
+            expandPalette(raster, count, palette, pixels);
+        } else if (baseFormat == RW::BSTextureNative::FORMAT_1555) {
+            convert1555(raster, count, pixels);
+        } else {
+            convertBGRA(raster, count, hasAlpha, pixels);
+        }
+        texture.levels.push_back(std::move(pixels));
+        raster += levelSize;
 
-    GLenum texwrap = GL_REPEAT;
-    switch (texNative.wrapU) {
-        default:
-        case RW::BSTextureNative::WRAP_WRAP:
-            texwrap = GL_REPEAT;
-            break;
-        case RW::BSTextureNative::WRAP_CLAMP:
-            texwrap = GL_CLAMP_TO_EDGE;
-            break;
-        case RW::BSTextureNative::WRAP_MIRROR:
-            texwrap = GL_MIRRORED_REPEAT;
+        if (size.x == 1 && size.y == 1) {
             break;
+        }
     }
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texwrap);
 
-    switch (texNative.wrapV) {
-        default:
-        case RW::BSTextureNative::WRAP_WRAP:
-            texwrap = GL_REPEAT;
-            break;
-        case RW::BSTextureNative::WRAP_CLAMP:
-            texwrap = GL_CLAMP_TO_EDGE;
-            break;
-        case RW::BSTextureNative::WRAP_MIRROR:
-            texwrap = GL_MIRRORED_REPEAT;
-            break;
+    if (texture.levels.empty()) {
+        RW_ERROR("Truncated raster for " << texNative.diffuseName);
+        return getErrorTexture();
     }
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texwrap);
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // Generate the levels that weren't stored
+    auto size = texture.getLevelSize(texture.levels.size() - 1);
+    while (size.x > 1 || size.y > 1) {
+        const auto next = texture.getLevelSize(texture.levels.size());
+        texture.levels.push_back(
+            texture.isPaletted()
+                ? downsampleIndices(texture.levels.back(), size, next, palette)
+                : downsample(texture.levels.back(), size, next));
+        size = next;
+    }
 
-    return TextureData::create(textureName, {texNative.width, texNative.height},
-                               transparent);
+    return texture;
 }
+}  // namespace
 
-bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
-                                   TextureArchive& inTextures) {
+bool TextureLoader::decode(const FileContentsInfo& file,
+                           std::vector<DecodedTexture>& textures,
+                           bool keepPalettes) {
     auto data = file.data.get();
     RW::BinaryStreamSection root(data);
     /*auto texDict =*/root.readStructure<RW::BSTextureDictionary>();
@@ -192,8 +309,81 @@ bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
         std::transform(name.begin(), name.end(), name.begin(), ::tolower);
         std::transform(alpha.begin(), alpha.end(), alpha.begin(), ::tolower);
 
-        inTextures[name] = createTexture(texNative, rootSection);
+        textures.push_back(decodeTexture(texNative, rootSection, keepPalettes));
+        textures.back().name = std::move(name);
     }
 
     return true;
 }
+
+void TextureLoader::packArrays(std::vector<DecodedTexture>& textures) {
+    // The minimum GL_MAX_ARRAY_TEXTURE_LAYERS of GL 3.3
+    constexpr size_t kMaxLayers = 256;
+
+    using Key = std::tuple<int, int, GLenum, GLenum, GLenum>;
+    std::map<Key, std::vector<size_t>> groups;
+    for (size_t i = 0; i < textures.size(); ++i) {
+        const auto& texture = textures[i];
+        if (texture.isPaletted() || texture.isArray()) {
+            continue;
+        }
+        groups[Key{texture.size.x, texture.size.y, texture.wrapS,
+                   texture.wrapT, texture.magFilter}]
+            .push_back(i);
+    }
+
+    std::vector<bool> packed(textures.size(), false);
+    std::vector<DecodedTexture> arrays;
+    for (const auto& group : groups) {
+        const auto& indices = group.second;
+        for (size_t first = 0; first + 1 < indices.size();
+             first += kMaxLayers) {
+            const auto last = std::min(first + kMaxLayers, indices.size());
+            const auto& front = textures[indices[first]];
+
+            DecodedTexture array;
+            array.name = front.name;
+            array.size = front.size;
+            array.magFilter = front.magFilter;
+            array.wrapS = front.wrapS;
+            array.wrapT = front.wrapT;
+            array.levels.resize(front.levels.size());
+            for (size_t i = first; i < last; ++i) {
+                auto& texture = textures[indices[i]];
+                array.transparent |= texture.transparent;
+                array.layers.push_back({texture.name, texture.transparent});
+                for (size_t level = 0; level < array.levels.size(); ++level) {
+                    array.levels[level].insert(array.levels[level].end(),
+                                               texture.levels[level].begin(),
+                                               texture.levels[level].end());
+                }
+                packed[indices[i]] = true;
+            }
+            arrays.push_back(std::move(array));
+        }
+    }
+
+    std::vector<DecodedTexture> result;
+    result.reserve(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        if (!packed[i]) {
+            result.push_back(std::move(textures[i]));
+        }
+    }
+    for (auto& array : arrays) {
+        result.push_back(std::move(array));
+    }
+    textures = std::move(result);
+}
+
+bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
+                                   TextureArchive& inTextures) {
+    std::vector<DecodedTexture> textures;
+    if (!decode(file, textures)) {
+        return false;
+    }
+    for (const auto& texture : textures) {
+        inTextures[texture.name] = TextureUploader::upload(texture);
+    }
+    return true;
+}
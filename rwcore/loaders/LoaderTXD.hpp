@@ -4,8 +4,24 @@
 #include <gl/TextureData.hpp>
 #include <rw/forward.hpp>
 
+#include <vector>
+
 class TextureLoader {
 public:
+    /// Decode the textures of a TXD into RGBA8 mip chains, without GL, so
+    /// it can run on a worker thread.
+    /// @param keepPalettes keep PAL8 textures as indices and their palette,
+    /// only the world shaders can draw them
+    static bool decode(const FileContentsInfo& file,
+                       std::vector<DecodedTexture>& textures,
+                       bool keepPalettes = false);
+
+    /// Replace textures that share their size and sampling with texture
+    /// arrays, so draws using them don't need to bind another texture.
+    /// Paletted textures are left alone.
+    static void packArrays(std::vector<DecodedTexture>& textures);
+
+    /// Decode and upload the textures of a TXD
     bool loadFromMemory(const FileContentsInfo& file, TextureArchive& inTextures);
 };
 
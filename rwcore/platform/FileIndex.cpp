@@ -107,6 +107,7 @@ FileContentsInfo FileIndex::openFile(const std::string &filePath) {
             throw std::runtime_error("IMG archive not indexed: " + indexedData.path);
         }
 
+        std::lock_guard<std::mutex> lock(archiveMutex_);
         auto& loader = loaderPos->second;
         LoaderIMGFile file;
         auto filename = std::filesystem::path(indexedData.assetData).filename().string();
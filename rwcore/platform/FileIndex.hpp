@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 
 #include <loaders/LoaderIMG.hpp>
 #include <rw/forward.hpp>
@@ -56,6 +57,8 @@ public:
      * file index, otherwise an empty FileHandle is returned.
      * @param filePath name of the file to open
      * @return FileHandle to the file, nullptr if this FileINdexed has not indexed the path
+     *
+     * Can be called from several threads once indexing is done.
      */
     FileContentsInfo openFile(const std::string &filePath);
 
@@ -99,6 +102,12 @@ private:
      * @brief loaders_ Maps .img filepaths to its respective loader
      */
     std::unordered_map<std::string, LoaderIMG> loaders_;
+
+    /**
+     * @brief archiveMutex_ Serializes reads from the archives, which share
+     * one stream each
+     */
+    std::mutex archiveMutex_;
 };
 
 #endif
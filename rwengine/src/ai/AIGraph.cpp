@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <limits>
 
+#include <glm/common.hpp>
 #include <glm/gtx/norm.hpp>
 
 #include "ai/AIGraphNode.hpp"
@@ -13,6 +15,16 @@
 
 namespace ai {
 
+namespace {
+glm::ivec2 clampedGridCoord(const glm::vec2& world) {
+    const float lowerCoord = -(WORLD_GRID_SIZE) / 2.f;
+    auto coord = glm::ivec2(
+        glm::floor((world - glm::vec2(lowerCoord)) / glm::vec2(WORLD_CELL_SIZE)));
+    return glm::clamp(coord, glm::ivec2(0),
+                      glm::ivec2(static_cast<int>(WORLD_GRID_WIDTH) - 1));
+}
+}  // namespace
+
 void AIGraph::createPathNodes(const glm::vec3& position,
                               const glm::quat& rotation, PathData& path) {
     auto startIndex = static_cast<std::uint32_t>(nodes.size());
@@ -49,11 +61,14 @@ void AIGraph::createPathNodes(const glm::vec3& position,
             ainode->rightLanes = node.rightLanes;
             ainode->position = nodePosition;
             ainode->external = node.type == PathNode::EXTERNAL;
-            ainode->disabled = false;
+            ainode->index = static_cast<std::uint32_t>(nodes.size());
 
             pathNodes.push_back(ptr);
             nodes.push_back(std::move(ainode));
 
+            auto cell = clampedGridCoord(glm::vec2(ptr->position));
+            cellNodes[cell.x * WORLD_GRID_WIDTH + cell.y].push_back(ptr);
+
             if (ptr->external) {
                 externalNodes.push_back(ptr);
 
@@ -122,4 +137,48 @@ void AIGraph::gatherExternalNodesNear(const glm::vec3& center,
     }
 }
 
+AIGraphNode* AIGraph::findNearestNode(
+    const glm::vec3& position, NodeType type,
+    const std::function<bool(const AIGraphNode*)>& filter) const {
+    const auto center = clampedGridCoord(glm::vec2(position));
+    const int width = static_cast<int>(WORLD_GRID_WIDTH);
+
+    AIGraphNode* nearest = nullptr;
+    float nearestDistance = std::numeric_limits<float>::max();
+
+    // Search rings of cells around the position, everything beyond ring r is
+    // at least r cells away.
+    for (int r = 0; r < width; ++r) {
+        for (int x = center.x - r; x <= center.x + r; ++x) {
+            if (x < 0 || x >= width) {
+                continue;
+            }
+            const bool edge = x == center.x - r || x == center.x + r;
+            const int step = edge ? 1 : std::max(2 * r, 1);
+            for (int y = center.y - r; y <= center.y + r; y += step) {
+                if (y < 0 || y >= width) {
+                    continue;
+                }
+                for (const auto node : cellNodes[x * WORLD_GRID_WIDTH + y]) {
+                    if (node->type != type || (filter && !filter(node))) {
+                        continue;
+                    }
+                    float d = glm::distance2(position, node->position);
+                    if (d < nearestDistance) {
+                        nearest = node;
+                        nearestDistance = d;
+                    }
+                }
+            }
+        }
+
+        const float ringDistance = static_cast<float>(r * WORLD_CELL_SIZE);
+        if (nearest && nearestDistance <= ringDistance * ringDistance) {
+            break;
+        }
+    }
+
+    return nearest;
+}
+
 }  // namespace ai
@@ -6,6 +6,7 @@
 #include <rw/types.hpp>
 
 #include <array>
+#include <functional>
 #include <vector>
 
 struct PathData;
@@ -33,11 +34,26 @@ public:
      */
     std::array<std::vector<AIGraphNode*>, WORLD_GRID_CELLS> gridNodes;
 
+    /**
+     * Stores every AI Graph Node organised by world grid cell, nodes outside
+     * of the grid are stored in the closest cell
+     */
+    std::array<std::vector<AIGraphNode*>, WORLD_GRID_CELLS> cellNodes;
+
     void createPathNodes(const glm::vec3& position, const glm::quat& rotation,
                          PathData& path);
 
     void gatherExternalNodesNear(const glm::vec3& center, const float radius,
                                  std::vector<AIGraphNode*>& nodes, NodeType type);
+
+    /**
+     * @brief Finds the closest node of the given type
+     * @param filter Optional predicate that the node must satisfy
+     * @return The closest node, or nullptr if none matched
+     */
+    AIGraphNode* findNearestNode(
+        const glm::vec3& position, NodeType type,
+        const std::function<bool(const AIGraphNode*)>& filter = {}) const;
 };
 
 } // ai
@@ -3,6 +3,7 @@
 
 #include <glm/vec3.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -27,7 +28,11 @@ struct AIGraphNode {
 
     int32_t nextIndex;
 
-    bool disabled;
+    /// Position of this node in AIGraph::nodes
+    uint32_t index;
+
+    /// Toggled by scripts while route searches may be running on workers
+    std::atomic<bool> disabled{false};
 
     std::vector<AIGraphNode*> connections;
 };
@@ -1,5 +1,6 @@
 #include "ai/CharacterController.hpp"
 
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <utility>
@@ -156,6 +157,30 @@ bool Activities::GoTo::update(CharacterObject *character,
     return false;
 }
 
+bool Activities::FollowRoute::update(CharacterObject *character,
+                                    CharacterController *controller) {
+    if (route.valid()) {
+        if (route.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready) {
+            controller->setMoveDirection({0.f, 0.f, 0.f});
+            return false;
+        }
+        for (const auto node : route.get()) {
+            waypoints.push_back(node->position);
+        }
+        waypoints.push_back(step.target);
+        route = {};
+    }
+
+    for (; nextWaypoint < waypoints.size(); ++nextWaypoint) {
+        step.target = waypoints[nextWaypoint];
+        if (!step.update(character, controller)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 glm::vec3 CharacterController::calculateRoadTarget(const glm::vec3 &target,
                                                    const glm::vec3 &start,
                                                    const glm::vec3 &end) {
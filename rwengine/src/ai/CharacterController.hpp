@@ -4,8 +4,13 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include <cstddef>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "ai/RoutePlanner.hpp"
 
 class CharacterObject;
 class VehicleObject;
@@ -221,6 +226,30 @@ struct GoTo : public CharacterController::Activity {
     }
 };
 
+/**
+ * @brief Walks to a target along a route through the AI graph, waiting for
+ * the route if it is still being planned
+ */
+struct FollowRoute : public CharacterController::Activity {
+    DECL_ACTIVITY(FollowRoute)
+
+    std::shared_future<RoutePlanner::Route> route;
+    std::vector<glm::vec3> waypoints;
+    std::size_t nextWaypoint = 0;
+    GoTo step;
+
+    FollowRoute(std::shared_future<RoutePlanner::Route> route,
+                const glm::vec3& target, bool _sprint = false)
+        : route(std::move(route)), step(target, _sprint) {
+    }
+
+    bool update(CharacterObject* character, CharacterController* controller) override;
+
+    bool canSkip(CharacterObject*, CharacterController*) const override {
+        return true;
+    }
+};
+
 struct DriveTo : public CharacterController::Activity {
     DECL_ACTIVITY(DriveTo)
 
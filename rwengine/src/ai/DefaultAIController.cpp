@@ -27,6 +27,8 @@ glm::vec3 DefaultAIController::getTargetPosition() {
 }
 
 const float followRadius = 5.f;
+// Leaders further away than this are followed along the path network
+const float routeFollowDistance = 40.f;
 
 void DefaultAIController::update(float dt) {
     switch (currentGoal) {
@@ -53,7 +55,19 @@ void DefaultAIController::update(float dt) {
                                 leader->getPosition() +
                                 (glm::normalize(-dir) * followRadius * 0.7f);
                             skipActivity();
-                            setNextActivity(std::make_unique<Activities::GoTo>(gotoPos));
+                            if (glm::length(dir) > routeFollowDistance) {
+                                auto& planner =
+                                    *getCharacter()->engine->routePlanner;
+                                setNextActivity(
+                                    std::make_unique<Activities::FollowRoute>(
+                                        planner.findRouteAsync(
+                                            getCharacter()->getPosition(),
+                                            gotoPos, NodeType::Pedestrian),
+                                        gotoPos));
+                            } else {
+                                setNextActivity(
+                                    std::make_unique<Activities::GoTo>(gotoPos));
+                            }
                         }
                     }
                 }
@@ -78,21 +92,8 @@ void DefaultAIController::update(float dt) {
             } else {
                 // We need to pick an initial node
                 auto& graph = getCharacter()->engine->aigraph;
-                AIGraphNode* node = nullptr;
-                float mindist = std::numeric_limits<float>::max();
-                for (const auto& n : graph.nodes) {
-                    if (n->type != ai::NodeType::Pedestrian) {
-                        continue;
-		    }
-
-                    float d = glm::distance(n->position,
-                                            getCharacter()->getPosition());
-                    if (d < mindist) {
-                        node = n.get();
-                        mindist = d;
-                    }
-                }
-                targetNode = node;
+                targetNode = graph.findNearestNode(
+                    getCharacter()->getPosition(), ai::NodeType::Pedestrian);
             }
         } break;
         case TrafficDriver: {
@@ -177,33 +178,14 @@ void DefaultAIController::update(float dt) {
                 }
             }
             else {
-                // We need to pick an initial node
+                // We need to pick an initial node ahead of the vehicle
                 auto& graph = getCharacter()->engine->aigraph;
-                AIGraphNode* node = nullptr;
-                float mindist = std::numeric_limits<float>::max();
-
-                for (const auto& n : graph.nodes) {
-                    // No vehicle node, continue
-                    if (n->type != ai::NodeType::Vehicle) {
-                        continue;
-                    }
-
-                    // The node must be ahead of the vehicle
-                    if (getCharacter()->getCurrentVehicle()->isInFront(n->position) < 0.f) {
-                        continue;
-                    }
-
-                    const float d = glm::distance(
-                        n->position,
-                        getCharacter()->getCurrentVehicle()->getPosition());
-
-                    if (d < mindist) {
-                        node = n.get();
-                        mindist = d;
-                    }
-                }
-
-                targetNode = node;
+                auto vehicle = getCharacter()->getCurrentVehicle();
+                targetNode = graph.findNearestNode(
+                    vehicle->getPosition(), ai::NodeType::Vehicle,
+                    [vehicle](const AIGraphNode* n) {
+                        return vehicle->isInFront(n->position) >= 0.f;
+                    });
 		
                 // Set the next activity
                 if (targetNode) {
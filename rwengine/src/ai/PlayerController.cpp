@@ -44,18 +44,9 @@ void PlayerController::exitVehicle() {
 void PlayerController::enterNearestVehicle() {
     if (!character->getCurrentVehicle()) {
         auto world = character->engine;
-        VehicleObject* nearest = nullptr;
-        float d = 10.f;
-
-        for (auto& p : world->vehiclePool.objects) {
-            auto object = p.second.get();
-            float vd =
-                glm::length(character->getPosition() - object->getPosition());
-            if (vd < d) {
-                d = vd;
-                nearest = static_cast<VehicleObject*>(object);
-            }
-        }
+        auto nearest = static_cast<VehicleObject*>(
+            world->vehiclePool.getGrid().findNearest(character->getPosition(),
+                                                     10.f));
 
         if (nearest) {
             setNextActivity(
@@ -0,0 +1,207 @@
+#include "ai/RoutePlanner.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include <glm/geometric.hpp>
+
+#include "ai/AIGraph.hpp"
+#include "ai/AIGraphNode.hpp"
+#include "core/Profiler.hpp"
+#include "core/TaskScheduler.hpp"
+
+namespace ai {
+
+namespace {
+/// Per-thread search buffers, entries are only valid when their stamp
+/// matches the current search so they never have to be cleared.
+struct SearchState {
+    using Entry = std::pair<float, std::uint32_t>;
+
+    std::vector<float> cost;
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> reached;
+    std::vector<std::uint32_t> closed;
+    std::vector<Entry> open;
+    std::uint32_t stamp = 0;
+
+    void begin(std::size_t nodeCount) {
+        if (cost.size() < nodeCount) {
+            cost.resize(nodeCount);
+            parent.resize(nodeCount);
+            reached.resize(nodeCount, 0);
+            closed.resize(nodeCount, 0);
+        }
+        if (++stamp == 0) {
+            std::fill(reached.begin(), reached.end(), 0);
+            std::fill(closed.begin(), closed.end(), 0);
+            stamp = 1;
+        }
+        open.clear();
+    }
+};
+
+thread_local SearchState searchState;
+
+bool isUsable(const AIGraphNode* node) {
+    return !node->disabled;
+}
+}  // namespace
+
+RoutePlanner::RoutePlanner(AIGraph& graph, TaskScheduler& tasks,
+                           std::size_t cacheCapacity)
+    : graph(graph), tasks(tasks), capacity(cacheCapacity) {
+}
+
+RoutePlanner::~RoutePlanner() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return pendingSearches == 0; });
+}
+
+RoutePlanner::Route RoutePlanner::findRoute(AIGraphNode* start,
+                                            AIGraphNode* goal) {
+    if (start == nullptr || goal == nullptr) {
+        return {};
+    }
+
+    const Key key = (Key(start->index) << 32) | goal->index;
+    std::uint64_t searchGeneration;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            recent.splice(recent.begin(), recent, it->second);
+            ++cacheHits;
+            return it->second->second;
+        }
+        searchGeneration = generation;
+    }
+
+    auto route = search(start, goal);
+    ++searches;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Routes found before the graph changed may use disabled nodes
+    if (capacity > 0 && generation == searchGeneration &&
+        cache.find(key) == cache.end()) {
+        recent.emplace_front(key, route);
+        cache[key] = recent.begin();
+        if (cache.size() > capacity) {
+            cache.erase(recent.back().first);
+            recent.pop_back();
+        }
+    }
+    return route;
+}
+
+RoutePlanner::Route RoutePlanner::findRoute(const glm::vec3& from,
+                                            const glm::vec3& to,
+                                            NodeType type) {
+    auto start = graph.findNearestNode(from, type, isUsable);
+    auto goal = graph.findNearestNode(to, type, isUsable);
+    return findRoute(start, goal);
+}
+
+std::shared_future<RoutePlanner::Route> RoutePlanner::findRouteAsync(
+    const glm::vec3& from, const glm::vec3& to, NodeType type) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++pendingSearches;
+    }
+    return tasks
+        .submit([this, from, to, type]() {
+            struct Finished {
+                RoutePlanner& planner;
+                ~Finished() {
+                    std::lock_guard<std::mutex> lock(planner.mutex);
+                    if (--planner.pendingSearches == 0) {
+                        planner.idle.notify_all();
+                    }
+                }
+            } finished{*this};
+            return findRoute(from, to, type);
+        })
+        .share();
+}
+
+void RoutePlanner::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++generation;
+    cache.clear();
+    recent.clear();
+}
+
+std::size_t RoutePlanner::getCacheSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.size();
+}
+
+RoutePlanner::Route RoutePlanner::search(AIGraphNode* start,
+                                         AIGraphNode* goal) const {
+    RW_PROFILE_SCOPE(__func__);
+    if (start->type != goal->type || goal->disabled) {
+        return {};
+    }
+    if (start == goal) {
+        return {start};
+    }
+
+    const auto heuristic = [goal](const AIGraphNode* node) {
+        return glm::distance(node->position, goal->position);
+    };
+
+    auto& state = searchState;
+    state.begin(graph.nodes.size());
+    const auto stamp = state.stamp;
+
+    state.cost[start->index] = 0.f;
+    state.parent[start->index] = start->index;
+    state.reached[start->index] = stamp;
+    state.open.emplace_back(heuristic(start), start->index);
+
+    while (!state.open.empty()) {
+        std::pop_heap(state.open.begin(), state.open.end(), std::greater<>());
+        const auto index = state.open.back().second;
+        state.open.pop_back();
+
+        if (state.closed[index] == stamp) {
+            continue;
+        }
+        state.closed[index] = stamp;
+
+        const auto node = graph.nodes[index].get();
+        if (node == goal) {
+            Route route;
+            for (auto i = index; i != start->index; i = state.parent[i]) {
+                route.push_back(graph.nodes[i].get());
+            }
+            route.push_back(start);
+            std::reverse(route.begin(), route.end());
+            return route;
+        }
+
+        for (const auto next : node->connections) {
+            // External nodes are shared by position, so the pedestrian and
+            // vehicle layers can touch.
+            if (next->type != start->type || next->disabled ||
+                state.closed[next->index] == stamp) {
+                continue;
+            }
+            const float cost = state.cost[index] +
+                               glm::distance(node->position, next->position);
+            if (state.reached[next->index] != stamp ||
+                cost < state.cost[next->index]) {
+                state.cost[next->index] = cost;
+                state.parent[next->index] = index;
+                state.reached[next->index] = stamp;
+                state.open.emplace_back(cost + heuristic(next), next->index);
+                std::push_heap(state.open.begin(), state.open.end(),
+                               std::greater<>());
+            }
+        }
+    }
+
+    return {};
+}
+
+}  // namespace ai
@@ -0,0 +1,108 @@
+#ifndef _RWENGINE_ROUTEPLANNER_HPP_
+#define _RWENGINE_ROUTEPLANNER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+class TaskScheduler;
+
+namespace ai {
+
+class AIGraph;
+enum class NodeType;
+struct AIGraphNode;
+
+/**
+ * @brief Finds routes through the AI graph with A*
+ *
+ * Pedestrian and vehicle nodes are searched separately and nodes disabled by
+ * scripts are avoided. Recent routes are kept in a LRU cache, which must be
+ * invalidated when nodes are enabled or disabled.
+ *
+ * Searches only read the graph, so they can run on the worker threads as
+ * long as no nodes are added while they are in flight.
+ */
+class RoutePlanner {
+public:
+    using Route = std::vector<AIGraphNode*>;
+
+    static constexpr std::size_t kDefaultCacheCapacity = 256;
+
+    RoutePlanner(AIGraph& graph, TaskScheduler& tasks,
+                 std::size_t cacheCapacity = kDefaultCacheCapacity);
+
+    /// Waits for the searches still running on workers
+    ~RoutePlanner();
+
+    RoutePlanner(const RoutePlanner&) = delete;
+    RoutePlanner& operator=(const RoutePlanner&) = delete;
+
+    /**
+     * @brief Finds the route between two nodes of the same type
+     * @return The nodes to visit, including start and goal, or an empty route
+     * if the goal can't be reached.
+     */
+    Route findRoute(AIGraphNode* start, AIGraphNode* goal);
+
+    /**
+     * @brief Finds the route between the nodes closest to two positions
+     */
+    Route findRoute(const glm::vec3& from, const glm::vec3& to, NodeType type);
+
+    /**
+     * @brief Runs findRoute on a worker thread
+     */
+    std::shared_future<Route> findRouteAsync(const glm::vec3& from,
+                                             const glm::vec3& to,
+                                             NodeType type);
+
+    /**
+     * @brief Drops all cached routes, must be called after nodes have been
+     * enabled or disabled.
+     */
+    void invalidate();
+
+    std::size_t getCacheSize() const;
+
+    std::uint64_t getSearchCount() const {
+        return searches;
+    }
+
+    std::uint64_t getCacheHitCount() const {
+        return cacheHits;
+    }
+
+private:
+    using Key = std::uint64_t;
+
+    Route search(AIGraphNode* start, AIGraphNode* goal) const;
+
+    AIGraph& graph;
+    TaskScheduler& tasks;
+    std::size_t capacity;
+
+    mutable std::mutex mutex;
+    std::uint64_t generation = 0;
+    std::list<std::pair<Key, Route>> recent;
+    std::unordered_map<Key, std::list<std::pair<Key, Route>>::iterator> cache;
+
+    std::condition_variable idle;
+    int pendingSearches = 0;
+
+    std::atomic<std::uint64_t> searches{0};
+    std::atomic<std::uint64_t> cacheHits{0};
+};
+
+}  // namespace ai
+
+#endif
@@ -1,6 +1,8 @@
 #include "ai/TrafficDirector.hpp"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 
@@ -12,6 +14,7 @@
 #include "ai/AIGraph.hpp"
 #include "ai/AIGraphNode.hpp"
 #include "ai/CharacterController.hpp"
+#include "core/Profiler.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
@@ -26,6 +29,25 @@
 
 namespace ai {
 
+namespace {
+// Vehicles for normal traffic @todo create correct vehicle list
+constexpr std::array<uint16_t, 32> kTrafficCars = {{
+    90, 91, 92, 94, 95, 97, 98, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110,
+    111, 112, 116, 119, 128, 129, 130, 134, 135, 136, 138, 139, 144, 146
+}};
+
+// Candidates are gathered this far beyond the spawn radius, so they stay
+// valid while the camera is anywhere in the cell.
+constexpr float kCandidateMargin = static_cast<float>(WORLD_CELL_SIZE);
+constexpr float kCandidateHeightSlack = 25.f;
+
+float millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+}  // namespace
+
 TrafficDirector::TrafficDirector(AIGraph* g, GameWorld* w)
     : graph(g)
     , world(w) {
@@ -38,48 +60,49 @@ std::vector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
 
     graph->gatherExternalNodesNear(camera.position, radius, available, type);
 
+    filterAvailable(available, type, camera, radius);
+
+    return available;
+}
+
+void TrafficDirector::filterAvailable(std::vector<AIGraphNode*>& nodes,
+                                      ai::NodeType type,
+                                      const ViewCamera& camera, float radius) {
     float density = type == ai::NodeType::Vehicle ? carDensity : pedDensity;
     float minDist = (15.f / density) * (15.f / density);
     float halfRadius2 = std::pow(radius / 2.f, 2.f);
 
-    // Check if any of the nearby nodes are blocked by a pedestrian or vehicle standing on
-    // it
-    // or because it's inside the view frustum
-    for (auto it = available.begin(); it != available.end();) {
-        bool blocked = false;
-        float dist2 = glm::distance2(camera.position, (*it)->position);
-
-        for (const auto& obj : world->pedestrianPool.objects) {
-            if (glm::distance2((*it)->position, obj.second->getPosition()) <=
-                minDist) {
-                blocked = true;
-                break;
-            }
-        }
-
-        for (const auto& obj : world->vehiclePool.objects) {
-            if (glm::distance2((*it)->position, obj.second->getPosition()) <=
-                minDist) {
-                blocked = true;
-                break;
+    // Only objects close enough to the nodes can block them
+    const float reach = radius + std::sqrt(minDist);
+    std::vector<glm::vec3> blockers;
+    for (const auto* pool : {&world->pedestrianPool, &world->vehiclePool}) {
+        for (const auto& obj : pool->objects) {
+            const auto& position = obj.second->getPosition();
+            if (glm::distance2(camera.position, position) <= reach * reach) {
+                blockers.push_back(position);
             }
         }
-
-        // Check that we're not going to spawn something right where the player
-        // is looking
-        if (dist2 <= halfRadius2 &&
-            camera.frustum.intersects((*it)->position, 1.f)) {
-            blocked = true;
-        }
-
-        if (blocked) {
-            it = available.erase(it);
-        } else {
-            it++;
-        }
     }
 
-    return available;
+    // Check if any of the nearby nodes are blocked by a pedestrian or vehicle
+    // standing on it or because it's inside the view frustum
+    nodes.erase(
+        std::remove_if(
+            nodes.begin(), nodes.end(),
+            [&](const AIGraphNode* node) {
+                for (const auto& position : blockers) {
+                    if (glm::distance2(node->position, position) <= minDist) {
+                        return true;
+                    }
+                }
+
+                // Check that we're not going to spawn something right where
+                // the player is looking
+                float dist2 = glm::distance2(camera.position, node->position);
+                return dist2 <= halfRadius2 &&
+                       camera.frustum.intersects(node->position, 1.f);
+            }),
+        nodes.end());
 }
 
 void TrafficDirector::setDensity(ai::NodeType type, float density) {
@@ -93,11 +116,9 @@ void TrafficDirector::setDensity(ai::NodeType type, float density) {
     }
 }
 
-std::vector<GameObject*> TrafficDirector::populateNearby(
-    const ViewCamera& camera, float radius, int maxSpawn) {
-
-    std::vector<GameObject*> created;
-
+void TrafficDirector::spawnAtGenerators(const ViewCamera& camera, float radius,
+                                        const std::function<bool()>& canSpawn,
+                                        std::vector<GameObject*>& created) {
     /// @todo Check how "in player view" should be determined.
 
     // Don't check the frustum for things more than 1/2 of the radius away
@@ -107,6 +128,9 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
     // Spawn vehicles at vehicle generators
     auto camera2D = glm::vec2(camera.position);
     for (auto& gen : world->state->vehicleGenerators) {
+        if (!canSpawn()) {
+            break;
+        }
         /// @todo verify how vehicle generator proximity is determined
         auto gen2D = glm::vec2(gen.position);
         float dist2 = glm::distance2(camera2D, gen2D);
@@ -130,23 +154,102 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
             }
         }
     }
+}
 
+std::vector<uint16_t> TrafficDirector::getPedestrianModels(
+    const glm::vec3& position) {
     // Hardcoded cop Pedestrian
     std::vector<uint16_t> peds = {1};
 
     // Determine which zone the viewpoint is in
-    auto zone = world->data->findZoneAt(camera.position);
+    auto zone = world->data->findZoneAt(position);
     bool day = (world->state->basic.gameHour >= 8 &&
                 world->state->basic.gameHour <= 19);
     int groupid = zone ? (day ? zone->pedGroupDay : zone->pedGroupNight) : 0;
     const auto& group = world->data->pedgroups.at(groupid);
     peds.insert(peds.end(), group.cbegin(), group.cend());
 
-    // Vehicles for normal traffic @todo create correct vehicle list
-    static constexpr std::array<uint16_t, 32> cars = {{
-        90, 91, 92, 94, 95, 97, 98, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110,
-        111, 112, 116, 119, 128, 129, 130, 134, 135, 136, 138, 139, 144, 146
-    }};
+    return peds;
+}
+
+GameObject* TrafficDirector::spawnPedestrian(
+    AIGraphNode* spawn, const std::vector<uint16_t>& models) {
+    // Spawn a pedestrian from the available pool
+    const auto pedId = models.at(world->getRandomNumber(0u, models.size() - 1));
+    auto ped = world->createPedestrian(pedId, spawn->position);
+    ped->applyOffset();
+    ped->setLifetime(GameObject::TrafficLifetime);
+    ped->controller->setGoal(CharacterController::TrafficWander);
+    return ped;
+}
+
+std::vector<GameObject*> TrafficDirector::spawnVehicle(
+    AIGraphNode* spawn, const std::vector<uint16_t>& carModels,
+    const std::vector<uint16_t>& pedModels) {
+    // Get the next node, to spawn in between
+    AIGraphNode* next = spawn->connections.at(0);
+
+    // Set the spawn point to the middle of the two nodes
+    const glm::vec3 diff = (spawn->position - next->position) / 2.f;
+
+    // Calculate the orientation of the vehicle
+    glm::mat4 rotMat = glm::lookAt(next->position, spawn->position, glm::vec3(0,0,1));
+    const glm::mat4 rotate =
+        glm::rotate(glm::radians(90.f), glm::vec3(1, 0, 0));
+    rotMat = rotate * rotMat;
+
+    const glm::quat orientation = glm::conjugate(glm::toQuat(rotMat));
+
+    const glm::vec3 up = glm::vec3(0, 0, 1);
+    const glm::vec3 dir =
+        glm::normalize(next->position - spawn->position);
+
+    // Calculate the strafe vector
+    const glm::vec3 strafe = glm::cross(up, dir);
+
+    // @todo we don't know the direction of the street, so for now, choose the smaller value
+    int maxLanes = spawn->rightLanes < spawn->leftLanes ? spawn->rightLanes : spawn->leftLanes;
+
+    // This street has no lanes
+    if( maxLanes <= 0 ) {
+        return {};
+    }
+
+    // Choose a random lane
+    const int lane = world->getRandomNumber(1, maxLanes);
+    const glm::vec3 laneOffset =
+        strafe * (2.5f + 5.f * static_cast<float>(lane - 1));
+
+    // Spawn a vehicle from the available pool
+    const auto carId =
+        carModels.at(world->getRandomNumber(0u, carModels.size() - 1));
+    auto vehicle = world->createVehicle(carId, next->position + diff + laneOffset, orientation);
+    vehicle->applyOffset();
+    vehicle->setLifetime(GameObject::TrafficLifetime);
+    vehicle->setHandbraking(false);
+
+    // Spawn a pedestrian and put it into the vehicle
+    const auto pedId =
+        pedModels.at(world->getRandomNumber(0u, pedModels.size() - 1));
+    CharacterObject* character = world->createPedestrian(pedId, vehicle->getPosition());
+    character->setLifetime(GameObject::TrafficLifetime);
+    character->setCurrentVehicle(vehicle, 0);
+    character->controller->setGoal(CharacterController::TrafficDriver);
+    character->controller->setLane(lane);
+    vehicle->setOccupant(0, character);
+
+    return {character, vehicle};
+}
+
+std::vector<GameObject*> TrafficDirector::populateNearby(
+    const ViewCamera& camera, float radius, int maxSpawn) {
+
+    std::vector<GameObject*> created;
+
+    spawnAtGenerators(camera, radius, []() { return true; }, created);
+
+    const auto peds = getPedestrianModels(camera.position);
+    const std::vector<uint16_t> cars(kTrafficCars.begin(), kTrafficCars.end());
 
     auto availablePedsNodes = findAvailableNodes(ai::NodeType::Pedestrian, camera, radius);
 
@@ -169,14 +272,7 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
             }
             counter--;
 
-            // Spawn a pedestrian from the available pool
-            const auto pedId =
-                peds.at(world->getRandomNumber(0u, peds.size() - 1));
-            auto ped = world->createPedestrian(pedId, spawn->position);
-            ped->applyOffset();
-            ped->setLifetime(GameObject::TrafficLifetime);
-            ped->controller->setGoal(CharacterController::TrafficWander);
-            created.push_back(ped);
+            created.push_back(spawnPedestrian(spawn, peds));
         }
     }
 
@@ -201,66 +297,168 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
             }
             counter--;
 
-            // Get the next node, to spawn in between
-            AIGraphNode* next = spawn->connections.at(0);
+            auto spawned = spawnVehicle(spawn, cars, peds);
+            created.insert(created.end(), spawned.begin(), spawned.end());
+        }
+    }
+
+    return created;
+}
+
+void TrafficDirector::updateCandidates(const glm::vec3& position,
+                                       float radius) {
+    const auto cell = glm::ivec2(
+        glm::floor(glm::vec2(position) / static_cast<float>(WORLD_CELL_SIZE)));
+    if (cell == candidateCell && radius == candidateRadius &&
+        std::abs(position.z - candidateHeight) < kCandidateHeightSlack) {
+        return;
+    }
+    candidateCell = cell;
+    candidateRadius = radius;
+    candidateHeight = position.z;
+
+    const auto center =
+        (glm::vec2(cell) + 0.5f) * static_cast<float>(WORLD_CELL_SIZE);
+    const auto origin = glm::vec3(center, position.z);
+    candidatePeds.clear();
+    candidateCars.clear();
+    graph->gatherExternalNodesNear(origin, radius + kCandidateMargin,
+                                   candidatePeds, ai::NodeType::Pedestrian);
+    graph->gatherExternalNodesNear(origin, radius + kCandidateMargin,
+                                   candidateCars, ai::NodeType::Vehicle);
+}
+
+bool TrafficDirector::warmModels(std::vector<uint16_t>& models,
+                                 bool allowLoad) {
+    bool loaded = false;
+    bool prefetched = false;
+    models.erase(
+        std::remove_if(models.begin(), models.end(),
+                       [&](uint16_t id) {
+                           auto it = world->data->modelinfo.find(id);
+                           if (it == world->data->modelinfo.end()) {
+                               return true;
+                           }
+                           if (it->second->isLoaded()) {
+                               return false;
+                           }
+                           if (loaded || prefetched) {
+                               return true;
+                           }
+                           // Reading and decoding happen on the workers, only
+                           // load once both the DFF and TXD are ready
+                           world->data->prefetchModel(id);
+                           prefetched = true;
+                           if (allowLoad && world->data->isModelReady(id)) {
+                               loaded = world->data->loadModel(id);
+                               return !loaded;
+                           }
+                           return true;
+                       }),
+        models.end());
+    if (loaded) {
+        metrics.modelLoads++;
+    }
+    return loaded;
+}
+
+void TrafficDirector::update(const ViewCamera& camera, float radius) {
+    RW_PROFILE_SCOPE(__func__);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<GameObject*> created;
+    const auto canSpawn = [&]() {
+        return static_cast<int>(created.size()) < spawnBudget &&
+               millisecondsSince(start) < timeBudget;
+    };
+
+    updateCandidates(camera.position, radius);
+
+    spawnAtGenerators(camera, radius, canSpawn, created);
+
+    const auto inRange = [&](const std::vector<AIGraphNode*>& candidates) {
+        std::vector<AIGraphNode*> nodes;
+        for (const auto node : candidates) {
+            if (glm::distance2(camera.position, node->position) <
+                radius * radius) {
+                nodes.push_back(node);
+            }
+        }
+        return nodes;
+    };
+
+    // Spawns only use models that are loaded, missing models are read on the
+    // workers and one is loaded per tick once it's ready, so that a new ped
+    // group or area doesn't cause a stall.
+    auto peds = getPedestrianModels(camera.position);
+    bool loadedModel = canSpawn() && warmModels(peds, true);
+
+    if (!peds.empty() && canSpawn() &&
+        maximumPedestrians > world->pedestrianPool.objects.size()) {
+        auto nodes = inRange(candidatePeds);
+        filterAvailable(nodes, ai::NodeType::Pedestrian, camera, radius);
+
+        for (AIGraphNode* spawn : nodes) {
+            if (!canSpawn() ||
+                maximumPedestrians <= world->pedestrianPool.objects.size()) {
+                break;
+            }
+            created.push_back(spawnPedestrian(spawn, peds));
+        }
+    }
 
-            // Set the spawn point to the middle of the two nodes
-            const glm::vec3 diff = (spawn->position - next->position) / 2.f;
+    std::vector<uint16_t> cars(kTrafficCars.begin(), kTrafficCars.end());
+    warmModels(cars, canSpawn() && !loadedModel);
 
-            // Calculate the orientation of the vehicle
-            glm::mat4 rotMat = glm::lookAt(next->position, spawn->position, glm::vec3(0,0,1));
-            const glm::mat4 rotate =
-                glm::rotate(glm::radians(90.f), glm::vec3(1, 0, 0));
-            rotMat = rotate * rotMat;
+    if (!peds.empty() && !cars.empty() && canSpawn() &&
+        maximumCars > world->vehiclePool.objects.size()) {
+        auto nodes = inRange(candidateCars);
+        filterAvailable(nodes, ai::NodeType::Vehicle, camera, radius);
 
-            const glm::quat orientation = glm::conjugate(glm::toQuat(rotMat));
+        for (AIGraphNode* spawn : nodes) {
+            if (!canSpawn() ||
+                maximumCars <= world->vehiclePool.objects.size()) {
+                break;
+            }
+            auto spawned = spawnVehicle(spawn, cars, peds);
+            created.insert(created.end(), spawned.begin(), spawned.end());
+        }
+    }
 
-            const glm::vec3 up = glm::vec3(0, 0, 1);
-            const glm::vec3 dir =
-                glm::normalize(next->position - spawn->position);
+    metrics.spawns += created.size();
+    metrics.updateTime = millisecondsSince(start);
+    metrics.peakUpdateTime = std::max(metrics.peakUpdateTime, metrics.updateTime);
+    RW_PROFILE_COUNTER_SET("traffic/candidates", getCandidateCount());
+}
 
-            // Calculate the strafe vector
-            const glm::vec3 strafe = glm::cross(up, dir);
+void TrafficDirector::cleanup(const ViewCamera& camera, float radius) {
+    RW_PROFILE_SCOPE(__func__);
+    const auto start = std::chrono::steady_clock::now();
 
-            // @todo we don't know the direction of the street, so for now, choose the smaller value
-            int maxLanes = spawn->rightLanes < spawn->leftLanes ? spawn->rightLanes : spawn->leftLanes;
-	
-            // This street has no lanes, continue
-            if( maxLanes <= 0 ) {
+    for (auto* pool : {&world->pedestrianPool, &world->vehiclePool}) {
+        for (auto& p : pool->objects) {
+            if (p.second->getLifetime() != GameObject::TrafficLifetime) {
                 continue;
             }
 
-            // Choose a random lane
-            const int lane = world->getRandomNumber(1, maxLanes);
-            const glm::vec3 laneOffset =
-                strafe * (2.5f + 5.f * static_cast<float>(lane - 1));
-
-            // Spawn a vehicle from the available pool
-            const auto carId =
-                cars.at(world->getRandomNumber(0u, cars.size() - 1));
-            auto vehicle = world->createVehicle(carId, next->position + diff + laneOffset, orientation);
-            vehicle->applyOffset();
-            vehicle->setLifetime(GameObject::TrafficLifetime);
-            vehicle->setHandbraking(false);
-
-            // Spawn a pedestrian and put it into the vehicle
-            const auto pedId =
-                peds.at(world->getRandomNumber(0u, peds.size() - 1));
-            CharacterObject* character = world->createPedestrian(pedId, vehicle->getPosition());
-            character->setLifetime(GameObject::TrafficLifetime);
-            character->setCurrentVehicle(vehicle, 0);
-            character->controller->setGoal(CharacterController::TrafficDriver);
-            character->controller->setLane(lane);
-            vehicle->setOccupant(0, character);
-
-            created.push_back(character);
-            created.push_back(vehicle);
+            if (glm::distance(camera.position, p.second->getPosition()) >=
+                radius) {
+                if (!camera.frustum.intersects(p.second->getPosition(), 1.f)) {
+                    world->destroyObjectQueued(p.second.get());
+                    metrics.despawns++;
+                }
+            }
         }
     }
 
-    // Find places it's legal to spawn things
+    world->destroyQueuedObjects();
 
-    return created;
+    metrics.cleanupTime = millisecondsSince(start);
+}
+
+void TrafficDirector::setBudget(int maxSpawns, float maxMilliseconds) {
+    spawnBudget = maxSpawns;
+    timeBudget = maxMilliseconds;
 }
 
 void TrafficDirector::setPopulationLimits(int maxPeds, int maxCars) {
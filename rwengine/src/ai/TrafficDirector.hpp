@@ -3,6 +3,11 @@
 
 #include <vector>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 
 class GameWorld;
 class GameObject;
@@ -16,6 +21,21 @@ struct AIGraphNode;
 
 class TrafficDirector {
 public:
+    /**
+     * Counters for the work done by update() and cleanup()
+     */
+    struct Metrics {
+        uint64_t spawns = 0;
+        uint64_t despawns = 0;
+        uint64_t modelLoads = 0;
+        /// Time spent in the last update() in ms
+        float updateTime = 0.f;
+        /// Time spent in the last cleanup() in ms
+        float cleanupTime = 0.f;
+        /// Longest update() so far in ms
+        float peakUpdateTime = 0.f;
+    };
+
     TrafficDirector(AIGraph* graph, GameWorld* world);
 
     std::vector<AIGraphNode*> findAvailableNodes(NodeType type,
@@ -33,18 +53,87 @@ public:
     std::vector<GameObject*> populateNearby(const ViewCamera& camera,
                                             float radius, int maxSpawn = -1);
 
+    /**
+     * Incrementally creates traffic around the camera, within the per-tick
+     * budget. Only models that are already loaded are spawned, missing ones
+     * are loaded one per tick.
+     * @param camera The camera to spawn around
+     * @param radius the maximum distance to spawn in
+     */
+    void update(const ViewCamera& camera, float radius);
+
+    /**
+     * Destroys traffic further than radius away and out of view
+     */
+    void cleanup(const ViewCamera& camera, float radius);
+
+    /**
+     * Sets the maximum number of spawns and the time update() may spend in
+     * a single tick
+     */
+    void setBudget(int maxSpawns, float maxMilliseconds);
+
     /**
      * Sets the maximum number of pedestrians and cars in the traffic system
      */
     void setPopulationLimits(int maxPeds, int maxCars);
 
+    const Metrics& getMetrics() const {
+        return metrics;
+    }
+
+    /**
+     * @return The number of nodes that update() considers for spawning
+     */
+    size_t getCandidateCount() const {
+        return candidatePeds.size() + candidateCars.size();
+    }
+
 private:
+    /// Re-gathers the candidate nodes when the camera enters another cell
+    void updateCandidates(const glm::vec3& position, float radius);
+
+    /// Removes nodes that are blocked by objects or in view
+    void filterAvailable(std::vector<AIGraphNode*>& nodes, NodeType type,
+                         const ViewCamera& camera, float radius);
+
+    void spawnAtGenerators(const ViewCamera& camera, float radius,
+                           const std::function<bool()>& canSpawn,
+                           std::vector<GameObject*>& created);
+
+    std::vector<uint16_t> getPedestrianModels(const glm::vec3& position);
+
+    GameObject* spawnPedestrian(AIGraphNode* spawn,
+                                const std::vector<uint16_t>& models);
+
+    /// @return The driver and the vehicle, or an empty list if the node has
+    /// no lanes
+    std::vector<GameObject*> spawnVehicle(
+        AIGraphNode* spawn, const std::vector<uint16_t>& carModels,
+        const std::vector<uint16_t>& pedModels);
+
+    /// Removes models that aren't loaded. The first of them is prefetched,
+    /// and loaded once its files are ready
+    /// @return true if a model was loaded
+    bool warmModels(std::vector<uint16_t>& models, bool allowLoad);
+
     AIGraph* graph = nullptr;
     GameWorld* world = nullptr;
     float pedDensity = 1.f;
     float carDensity = 1.f;
     size_t maximumPedestrians = 20;
     size_t maximumCars = 10;
+
+    int spawnBudget = 2;
+    float timeBudget = 1.f;
+
+    std::vector<AIGraphNode*> candidatePeds;
+    std::vector<AIGraphNode*> candidateCars;
+    glm::ivec2 candidateCell{};
+    float candidateRadius = -1.f;
+    float candidateHeight = 0.f;
+
+    Metrics metrics;
 };
 
 }  // namespace ai
@@ -0,0 +1,252 @@
+#include "audio/AudioStreamer.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include "audio/SoundSource.hpp"
+#include "audio/alCheck.hpp"
+#include "core/Profiler.hpp"
+
+struct AudioStreamer::Stream {
+    ALuint source;
+    std::array<ALuint, kNrBuffersStreaming> buffers{};
+    /// Buffers that aren't queued on the source
+    std::vector<ALuint> freeBuffers;
+    std::shared_ptr<SoundSource> soundSource;
+    /// Number of samples queued since the start
+    size_t offset = 0;
+    bool playing = false;
+    bool needsRewind = false;
+    std::atomic<StreamState> state{StreamState::Initial};
+};
+
+AudioStreamer::AudioStreamer() = default;
+
+AudioStreamer::~AudioStreamer() {
+    shutdown();
+}
+
+void AudioStreamer::start() {
+    if (running) {
+        return;
+    }
+    running = true;
+    thread = std::thread(&AudioStreamer::serviceMain, this);
+}
+
+void AudioStreamer::shutdown() {
+    if (running) {
+        running = false;
+        thread.join();
+    }
+    for (auto& stream : streams) {
+        release(*stream);
+    }
+    streams.clear();
+}
+
+AudioStreamer::Stream* AudioStreamer::createStream(ALuint source) {
+    auto stream = new Stream;
+    stream->source = source;
+    push({Command::Create, stream, nullptr, 0.f});
+    return stream;
+}
+
+void AudioStreamer::attach(Stream* stream,
+                           std::shared_ptr<SoundSource> soundSource) {
+    stream->state = StreamState::Initial;
+    push({Command::Attach, stream, std::move(soundSource), 0.f});
+}
+
+void AudioStreamer::play(Stream* stream) {
+    stream->state = StreamState::Playing;
+    push({Command::Play, stream, nullptr, 0.f});
+}
+
+void AudioStreamer::pause(Stream* stream) {
+    stream->state = StreamState::Paused;
+    push({Command::Pause, stream, nullptr, 0.f});
+}
+
+void AudioStreamer::stop(Stream* stream) {
+    stream->state = StreamState::Stopped;
+    push({Command::Stop, stream, nullptr, 0.f});
+}
+
+void AudioStreamer::setGain(Stream* stream, float gain) {
+    push({Command::SetGain, stream, nullptr, gain});
+}
+
+void AudioStreamer::remove(Stream* stream) {
+    push({Command::Remove, stream, nullptr, 0.f});
+}
+
+AudioStreamer::StreamState AudioStreamer::getState(
+    const Stream* stream) const {
+    return stream->state.load();
+}
+
+void AudioStreamer::push(Command&& command) {
+    // Without the thread there's nobody to race with
+    if (!running) {
+        execute(command);
+        return;
+    }
+
+    if (!commands.push(std::move(command))) {
+        stallCount.fetch_add(1, std::memory_order_relaxed);
+        RW_PROFILE_COUNTER_ADD("audio/stalls", 1);
+        while (!commands.push(std::move(command))) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void AudioStreamer::serviceMain() {
+    RW_PROFILE_THREAD("Audio");
+    Command command;
+    while (running) {
+        {
+            RW_PROFILE_SCOPE("Audio streaming");
+            while (commands.pop(command)) {
+                execute(command);
+            }
+
+            for (auto& stream : streams) {
+                if (stream->playing && !update(*stream)) {
+                    stream->playing = false;
+                    stream->needsRewind = true;
+                    stream->state = StreamState::Stopped;
+                }
+            }
+        }
+        std::this_thread::sleep_for(kServiceInterval);
+    }
+
+    while (commands.pop(command)) {
+        execute(command);
+    }
+}
+
+void AudioStreamer::execute(Command& command) {
+    auto& stream = *command.stream;
+    switch (command.type) {
+        case Command::Create:
+            alCheck(alGenBuffers(kNrBuffersStreaming, stream.buffers.data()));
+            stream.freeBuffers.assign(stream.buffers.begin(),
+                                      stream.buffers.end());
+            streams.emplace_back(command.stream);
+            break;
+        case Command::Attach:
+            stream.soundSource = std::move(command.soundSource);
+            stream.playing = false;
+            rewind(stream);
+            break;
+        case Command::Play: {
+            if (!stream.soundSource) {
+                break;
+            }
+            if (stream.needsRewind) {
+                rewind(stream);
+            }
+            ALint state;
+            alCheck(alGetSourcei(stream.source, AL_SOURCE_STATE, &state));
+            if (state != AL_PLAYING) {
+                alCheck(alSourcePlay(stream.source));
+            }
+            stream.playing = true;
+            stream.state = StreamState::Playing;
+        } break;
+        case Command::Pause:
+            alCheck(alSourcePause(stream.source));
+            stream.playing = false;
+            stream.state = StreamState::Paused;
+            break;
+        case Command::Stop:
+            alCheck(alSourceStop(stream.source));
+            stream.playing = false;
+            stream.needsRewind = true;
+            stream.state = StreamState::Stopped;
+            break;
+        case Command::SetGain:
+            alCheck(alSourcef(stream.source, AL_GAIN, command.value));
+            break;
+        case Command::Remove: {
+            release(stream);
+            auto it = std::find_if(
+                streams.begin(), streams.end(),
+                [&](const auto& s) { return s.get() == command.stream; });
+            if (it != streams.end()) {
+                streams.erase(it);
+            }
+        } break;
+    }
+    command.soundSource = nullptr;
+}
+
+bool AudioStreamer::update(Stream& stream) {
+    ALint processed;
+    alCheck(alGetSourcei(stream.source, AL_BUFFERS_PROCESSED, &processed));
+    for (; processed > 0; --processed) {
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(stream.source, 1, &buffer));
+        stream.freeBuffers.push_back(buffer);
+    }
+
+    fill(stream);
+
+    ALint state, queued;
+    alCheck(alGetSourcei(stream.source, AL_SOURCE_STATE, &state));
+    alCheck(alGetSourcei(stream.source, AL_BUFFERS_QUEUED, &queued));
+    if (state == AL_PLAYING || state == AL_PAUSED) {
+        return true;
+    }
+    if (queued > 0) {
+        // The source ran out of data before it was refilled
+        alCheck(alSourcePlay(stream.source));
+        return true;
+    }
+    // Nothing left to play, unless more is being decoded
+    return stream.soundSource->isDecoding();
+}
+
+void AudioStreamer::rewind(Stream& stream) {
+    alCheck(alSourceRewind(stream.source));
+    alCheck(alSourcei(stream.source, AL_BUFFER, 0));
+    stream.freeBuffers.assign(stream.buffers.begin(), stream.buffers.end());
+    stream.offset = 0;
+    stream.needsRewind = false;
+    fill(stream);
+}
+
+void AudioStreamer::fill(Stream& stream) {
+    if (!stream.soundSource) {
+        return;
+    }
+
+    auto& soundSource = *stream.soundSource;
+    std::lock_guard<std::mutex> lock(soundSource.mutex);
+    const auto& data = soundSource.data;
+    while (!stream.freeBuffers.empty() && stream.offset < data.size()) {
+        const auto size = std::min(static_cast<size_t>(kSizeOfChunk),
+                                   data.size() - stream.offset);
+        const auto buffer = stream.freeBuffers.back();
+        stream.freeBuffers.pop_back();
+
+        alCheck(alBufferData(
+            buffer,
+            soundSource.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16,
+            &data[stream.offset], static_cast<ALsizei>(size * sizeof(int16_t)),
+            static_cast<ALsizei>(soundSource.sampleRate)));
+        alCheck(alSourceQueueBuffers(stream.source, 1, &buffer));
+        stream.offset += size;
+    }
+}
+
+void AudioStreamer::release(Stream& stream) {
+    alCheck(alSourceStop(stream.source));
+    alCheck(alSourcei(stream.source, AL_BUFFER, 0));
+    alCheck(alDeleteBuffers(kNrBuffersStreaming, stream.buffers.data()));
+    alCheck(alDeleteSources(1, &stream.source));
+    stream.soundSource = nullptr;
+}
@@ -0,0 +1,105 @@
+#ifndef _RWENGINE_AUDIO_STREAMER_HPP_
+#define _RWENGINE_AUDIO_STREAMER_HPP_
+
+#include <al.h>
+
+#include <core/SpscQueue.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class SoundSource;
+
+/// Audio service thread, owns the streamed sounds and keeps their
+/// OpenAL buffer queues filled.
+/// The game thread controls the streams with commands sent through a lock
+/// free queue, so it never waits for decoding or for the buffers.
+class AudioStreamer {
+public:
+    static constexpr unsigned int kNrBuffersStreaming = 4;
+    static constexpr unsigned int kSizeOfChunk = 4096;
+    /// How often the thread checks for commands and refills the buffers
+    static constexpr std::chrono::milliseconds kServiceInterval{5};
+
+    /// State of a stream as seen by the game thread
+    enum class StreamState : uint8_t { Initial, Playing, Paused, Stopped };
+
+    struct Stream;
+
+    AudioStreamer();
+    ~AudioStreamer();
+
+    AudioStreamer(const AudioStreamer&) = delete;
+    AudioStreamer& operator=(const AudioStreamer&) = delete;
+
+    /// Start the service thread, OpenAL has to be initialized
+    void start();
+
+    /// Process the remaining commands, release all streams and stop the
+    /// service thread
+    void shutdown();
+
+    /// @name Commands, called from the game thread
+    /// @{
+
+    /// Create a stream playing on source, which the streamer deletes once
+    /// the stream is removed
+    Stream* createStream(ALuint source);
+    void attach(Stream* stream, std::shared_ptr<SoundSource> soundSource);
+    void play(Stream* stream);
+    void pause(Stream* stream);
+    void stop(Stream* stream);
+    void setGain(Stream* stream, float gain);
+    /// Release the stream, it can't be used afterwards
+    void remove(Stream* stream);
+    /// @}
+
+    StreamState getState(const Stream* stream) const;
+
+    /// Number of times the game thread had to wait for the queue
+    size_t getStallCount() const {
+        return stallCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Command {
+        enum Type : uint8_t {
+            Create,
+            Attach,
+            Play,
+            Pause,
+            Stop,
+            SetGain,
+            Remove
+        };
+
+        Type type = Create;
+        Stream* stream = nullptr;
+        std::shared_ptr<SoundSource> soundSource;
+        float value = 0.f;
+    };
+
+    void push(Command&& command);
+    void serviceMain();
+    void execute(Command& command);
+    /// Refill the buffers of a stream, returns false once it finished
+    bool update(Stream& stream);
+    void rewind(Stream& stream);
+    void fill(Stream& stream);
+    void release(Stream& stream);
+
+    SpscQueue<Command, 256> commands;
+    std::atomic<size_t> stallCount{0};
+    std::atomic<bool> running{false};
+    std::thread thread;
+
+    /// Only touched by the service thread
+    std::vector<std::unique_ptr<Stream>> streams;
+};
+
+#endif
@@ -0,0 +1,187 @@
+#include "audio/SfxBank.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+#include <rw/debug.hpp>
+
+#include <loaders/LoaderSDT.hpp>
+
+#include "core/Profiler.hpp"
+#include "core/TaskScheduler.hpp"
+
+namespace {
+constexpr uint32_t kBankMagic = 0x42535752;  // RWSB
+constexpr uint32_t kBankVersion = 1;
+/// Samples of each entry start on this boundary
+constexpr uint64_t kSampleAlignment = 16;
+
+struct BankHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t archiveHash;
+};
+
+struct BankEntry {
+    uint64_t offset;
+    uint32_t sampleCount;
+    uint32_t sampleRate;
+    uint32_t loopStart;
+    int32_t loopEnd;
+    uint32_t channels;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(BankHeader) == 24, "BankHeader must not be padded");
+static_assert(sizeof(BankEntry) == 32, "BankEntry must not be padded");
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+}  // namespace
+
+uint64_t SfxBank::hashArchive(const LoaderSDT& sdt) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < sdt.getAssetCount(); ++i) {
+        const auto& asset = sdt.getAssetInfoByIndex(i);
+        hash = hashBytes(hash, &asset, sizeof(asset));
+    }
+    std::error_code ec;
+    const uint64_t rawSize =
+        std::filesystem::file_size(sdt.getArchivePath(), ec);
+    return hashBytes(hash, &rawSize, sizeof(rawSize));
+}
+
+bool SfxBank::build(const LoaderSDT& sdt, const std::filesystem::path& path,
+                    TaskScheduler& workers) {
+    RW_PROFILE_SCOPE(__func__);
+    const auto count = sdt.getAssetCount();
+
+    // Lay out the index and samples of the whole bank up front, so the
+    // workers can decode straight into their part of it
+    std::vector<BankEntry> index(count);
+    uint64_t offset = sizeof(BankHeader) + count * sizeof(BankEntry);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& asset = sdt.getAssetInfoByIndex(i);
+        offset = (offset + kSampleAlignment - 1) & ~(kSampleAlignment - 1);
+        // The archive holds 16 bit mono PCM
+        index[i] = {offset,
+                    asset.size / 2,
+                    asset.sampleRate,
+                    asset.loopStart,
+                    static_cast<int32_t>(asset.loopEnd),
+                    1,
+                    0};
+        offset += uint64_t{index[i].sampleCount} * sizeof(int16_t);
+    }
+
+    std::vector<char> bank(offset);
+    const BankHeader header{kBankMagic, kBankVersion,
+                            static_cast<uint32_t>(count), 0,
+                            hashArchive(sdt)};
+    std::memcpy(bank.data(), &header, sizeof(header));
+    if (count > 0) {
+        std::memcpy(bank.data() + sizeof(header), index.data(),
+                    count * sizeof(BankEntry));
+    }
+
+    std::atomic<bool> failed{false};
+    const auto& rawPath = sdt.getArchivePath();
+    workers.parallelFor(
+        0, static_cast<int>(count), 64, [&](int begin, int end) {
+            // Each range reads through its own handle
+            FILE* fp = std::fopen(rawPath.c_str(), "rb");
+            if (!fp) {
+                failed = true;
+                return;
+            }
+            for (int i = begin; i < end; ++i) {
+                const auto& asset = sdt.getAssetInfoByIndex(i);
+                const auto size = index[i].sampleCount * sizeof(int16_t);
+                if (std::fseek(fp, static_cast<long>(asset.offset),
+                               SEEK_SET) != 0 ||
+                    std::fread(bank.data() + index[i].offset, 1, size, fp) !=
+                        size) {
+                    failed = true;
+                    break;
+                }
+            }
+            std::fclose(fp);
+        });
+    if (failed) {
+        RW_ERROR("Error reading samples from " << rawPath);
+        return false;
+    }
+
+    FILE* out = std::fopen(path.string().c_str(), "wb");
+    if (!out) {
+        RW_ERROR("Error cannot write sfx bank " << path);
+        return false;
+    }
+    const bool written =
+        std::fwrite(bank.data(), 1, bank.size(), out) == bank.size();
+    std::fclose(out);
+    if (!written) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    return written;
+}
+
+bool SfxBank::load(const std::filesystem::path& path, const LoaderSDT& sdt) {
+    RW_PROFILE_SCOPE(__func__);
+    unload();
+
+    if (!file.open(path)) {
+        return false;
+    }
+
+    BankHeader header;
+    if (file.size() < sizeof(header)) {
+        unload();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != kBankMagic || header.version != kBankVersion ||
+        header.count != sdt.getAssetCount() ||
+        header.archiveHash != hashArchive(sdt) ||
+        file.size() < sizeof(header) + header.count * sizeof(BankEntry)) {
+        unload();
+        return false;
+    }
+
+    entries.resize(header.count);
+    for (size_t i = 0; i < header.count; ++i) {
+        BankEntry entry;
+        std::memcpy(&entry,
+                    file.data() + sizeof(header) + i * sizeof(BankEntry),
+                    sizeof(entry));
+        const auto bytes = uint64_t{entry.sampleCount} * sizeof(int16_t);
+        if (entry.offset % kSampleAlignment != 0 ||
+            entry.offset + bytes > file.size()) {
+            unload();
+            return false;
+        }
+        entries[i] = {
+            reinterpret_cast<const int16_t*>(file.data() + entry.offset),
+            entry.sampleCount,
+            entry.sampleRate,
+            entry.channels,
+            entry.loopStart,
+            entry.loopEnd};
+    }
+    return true;
+}
+
+void SfxBank::unload() {
+    entries.clear();
+    file.close();
+}
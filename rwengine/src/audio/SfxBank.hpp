@@ -0,0 +1,59 @@
+#ifndef _RWENGINE_SFX_BANK_HPP_
+#define _RWENGINE_SFX_BANK_HPP_
+
+#include <core/MappedFile.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+class LoaderSDT;
+class TaskScheduler;
+
+/// Decoded samples of every sfx in the SDT archive, stored in one file.
+/// The bank is built once from the archive and memory mapped afterwards,
+/// so getting the samples of an sfx doesn't need a decoder.
+class SfxBank {
+public:
+    struct Entry {
+        const int16_t* samples = nullptr;
+        size_t sampleCount = 0;
+        uint32_t sampleRate = 0;
+        uint32_t channels = 1;
+        /// Loop points as stored in the archive, loopEnd is -1 for the end
+        uint32_t loopStart = 0;
+        int32_t loopEnd = -1;
+    };
+
+    /// Decode all entries of sdt on workers and write them to path
+    static bool build(const LoaderSDT& sdt, const std::filesystem::path& path,
+                      TaskScheduler& workers);
+
+    /// Map the bank at path, fails if it wasn't built from sdt
+    bool load(const std::filesystem::path& path, const LoaderSDT& sdt);
+
+    void unload();
+
+    bool isLoaded() const {
+        return file.isOpen();
+    }
+
+    /// @return The entry of sfx index or nullptr if the bank doesn't have it
+    const Entry* get(size_t index) const {
+        return index < entries.size() ? &entries[index] : nullptr;
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    /// Identifies the contents of the archive
+    static uint64_t hashArchive(const LoaderSDT& sdt);
+
+private:
+    MappedFile file;
+    std::vector<Entry> entries;
+};
+
+#endif
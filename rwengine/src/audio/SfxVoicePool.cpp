@@ -0,0 +1,122 @@
+#include "audio/SfxVoicePool.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <rw/debug.hpp>
+
+SfxVoicePool::SfxVoicePool(size_t size, size_t maxSources)
+    : voices(size), maxSources(maxSources) {
+    RW_ASSERT(size > 0 && size <= (size_t{1} << kIndexBits));
+    freeVoices.reserve(size);
+    ranked.reserve(size);
+    // Hand out the voices from the first one
+    for (size_t i = size; i > 0; --i) {
+        freeVoices.push_back(i - 1);
+    }
+}
+
+void SfxVoicePool::start(size_t index, bool looping, float duration) {
+    auto& voice = voices[index];
+    voice.playing = true;
+    voice.looping = looping;
+    voice.duration = duration;
+    voice.elapsed = 0.f;
+}
+
+void SfxVoicePool::release(size_t index) {
+    auto& voice = voices[index];
+    if (!voice.active) {
+        return;
+    }
+    voice.active = false;
+    voice.playing = false;
+    voice.hasSource = false;
+    freeVoices.push_back(index);
+}
+
+size_t SfxVoicePool::find(size_t handle) const {
+    const auto index = handle & ((size_t{1} << kIndexBits) - 1);
+    if (handle == kNoVoice || index >= voices.size()) {
+        return kNoVoice;
+    }
+    const auto& voice = voices[index];
+    if (!voice.active || (handle >> kIndexBits) != voice.generation) {
+        return kNoVoice;
+    }
+    return index;
+}
+
+void SfxVoicePool::setEmitter(size_t index, const Emitter& emitter) {
+    voices[index].emitter = emitter;
+}
+
+float SfxVoicePool::getPlayTime(size_t index) const {
+    const auto& voice = voices[index];
+    if (voice.looping && voice.duration > 0.f) {
+        return std::fmod(voice.elapsed, voice.duration);
+    }
+    return std::min(voice.elapsed, voice.duration);
+}
+
+size_t SfxVoicePool::getSourceCount() const {
+    return static_cast<size_t>(
+        std::count_if(voices.begin(), voices.end(),
+                      [](const Voice& voice) { return voice.hasSource; }));
+}
+
+float SfxVoicePool::getAudibility(const Emitter& emitter,
+                                  const glm::vec3& listener) {
+    // OpenAL's default reference distance
+    constexpr float kReferenceDistance = 1.f;
+    if (emitter.maxDistance <= 0.f) {
+        return emitter.gain;
+    }
+
+    const auto distance = glm::distance(emitter.position, listener);
+    if (emitter.maxDistance <= kReferenceDistance) {
+        return distance <= emitter.maxDistance ? emitter.gain : 0.f;
+    }
+    const auto clamped =
+        std::clamp(distance, kReferenceDistance, emitter.maxDistance);
+    return emitter.gain * (1.f - (clamped - kReferenceDistance) /
+                                     (emitter.maxDistance - kReferenceDistance));
+}
+
+size_t SfxVoicePool::findQuietest(const glm::vec3& listener) const {
+    size_t quietest = 0;
+    float lowest = getAudibility(voices[0].emitter, listener);
+    for (size_t i = 1; i < voices.size(); ++i) {
+        const auto audibility = getAudibility(voices[i].emitter, listener);
+        if (audibility < lowest) {
+            lowest = audibility;
+            quietest = i;
+        }
+    }
+    return quietest;
+}
+
+void SfxVoicePool::rank() {
+    // Voices keep their source when they are as audible as a new one,
+    // so equally loud sounds don't swap sources every update
+    auto louder = [this](const RankedVoice& a, const RankedVoice& b) {
+        if (a.audibility != b.audibility) {
+            return a.audibility > b.audibility;
+        }
+        return voices[a.index].hasSource && !voices[b.index].hasSource;
+    };
+    if (ranked.size() > maxSources) {
+        std::nth_element(ranked.begin(), ranked.begin() + maxSources,
+                         ranked.end(), louder);
+        ranked.resize(maxSources);
+    }
+
+    for (auto& voice : voices) {
+        voice.selected = false;
+    }
+    for (const auto& rankedVoice : ranked) {
+        voices[rankedVoice.index].selected = true;
+    }
+}
@@ -0,0 +1,204 @@
+#ifndef _RWENGINE_SFX_VOICE_POOL_HPP_
+#define _RWENGINE_SFX_VOICE_POOL_HPP_
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Tracks the sound effects that are playing as virtual voices, and decides
+/// which of them play on one of the limited OpenAL sources.
+/// Virtual voices keep their position and play time without a source, the
+/// most audible ones are given a source and the others lose theirs.
+/// Free voices are kept on a stack, when they run out the least audible
+/// voice is stolen if the new sound would be more audible.
+/// Handles include a generation, so handles of stolen voices are rejected.
+class SfxVoicePool {
+public:
+    static constexpr size_t kNoVoice = ~size_t{0};
+
+    /// Voices quieter than this never get a source
+    static constexpr float kMinAudibility = 0.01f;
+
+    /// Where and how loud a voice plays
+    struct Emitter {
+        glm::vec3 position{};
+        /// Distance at which the sound becomes silent, 0 or less for none
+        float maxDistance = -1.f;
+        float gain = 1.f;
+    };
+
+    /// @param size Number of virtual voices
+    /// @param maxSources Number of voices that may have a source at once
+    SfxVoicePool(size_t size, size_t maxSources);
+
+    /// Acquire a voice for a sound, it's silent until started.
+    /// @param onSteal called with the index of a voice holding a source
+    /// before it's stolen.
+    /// @return The handle of the voice or kNoVoice.
+    template <class OnSteal>
+    size_t acquire(const Emitter& emitter, const glm::vec3& listener,
+                   OnSteal&& onSteal) {
+        size_t index;
+        if (!freeVoices.empty()) {
+            index = freeVoices.back();
+            freeVoices.pop_back();
+        } else {
+            index = findQuietest(listener);
+            if (getAudibility(emitter, listener) <=
+                getAudibility(voices[index].emitter, listener)) {
+                return kNoVoice;
+            }
+            if (voices[index].hasSource) {
+                onSteal(index);
+            }
+            stolenCount++;
+        }
+
+        auto& voice = voices[index];
+        voice = Voice{emitter, voice.generation};
+        voice.active = true;
+        voice.generation = (voice.generation + 1) & kGenerationMask;
+        return (static_cast<size_t>(voice.generation) << kIndexBits) | index;
+    }
+
+    /// Start playing a voice from the beginning
+    void start(size_t index, bool looping, float duration);
+
+    /// Return a voice to the free voices, the caller has to release its
+    /// source first
+    void release(size_t index);
+
+    /// Advance the play time of the voices and choose the ones that play on
+    /// sources. Voices that finished are released.
+    /// @param demote called with the index of a voice that has to give up
+    /// its source, before any voice is promoted
+    /// @param promote called with the index of a voice that gets a source
+    template <class Demote, class Promote>
+    void update(const glm::vec3& listener, float dt, Demote&& demote,
+                Promote&& promote) {
+        ranked.clear();
+        for (size_t i = 0; i < voices.size(); ++i) {
+            auto& voice = voices[i];
+            if (!voice.active || !voice.playing) {
+                continue;
+            }
+            voice.elapsed += dt;
+            if (!voice.looping && voice.elapsed >= voice.duration) {
+                if (voice.hasSource) {
+                    demote(i);
+                    voice.hasSource = false;
+                }
+                release(i);
+                continue;
+            }
+            const auto audibility = getAudibility(voice.emitter, listener);
+            if (audibility >= kMinAudibility) {
+                ranked.push_back({audibility, i});
+            }
+        }
+
+        rank();
+
+        for (size_t i = 0; i < voices.size(); ++i) {
+            auto& voice = voices[i];
+            if (voice.hasSource && !voice.selected) {
+                demote(i);
+                voice.hasSource = false;
+            }
+        }
+        for (const auto& rankedVoice : ranked) {
+            auto& voice = voices[rankedVoice.index];
+            if (!voice.hasSource) {
+                promote(rankedVoice.index);
+                voice.hasSource = true;
+            }
+        }
+    }
+
+    /// @return The index of the voice or kNoVoice if handle is stale
+    size_t find(size_t handle) const;
+
+    /// Update where the voice plays
+    void setEmitter(size_t index, const Emitter& emitter);
+
+    const Emitter& getEmitter(size_t index) const {
+        return voices[index].emitter;
+    }
+
+    /// Seconds the voice has been playing, within its duration if looping
+    float getPlayTime(size_t index) const;
+
+    bool isLooping(size_t index) const {
+        return voices[index].looping;
+    }
+
+    bool hasSource(size_t index) const {
+        return voices[index].hasSource;
+    }
+
+    void setMaxSources(size_t sources) {
+        maxSources = sources;
+    }
+
+    size_t getMaxSources() const {
+        return maxSources;
+    }
+
+    size_t size() const {
+        return voices.size();
+    }
+
+    size_t getActiveCount() const {
+        return voices.size() - freeVoices.size();
+    }
+
+    /// Number of voices that play on a source
+    size_t getSourceCount() const;
+
+    size_t getStolenCount() const {
+        return stolenCount;
+    }
+
+    /// Gain of the emitter heard at the listener, following the
+    /// AL_LINEAR_DISTANCE_CLAMPED model used by the sound manager
+    static float getAudibility(const Emitter& emitter,
+                               const glm::vec3& listener);
+
+private:
+    static constexpr size_t kIndexBits = 8;
+    /// Handles stay positive when stored as script integers
+    static constexpr uint32_t kGenerationMask = (1u << 22) - 1;
+
+    struct Voice {
+        Emitter emitter;
+        uint32_t generation = 0;
+        bool active = false;
+        bool playing = false;
+        bool looping = false;
+        bool hasSource = false;
+        /// Set by rank for the voices that should have a source
+        bool selected = false;
+        float elapsed = 0.f;
+        float duration = 0.f;
+    };
+
+    struct RankedVoice {
+        float audibility;
+        size_t index;
+    };
+
+    size_t findQuietest(const glm::vec3& listener) const;
+
+    /// Keep the maxSources most audible voices in ranked and mark them
+    void rank();
+
+    std::vector<Voice> voices;
+    std::vector<size_t> freeVoices;
+    std::vector<RankedVoice> ranked;
+    size_t maxSources;
+    size_t stolenCount = 0;
+};
+
+#endif
@@ -5,6 +5,29 @@
 #include "audio/SoundSource.hpp"
 #include "audio/alCheck.hpp"
 
+SoundBufferData::SoundBufferData(SoundSource& soundSource)
+    : SoundBufferData(soundSource.data.data(), soundSource.data.size(),
+                      soundSource.channels, soundSource.sampleRate) {
+}
+
+SoundBufferData::SoundBufferData(const int16_t* samples, size_t sampleCount,
+                                 uint32_t channels, uint32_t sampleRate) {
+    if (channels > 0 && sampleRate > 0) {
+        duration = static_cast<float>(sampleCount / channels) /
+                   static_cast<float>(sampleRate);
+    }
+    alCheck(alGenBuffers(1, &buffer));
+    alCheck(alBufferData(buffer,
+                         channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16,
+                         samples,
+                         static_cast<ALsizei>(sampleCount * sizeof(int16_t)),
+                         static_cast<ALsizei>(sampleRate)));
+}
+
+SoundBufferData::~SoundBufferData() {
+    alCheck(alDeleteBuffers(1, &buffer));
+}
+
 SoundBuffer::SoundBuffer() {
     alCheck(alGenSources(1, &source));
     alCheck(alGenBuffers(1, &buffer));
@@ -17,7 +40,10 @@ SoundBuffer::SoundBuffer() {
 }
 
 SoundBuffer::~SoundBuffer() {
-    alCheck(alDeleteSources(1, &source));
+    // The source is deleted before a shared buffer is released
+    if (source != 0) {
+        alCheck(alDeleteSources(1, &source));
+    }
     alCheck(alDeleteBuffers(1, &buffer));
 }
 
@@ -29,6 +55,13 @@ bool SoundBuffer::bufferData(SoundSource& soundSource) {
         static_cast<ALsizei>(soundSource.data.size() * sizeof(int16_t)),
         soundSource.sampleRate));
     alCheck(alSourcei(source, AL_BUFFER, buffer));
+    shared = nullptr;
+    return true;
+}
+
+bool SoundBuffer::attachBuffer(std::shared_ptr<SoundBufferData> data) {
+    alCheck(alSourcei(source, AL_BUFFER, data->buffer));
+    shared = std::move(data);
     return true;
 }
 
@@ -4,8 +4,28 @@
 #include <al.h>
 #include <glm/vec3.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 class SoundSource;
 
+/// OpenAL buffer with the decoded samples of a sound,
+/// shared by all the sources playing it.
+struct SoundBufferData {
+    explicit SoundBufferData(SoundSource& soundSource);
+    SoundBufferData(const int16_t* samples, size_t sampleCount,
+                    uint32_t channels, uint32_t sampleRate);
+    ~SoundBufferData();
+
+    SoundBufferData(const SoundBufferData&) = delete;
+    SoundBufferData& operator=(const SoundBufferData&) = delete;
+
+    ALuint buffer;
+    /// Length of the samples in seconds
+    float duration = 0.f;
+};
+
 /// OpenAL tool for playing
 /// sound instance.
 struct SoundBuffer {
@@ -13,9 +33,13 @@ struct SoundBuffer {
     virtual ~SoundBuffer();
     virtual bool bufferData(SoundSource& soundSource);
 
-    bool isPlaying() const;
-    bool isPaused() const;
-    bool isStopped() const;
+    /// Play samples uploaded once instead of uploading them again,
+    /// the source has to be stopped.
+    bool attachBuffer(std::shared_ptr<SoundBufferData> data);
+
+    virtual bool isPlaying() const;
+    virtual bool isPaused() const;
+    virtual bool isStopped() const;
 
     virtual void play();
     virtual void pause();
@@ -24,7 +48,7 @@ struct SoundBuffer {
     void setPosition(const glm::vec3& position);
     void setLooping(bool looping);
     void setPitch(float pitch);
-    void setGain(float gain);
+    virtual void setGain(float gain);
     void setMaxDistance(float maxDist);
 
     enum class State {
@@ -37,6 +61,7 @@ struct SoundBuffer {
     State state = State::Created;
 private:
     ALuint buffer;
+    std::shared_ptr<SoundBufferData> shared;
 };
 
 #endif
@@ -1,32 +1,31 @@
 #ifndef _RWENGINE_SOUND_BUFFER_STREAMED_HPP_
 #define _RWENGINE_SOUND_BUFFER_STREAMED_HPP_
 
+#include "audio/AudioStreamer.hpp"
 #include "audio/SoundBuffer.hpp"
 
-#include <array>
-#include <future>
-
+/// Sound streamed by the audio thread while it's decoded.
+/// Playback commands are passed to the AudioStreamer and return
+/// immediately, the state reflects the last command until the
+/// stream finishes.
 struct SoundBufferStreamed : public SoundBuffer {
-    static constexpr unsigned int kNrBuffersStreaming = 4;
-    static constexpr unsigned int kSizeOfChunk = 4096;
-    static constexpr std::chrono::milliseconds kTickFreqMs =
-        std::chrono::milliseconds(100);
-
-    SoundBufferStreamed();
+    explicit SoundBufferStreamed(AudioStreamer& streamer);
     ~SoundBufferStreamed() override;
     bool bufferData(SoundSource& soundSource) final;
 
+    bool isPlaying() const final;
+    bool isPaused() const final;
+    bool isStopped() const final;
+
     void play() final;
     void pause() final;
     void stop() final;
 
+    void setGain(float gain) final;
+
 private:
-    SoundSource* soundSource = nullptr;
-    void updateBuffers();
-    unsigned int streamedData = 0;
-    unsigned int buffersUsed = 0;
-    std::array<ALuint, kNrBuffersStreaming> buffers;
-    std::future<void> bufferingThread;
+    AudioStreamer& streamer;
+    AudioStreamer::Stream* stream;
 };
 
 #endif
@@ -16,16 +16,18 @@ extern "C" {
 #include "engine/GameWorld.hpp"
 #include "render/ViewCamera.hpp"
 
+#include "core/Profiler.hpp"
+
 #include <rw/types.hpp>
 
-Sound& SoundManager::getSfxBufferRef(size_t name) {
-    auto ref = buffers.find(name);
-    if (ref != buffers.end()) {
-        return ref->second;
-    } else {
-        createSfxInstance(name);
+#include <limits>
+
+Sound* SoundManager::getSfxVoice(size_t handle) {
+    auto voice = sfxVoicePool.find(handle);
+    if (voice == kNoSfxVoice) {
+        return nullptr;
     }
-    return buffers[name];
+    return &sfxVoices[voice];
 }
 
 Sound& SoundManager::getSfxSourceRef(size_t name) {
@@ -39,15 +41,22 @@ Sound& SoundManager::getSoundRef(const std::string& name) {
 SoundManager::SoundManager() {
     initializeOpenAL();
     initializeAVCodec();
+    streamer.start();
 }
 
-SoundManager::SoundManager(GameWorld* engine) : _engine(engine) {
+SoundManager::SoundManager(GameWorld* engine, bool nullAudio)
+    : _engine(engine), nullAudio(nullAudio) {
+    if (nullAudio) {
+        return;
+    }
+
     auto sdtPath = _engine->data->index.findFilePath("audio/sfx.SDT");
     auto rawPath = _engine->data->index.findFilePath("audio/sfx.RAW");
     sdt.load(sdtPath, rawPath);
 
     initializeOpenAL();
     initializeAVCodec();
+    streamer.start();
 }
 
 SoundManager::~SoundManager() {
@@ -93,9 +102,14 @@ void SoundManager::initializeAVCodec() {
 }
 
 void SoundManager::deinitializeOpenAL() {
-    // Buffers have to been removed before openAL is deinitialized
+    // Buffers have to been removed before openAL is deinitialized,
+    // the voices first as they use the sfx buffers
     sounds.clear();
-    buffers.clear();
+    sfxVoices.clear();
+    sfxSources.clear();
+    sfxVoiceData.clear();
+    sfxBuffers.clear();
+    streamer.shutdown();
 
     // De-initialize OpenAL
     if (alContext) {
@@ -112,6 +126,12 @@ void SoundManager::deinitializeOpenAL() {
 
 bool SoundManager::loadSound(const std::string& name,
                              const std::string& fileName, bool streamed) {
+    // Silent sounds load and finish right away, so scripts waiting on them
+    // carry on
+    if (nullAudio) {
+        return true;
+    }
+
     Sound* sound = nullptr;
     auto sound_iter = sounds.find(name);
 
@@ -124,7 +144,7 @@ bool SoundManager::loadSound(const std::string& name,
         sound = &it->second;
 
         sound->source = std::make_shared<SoundSource>();
-        sound->buffer = streamed ? std::make_unique<SoundBufferStreamed>() : std::make_unique<SoundBuffer>();
+        sound->buffer = streamed ? std::make_unique<SoundBufferStreamed>(streamer) : std::make_unique<SoundBuffer>();
 
         sound->source->loadFromFile(fileName, streamed);
         sound->isLoaded = sound->buffer->bufferData(*sound->source);
@@ -142,44 +162,132 @@ void SoundManager::loadSound(size_t index) {
     sound = &it->second;
 
     sound->source = std::make_shared<SoundSource>();
-    sound->source->loadSfx(sdt, index);
+    if (auto entry = sfxBank.get(index)) {
+        sound->source->loadSfx(*entry);
+    } else {
+        sound->source->loadSfx(sdt, index);
+    }
 }
 
-size_t SoundManager::createSfxInstance(size_t index) {
-    Sound* sound = nullptr;
-    auto soundRef = sfx.find(index);
+bool SoundManager::loadSfxBank(const std::filesystem::path& path,
+                               TaskScheduler& workers) {
+    if (nullAudio) {
+        return false;
+    }
+    if (sfxBank.load(path, sdt)) {
+        return true;
+    }
+    return SfxBank::build(sdt, path, workers) && sfxBank.load(path, sdt);
+}
 
+std::shared_ptr<SoundBufferData> SoundManager::getSfxBufferData(
+    size_t index) {
+    auto it = sfxBuffers.find(index);
+    if (it != sfxBuffers.end()) {
+        return it->second;
+    }
+
+    if (auto entry = sfxBank.get(index)) {
+        // Upload straight from the mapped bank
+        if (entry->sampleCount == 0) {
+            return nullptr;
+        }
+        RW_PROFILE_COUNTER_ADD("sfx/uploads", 1);
+        auto data = std::make_shared<SoundBufferData>(
+            entry->samples, entry->sampleCount, entry->channels,
+            entry->sampleRate);
+        sfxBuffers.emplace(index, data);
+        return data;
+    }
+
+    auto soundRef = sfx.find(index);
     if (soundRef == sfx.end()) {
         // Sound source is not loaded yet
         loadSound(index);
         soundRef = sfx.find(index);
     }
 
-    // Try to reuse first available buffer
-    // (aka with stopped state)
-    for (auto& [id, sound] : buffers) {
-        if (sound.buffer && sound.isStopped()) {
-            // Let's use this buffer
-            sound.buffer = std::make_unique<SoundBuffer>();
-            sound.source = soundRef->second.source;
-            sound.isLoaded = sound.buffer->bufferData(*sound.source);
-            return id;
-        }
+    auto& source = *soundRef->second.source;
+    if (source.data.empty()) {
+        return nullptr;
+    }
+    RW_PROFILE_COUNTER_ADD("sfx/uploads", 1);
+    auto data = std::make_shared<SoundBufferData>(source);
+    sfxBuffers.emplace(index, data);
+    return data;
+}
+
+size_t SoundManager::createSfxInstance(size_t index) {
+    return createSfxInstance(index, listenerPosition);
+}
+
+size_t SoundManager::createSfxInstance(size_t sfxIndex,
+                                       const glm::vec3& position,
+                                       int maxDist) {
+    if (nullAudio) {
+        return kNoSfxVoice;
+    }
+
+    auto data = getSfxBufferData(sfxIndex);
+    if (!data) {
+        return kNoSfxVoice;
+    }
+
+    SfxVoicePool::Emitter emitter{position, static_cast<float>(maxDist),
+                                  getCalculatedVolumeOfEffects()};
+    auto handle =
+        sfxVoicePool.acquire(emitter, listenerPosition,
+                             [&](size_t voice) { demoteSfxVoice(voice); });
+    if (handle == kNoSfxVoice) {
+        RW_PROFILE_COUNTER_ADD("sfx/dropped", 1);
+        return kNoSfxVoice;
     }
-    // There's no available free buffer, so
-    // we should create a new one.
-    auto [it, emplaced] = buffers.emplace(std::piecewise_construct,
-                                          std::forward_as_tuple(bufferNr),
-                                          std::forward_as_tuple());
-    sound = &it->second;
 
-    sound->id = bufferNr;
-    sound->buffer = std::make_unique<SoundBuffer>();
-    sound->source = soundRef->second.source;
-    sound->isLoaded = sound->buffer->bufferData(*sound->source);
-    bufferNr++;
+    const auto index = sfxVoicePool.find(handle);
+    auto& voice = sfxVoices[index];
+    voice.id = handle;
+    auto source = sfx.find(sfxIndex);
+    voice.source = source != sfx.end() ? source->second.source : nullptr;
+    voice.isLoaded = true;
+    sfxVoiceData[index] = std::move(data);
+    return handle;
+}
+
+void SoundManager::promoteSfxVoice(size_t index) {
+    auto& voice = sfxVoices[index];
+    if (voice.buffer) {
+        // Restarted while it has a source
+        voice.stop();
+    } else if (!sfxSources.empty()) {
+        voice.buffer = std::move(sfxSources.back());
+        sfxSources.pop_back();
+    } else {
+        voice.buffer = std::make_unique<SoundBuffer>();
+    }
 
-    return sound->id;
+    // Sources are reused, so reset everything a previous sfx might have set
+    const auto& emitter = sfxVoicePool.getEmitter(index);
+    voice.buffer->attachBuffer(sfxVoiceData[index]);
+    voice.setPosition(emitter.position);
+    voice.setLooping(sfxVoicePool.isLooping(index));
+    voice.setPitch(1.f);
+    voice.setGain(emitter.gain);
+    voice.setMaxDistance(emitter.maxDistance > 0.f
+                             ? emitter.maxDistance
+                             : std::numeric_limits<float>::max());
+    // Continue where the virtual voice is
+    alCheck(alSourcef(voice.buffer->source, AL_SEC_OFFSET,
+                      sfxVoicePool.getPlayTime(index)));
+    voice.play();
+}
+
+void SoundManager::demoteSfxVoice(size_t index) {
+    auto& voice = sfxVoices[index];
+    if (!voice.buffer) {
+        return;
+    }
+    voice.stop();
+    sfxSources.push_back(std::move(voice.buffer));
 }
 
 bool SoundManager::isLoaded(const std::string& name) {
@@ -187,7 +295,7 @@ bool SoundManager::isLoaded(const std::string& name) {
     if (sound != sounds.end()) {
         return sound->second.isLoaded;
     }
-    return false;
+    return nullAudio;
 }
 
 bool SoundManager::isPlaying(const std::string& name) {
@@ -203,7 +311,7 @@ bool SoundManager::isStopped(const std::string& name) {
     if (sound != sounds.end()) {
         return sound->second.isStopped();
     }
-    return false;
+    return nullAudio;
 }
 
 bool SoundManager::isPaused(const std::string& name) {
@@ -232,22 +340,44 @@ void SoundManager::eraseSound(const std::string& name) {
     }
 }
 
-void SoundManager::playSfx(size_t name, const glm::vec3& position, bool looping,
-                           int maxDist) {
-    auto buffer = buffers.find(name);
-    if (buffer != buffers.end()) {
-        buffer->second.setPosition(position);
-        if (looping) {
-            buffer->second.setLooping(looping);
-        }
+void SoundManager::playSfx(size_t handle, const glm::vec3& position,
+                           bool looping, int maxDist) {
+    auto index = sfxVoicePool.find(handle);
+    if (index == kNoSfxVoice) {
+        return;
+    }
 
-        buffer->second.setPitch(1.f);
-        buffer->second.setGain(getCalculatedVolumeOfEffects());
-        if (maxDist != -1) {
-            buffer->second.setMaxDistance(static_cast<float>(maxDist));
-        }
-        buffer->second.play();
+    sfxVoicePool.setEmitter(index, {position, static_cast<float>(maxDist),
+                                    getCalculatedVolumeOfEffects()});
+    sfxVoicePool.start(index, looping, sfxVoiceData[index]->duration);
+    if (sfxVoicePool.hasSource(index)) {
+        promoteSfxVoice(index);
     }
+
+    // Audible sounds start right away instead of on the next tick
+    updateSfxVoices(0.f);
+}
+
+void SoundManager::stopSfx(size_t handle) {
+    auto index = sfxVoicePool.find(handle);
+    if (index == kNoSfxVoice) {
+        return;
+    }
+    demoteSfxVoice(index);
+    sfxVoicePool.release(index);
+}
+
+void SoundManager::updateSfxVoices(float dt) {
+    sfxVoicePool.update(
+        listenerPosition, dt, [&](size_t voice) { demoteSfxVoice(voice); },
+        [&](size_t voice) { promoteSfxVoice(voice); });
+
+    RW_PROFILE_COUNTER_SET("sfx/voices", sfxVoicePool.getActiveCount());
+    RW_PROFILE_COUNTER_SET("sfx/sources", sfxVoicePool.getSourceCount());
+}
+
+void SoundManager::setMaxSfxSources(size_t sources) {
+    sfxVoicePool.setMaxSources(sources);
 }
 
 void SoundManager::pauseAllSounds() {
@@ -256,9 +386,9 @@ void SoundManager::pauseAllSounds() {
             sound.second.pause();
         }
     }
-    for (auto& sound : buffers) {
-        if (sound.second.isPlaying()) {
-            sound.second.pause();
+    for (auto& voice : sfxVoices) {
+        if (voice.buffer && voice.isPlaying()) {
+            voice.pause();
         }
     }
 }
@@ -269,14 +399,17 @@ void SoundManager::resumeAllSounds() {
             sound.second.play();
         }
     }
-    for (auto& sound : buffers) {
-        if (sound.second.isPaused()) {
-            sound.second.play();
+    for (auto& voice : sfxVoices) {
+        if (voice.buffer && voice.isPaused()) {
+            voice.play();
         }
     }
 }
 
 bool SoundManager::playBackground(const std::string& fileName) {
+    if (nullAudio) {
+        return false;
+    }
     if (this->loadSound(fileName, fileName)) {
         backgroundNoise = fileName;
         auto& sound = getSoundRef(fileName);
@@ -292,6 +425,31 @@ bool SoundManager::loadMusic(const std::string& name,
     return loadSound(name, fileName);
 }
 
+std::shared_ptr<SoundSource> SoundManager::openMusic(
+    const std::string& fileName) {
+    auto source = std::make_shared<SoundSource>();
+    source->loadFromFile(fileName, true);
+    return source;
+}
+
+bool SoundManager::addMusic(const std::string& name,
+                            std::shared_ptr<SoundSource> source) {
+    if (nullAudio) {
+        return false;
+    }
+
+    auto [it, emplaced] =
+        sounds.emplace(std::piecewise_construct, std::forward_as_tuple(name),
+                       std::forward_as_tuple());
+    auto& sound = it->second;
+    if (emplaced) {
+        sound.source = std::move(source);
+        sound.buffer = std::make_unique<SoundBufferStreamed>(streamer);
+        sound.isLoaded = sound.buffer->bufferData(*sound.source);
+    }
+    return sound.isLoaded;
+}
+
 void SoundManager::playMusic(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
@@ -317,6 +475,11 @@ void SoundManager::pause(bool p) {
 }
 
 void SoundManager::updateListenerTransform(const ViewCamera& cam) {
+    listenerPosition = cam.position;
+    if (nullAudio) {
+        return;
+    }
+
     // Orientation
     auto up = cam.rotation * glm::vec3(0.f, 0.f, 1.f);
     auto at = cam.rotation * glm::vec3(1.f, 0.f, 0.f);
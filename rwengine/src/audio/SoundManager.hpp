@@ -1,6 +1,9 @@
 #ifndef _RWENGINE_SOUNDMANAGER_HPP_
 #define _RWENGINE_SOUNDMANAGER_HPP_
 
+#include "audio/AudioStreamer.hpp"
+#include "audio/SfxBank.hpp"
+#include "audio/SfxVoicePool.hpp"
 #include "audio/Sound.hpp"
 
 #include <alc.h>
@@ -9,11 +12,17 @@
 
 #include <loaders/LoaderSDT.hpp>
 
+#include <filesystem>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 class GameWorld;
+struct SoundBuffer;
+class TaskScheduler;
 class ViewCamera;
+struct SoundBufferData;
 
 /// Game's sound manager.
 /// It handles all stuff connected with sounds.
@@ -23,20 +32,55 @@ class ViewCamera;
 /// instances simultaneously without duplicating raw source).
 class SoundManager {
 public:
+    /// Number of sfx that can play at once, most of them virtually
+    static constexpr size_t kSfxVoiceCount = 256;
+    /// Default number of sfx that play on OpenAL sources
+    static constexpr size_t kDefaultMaxSfxSources = 32;
+    static constexpr size_t kNoSfxVoice = SfxVoicePool::kNoVoice;
+
     SoundManager();
-    SoundManager(GameWorld* engine);
+    /// @param nullAudio Don't open an audio device or start the streamer.
+    /// Sounds then load as silent and are never playing, sfx get no voice.
+    SoundManager(GameWorld* engine, bool nullAudio = false);
     ~SoundManager();
 
+    bool isNullAudio() const {
+        return nullAudio;
+    }
+
     /// Load sound from file and store it with selected name
     bool loadSound(const std::string& name, const std::string& fileName, bool streamed = true);
 
     /// Load selected sfx sound
     void loadSound(size_t index);
 
-    Sound& getSfxBufferRef(size_t name);
+    /// Map the decoded sfx bank at path, building it on workers first when
+    /// it's missing or was built from other archive.
+    /// Sfx found in the bank are loaded without decoding them.
+    bool loadSfxBank(const std::filesystem::path& path,
+                     TaskScheduler& workers);
+
+    const SfxBank& getSfxBank() const {
+        return sfxBank;
+    }
+
+    /// Voice of an sfx instance, nullptr if it was stolen or stopped.
+    /// It only has a buffer while it plays on a source.
+    Sound* getSfxVoice(size_t handle);
     Sound& getSfxSourceRef(size_t name);
     Sound& getSoundRef(const std::string& name);
 
+    /// Acquire a voice playing selected sfx at position, its samples are
+    /// uploaded to OpenAL the first time the sfx is used.
+    /// When all voices are in use the least audible one is stolen.
+    /// The voice only gets an OpenAL source while it's among the most
+    /// audible sfx, otherwise its play time is tracked virtually.
+    /// @return Handle of the voice or kNoSfxVoice if the sfx would be less
+    /// audible than all playing sounds.
+    size_t createSfxInstance(size_t index, const glm::vec3& position,
+                             int maxDist = -1);
+
+    /// Acquire a voice for selected sfx playing at the listener
     size_t createSfxInstance(size_t index);
 
     /// Checking is selected sound loaded.
@@ -58,12 +102,30 @@ public:
     void eraseSound(const std::string& name);
 
     /// Effect same as playSound with one parametr,
-    /// but this function works for sfx and
+    /// but this function works for sfx voices and
     /// allows also for setting position,
     /// looping and max Distance.
     /// -1 means no limit of max distance.
-    void playSfx(size_t name, const glm::vec3& position, bool looping = false,
-                 int maxDist = -1);
+    void playSfx(size_t handle, const glm::vec3& position,
+                 bool looping = false, int maxDist = -1);
+
+    /// Stop an sfx voice and release it
+    void stopSfx(size_t handle);
+
+    /// Advance the virtual sfx voices and move the sources to the most
+    /// audible ones, called once per tick.
+    void updateSfxVoices(float dt);
+
+    /// Limit the number of OpenAL sources used by sfx
+    void setMaxSfxSources(size_t sources);
+
+    const SfxVoicePool& getSfxVoicePool() const {
+        return sfxVoicePool;
+    }
+
+    const AudioStreamer& getAudioStreamer() const {
+        return streamer;
+    }
 
     void pauseAllSounds();
     void resumeAllSounds();
@@ -72,6 +134,14 @@ public:
     bool playBackground(const std::string& fileName);
 
     bool loadMusic(const std::string& name, const std::string& fileName);
+
+    /// Open a music file and start decoding it, for addMusic.
+    /// Unlike the rest of the manager it can be used from any thread.
+    static std::shared_ptr<SoundSource> openMusic(const std::string& fileName);
+
+    /// Store music opened with openMusic with selected name
+    bool addMusic(const std::string& name, std::shared_ptr<SoundSource> source);
+
     void playMusic(const std::string& name);
     void stopMusic(const std::string& name);
 
@@ -93,21 +163,40 @@ private:
 
     void deinitializeOpenAL();
 
+    std::shared_ptr<SoundBufferData> getSfxBufferData(size_t index);
+
+    /// Give a voice a source and start it at its play time
+    void promoteSfxVoice(size_t index);
+    /// Stop the source of a voice and keep it for other voices
+    void demoteSfxVoice(size_t index);
+
     ALCcontext* alContext = nullptr;
     ALCdevice* alDevice = nullptr;
 
+    /// Streams the sounds, declared first as they use it until destroyed
+    AudioStreamer streamer;
+
     /// Containers for sounds
     std::unordered_map<std::string, Sound> sounds;
     std::unordered_map<size_t, Sound> sfx;
-    std::unordered_map<size_t, Sound> buffers;
+
+    /// Uploaded samples of each sfx, shared by the voices playing them
+    std::unordered_map<size_t, std::shared_ptr<SoundBufferData>> sfxBuffers;
+    std::vector<Sound> sfxVoices = std::vector<Sound>(kSfxVoiceCount);
+    std::vector<std::shared_ptr<SoundBufferData>> sfxVoiceData =
+        std::vector<std::shared_ptr<SoundBufferData>>(kSfxVoiceCount);
+    /// Sources not used by any voice
+    std::vector<std::unique_ptr<SoundBuffer>> sfxSources;
+    SfxVoicePool sfxVoicePool{kSfxVoiceCount, kDefaultMaxSfxSources};
 
     std::string backgroundNoise;
 
-    /// Nr of already created buffers
-    size_t bufferNr = 0;
+    glm::vec3 listenerPosition{};
 
     GameWorld* _engine;
+    bool nullAudio = false;
     LoaderSDT sdt{};
+    SfxBank sfxBank;
 
     /// Sound volume
     float _volume = 1.f;
@@ -550,3 +550,10 @@ void SoundSource::loadSfx(LoaderSDT& sdt, size_t index, bool asWave,
         }
     }
 }
+
+void SoundSource::loadSfx(const SfxBank::Entry& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    channels = entry.channels;
+    sampleRate = entry.sampleRate;
+    data.assign(entry.samples, entry.samples + entry.sampleCount);
+}
@@ -6,9 +6,13 @@ extern "C" {
 #include <libavutil/avutil.h>
 }
 
+#include "audio/SfxBank.hpp"
+
 #include <cstdint>
 #include <filesystem>
+#include <chrono>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -27,9 +31,11 @@ class LoaderSDT;
 /// Opaque for raw sound,
 /// cooperate with ffmpeg
 /// (loading and decoding sound)
-class SoundSource {
+class SoundSource : public std::enable_shared_from_this<SoundSource> {
+    friend class AudioStreamer;
     friend class SoundManager;
     friend struct SoundBuffer;
+    friend struct SoundBufferData;
     friend struct SoundBufferStreamed;
 
 public:
@@ -78,6 +84,16 @@ public:
     void loadSfx(LoaderSDT& sdt, std::size_t index, bool asWave = true,
                  bool streaming = false);
 
+    /// Copy the samples of an sfx from the bank, without decoding
+    void loadSfx(const SfxBank::Entry& entry);
+
+    /// Checking is the rest of a streamed sound still being decoded.
+    bool isDecoding() const {
+        return loadingThread.valid() &&
+               loadingThread.wait_for(std::chrono::seconds(0)) !=
+                   std::future_status::ready;
+    }
+
     unsigned int decodedFrames = 0u;
 
 private:
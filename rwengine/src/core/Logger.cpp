@@ -1,44 +1,296 @@
 #include <core/Logger.hpp>
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <map>
 
+#include "core/Profiler.hpp"
+
+namespace {
+uint64_t nextLoggerId() {
+    static std::atomic<uint64_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t getThreadNumber() {
+    static std::atomic<uint32_t> next{0};
+    thread_local uint32_t number = next.fetch_add(1, std::memory_order_relaxed);
+    return number;
+}
+
+void writeJsonString(std::ostream& out, const std::string& string) {
+    out << '"';
+    for (char c : string) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[7];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+}  // namespace
+
+Logger::Logger(std::initializer_list<MessageReceiver*> initial)
+    : id(nextLoggerId()), receivers(initial) {
+}
+
+Logger::~Logger() {
+    stop();
+    std::lock_guard<std::mutex> lock(receiverMutex);
+    drain();
+    reportRepeats(std::chrono::system_clock::now(), true);
+}
+
+void Logger::start() {
+    if (running) {
+        return;
+    }
+    running = true;
+    thread = std::thread(&Logger::flushMain, this);
+}
+
+void Logger::stop() {
+    if (running) {
+        running = false;
+        thread.join();
+    }
+}
+
+void Logger::flush() {
+    std::lock_guard<std::mutex> lock(receiverMutex);
+    drain();
+}
+
 void Logger::log(const std::string& component, Logger::MessageSeverity severity,
                  const std::string& message) {
-    LogMessage m{component, severity, message};
+    if (severity < kMinSeverity) {
+        return;
+    }
+    const auto now = std::chrono::system_clock::now();
 
-    for (MessageReceiver* r : receivers) {
-        r->messageReceived(m);
+    // Without the thread there's nobody to pass the messages on
+    if (!running.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(receiverMutex);
+        current.component = component;
+        current.severity = severity;
+        current.message = message;
+        current.time = now;
+        current.thread = getThreadNumber();
+        dispatch(current);
+        reportRepeats(now, false);
+        return;
+    }
+
+    Record record;
+    record.time = now;
+    record.thread = getThreadNumber();
+    record.severity = severity;
+    const auto componentSize = std::min(component.size(), kMaxComponentSize);
+    const auto messageSize =
+        std::min(message.size(), kRecordTextSize - componentSize);
+    std::memcpy(record.text.data(), component.data(), componentSize);
+    std::memcpy(record.text.data() + componentSize, message.data(),
+                messageSize);
+    record.componentSize = static_cast<uint16_t>(componentSize);
+    record.messageSize = static_cast<uint16_t>(messageSize);
+    record.truncated = messageSize < message.size();
+
+    if (!getThreadQueue().push(std::move(record))) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
 void Logger::addReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::mutex> lock(receiverMutex);
     receivers.push_back(out);
 }
 
 void Logger::removeReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::mutex> lock(receiverMutex);
     receivers.erase(std::remove(receivers.begin(), receivers.end(), out),
                     receivers.end());
 }
 
-void Logger::error(const std::string& component, const std::string& message) {
-    log(component, Logger::Error, message);
+Logger::RecordQueue& Logger::getThreadQueue() {
+    struct CachedQueue {
+        uint64_t logger;
+        RecordQueue* queue;
+    };
+    thread_local std::vector<CachedQueue> cache;
+    for (const auto& cached : cache) {
+        if (cached.logger == id) {
+            return *cached.queue;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queues.push_back(std::make_unique<RecordQueue>());
+    cache.push_back({id, queues.back().get()});
+    return *queues.back();
+}
+
+void Logger::flushMain() {
+    RW_PROFILE_THREAD("Logger");
+    while (running) {
+        {
+            RW_PROFILE_SCOPE("Logger flush");
+            std::lock_guard<std::mutex> lock(receiverMutex);
+            drain();
+        }
+        std::this_thread::sleep_for(kFlushInterval);
+    }
+
+    std::lock_guard<std::mutex> lock(receiverMutex);
+    drain();
 }
 
-void Logger::info(const std::string& component, const std::string& message) {
-    log(component, Logger::Info, message);
+void Logger::drain() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        drainQueues.clear();
+        for (const auto& queue : queues) {
+            drainQueues.push_back(queue.get());
+        }
+    }
+
+    Record record;
+    for (auto queue : drainQueues) {
+        while (queue->pop(record)) {
+            current.component.assign(record.text.data(), record.componentSize);
+            current.message.assign(record.text.data() + record.componentSize,
+                                   record.messageSize);
+            if (record.truncated) {
+                current.message += "...";
+            }
+            current.severity = record.severity;
+            current.time = record.time;
+            current.thread = record.thread;
+            dispatch(current);
+        }
+    }
+
+    const auto now = std::chrono::system_clock::now();
+    const auto dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != reportedDropCount) {
+        LogMessage message{"Logger", Warning,
+                           "Dropped " +
+                               std::to_string(dropped - reportedDropCount) +
+                               " messages, a thread's queue was full"};
+        message.time = now;
+        send(message);
+        reportedDropCount = dropped;
+    }
+    reportRepeats(now, false);
 }
 
-void Logger::warning(const std::string& component, const std::string& message) {
-    log(component, Logger::Warning, message);
+void Logger::dispatch(const LogMessage& message) {
+    const auto key = std::hash<std::string>{}(message.component) * 31 +
+                     std::hash<std::string>{}(message.message);
+    auto& repeat = repeats[key];
+    if (repeat.count == 0 || message.time - repeat.windowStart >= kRateWindow) {
+        if (repeat.suppressed > 0) {
+            reportRepeat(repeat, message.time);
+        }
+        repeat.windowStart = message.time;
+        repeat.count = 0;
+        repeat.suppressed = 0;
+    }
+
+    if (++repeat.count > kMaxRepeats) {
+        if (repeat.suppressed++ == 0) {
+            repeat.severity = message.severity;
+            repeat.component = message.component;
+            repeat.message = message.message;
+        }
+        suppressedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    send(message);
 }
 
-void Logger::verbose(const std::string& component, const std::string& message) {
-    log(component, Logger::Verbose, message);
+void Logger::send(const LogMessage& message) {
+    for (MessageReceiver* r : receivers) {
+        r->messageReceived(message);
+    }
+}
+
+void Logger::reportRepeats(std::chrono::system_clock::time_point now,
+                           bool all) {
+    // Checking every message would be quadratic
+    if (!all && now - lastRepeatReport < kRateWindow) {
+        return;
+    }
+    lastRepeatReport = now;
+
+    for (auto it = repeats.begin(); it != repeats.end();) {
+        const auto& repeat = it->second;
+        if (all || now - repeat.windowStart >= kRateWindow) {
+            if (repeat.suppressed > 0) {
+                reportRepeat(repeat, now);
+            }
+            it = repeats.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void Logger::reportRepeat(const RepeatedMessage& repeat,
+                          std::chrono::system_clock::time_point now) {
+    LogMessage message{repeat.component, repeat.severity,
+                       "Suppressed " + std::to_string(repeat.suppressed) +
+                           " repeats of: " + repeat.message};
+    message.time = now;
+    send(message);
 }
 
 void StdOutReceiver::messageReceived(const Logger::LogMessage& message) {
     std::cout << Logger::messageSeverityName[message.severity] << " ["
               << message.component << "] " << message.message << '\n';
 }
+
+JsonFileReceiver::JsonFileReceiver(const std::string& path)
+    : file(path, std::ios::out | std::ios::trunc) {
+}
+
+void JsonFileReceiver::messageReceived(const Logger::LogMessage& message) {
+    if (!file.is_open()) {
+        return;
+    }
+    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          message.time.time_since_epoch())
+                          .count();
+    file << "{\"time\":" << time << ",\"thread\":" << message.thread
+         << ",\"severity\":\""
+         << Logger::messageSeverityName[message.severity]
+         << "\",\"component\":";
+    writeJsonString(file, message.component);
+    file << ",\"message\":";
+    writeJsonString(file, message.message);
+    file << "}\n";
+    // Keep errors when the game crashes afterwards
+    if (message.severity == Logger::Error) {
+        file.flush();
+    }
+}
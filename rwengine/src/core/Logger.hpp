@@ -1,22 +1,58 @@
 #ifndef _RWENGINE_LOGGER_HPP_
 #define _RWENGINE_LOGGER_HPP_
 
+#include <core/SpscQueue.hpp>
+
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#ifndef RW_LOG_MIN_SEVERITY
+#define RW_LOG_MIN_SEVERITY 0
+#endif
+
 /**
  * Handles and stores messages from different components
  *
  * Dispatches received messages to logger outputs.
+ *
+ * Once started, messages are copied into a lock free queue owned by the
+ * logging thread and passed to the receivers by the logger's thread, so
+ * logging never waits for the outputs. Until then they are passed on by the
+ * logging thread. Messages repeated within kRateWindow are passed on at most
+ * kMaxRepeats times, and a count of the others follows.
  */
 class Logger {
 public:
     enum MessageSeverity { Verbose = 0, Info, Warning, Error};
     static constexpr std::array<char, 4> messageSeverityName{{'V', 'I', 'W', 'E'}};
 
+    /// Messages below this severity are compiled out
+    static constexpr MessageSeverity kMinSeverity =
+        static_cast<MessageSeverity>(RW_LOG_MIN_SEVERITY);
+
+    /// Times a message is passed on within kRateWindow
+    static constexpr unsigned int kMaxRepeats = 5;
+    static constexpr std::chrono::seconds kRateWindow{1};
+    /// How often the thread passes on the queued messages
+    static constexpr std::chrono::milliseconds kFlushInterval{10};
+    /// Messages queued per thread, more are dropped until the next flush
+    static constexpr size_t kQueueSize = 256;
+    /// Characters of a queued component and message, the rest is cut off
+    static constexpr size_t kRecordTextSize = 480;
+    static constexpr size_t kMaxComponentSize = 64;
+
     struct LogMessage {
         /// The component that produced the message
         std::string component;
@@ -24,6 +60,11 @@ public:
         MessageSeverity severity;
         /// Logged message
         std::string message;
+        /// When the message was logged
+        std::chrono::system_clock::time_point time{};
+        /// Number of the thread that logged the message, in the order the
+        /// threads first logged
+        size_t thread = 0;
 
         template <class String1, class String2>
         LogMessage(String1&& cc, MessageSeverity ss,
@@ -37,33 +78,143 @@ public:
     /**
      * Interface for handling logged messages.
      *
-     * The Logger class will not clean up allocated MessageReceivers.
+     * The Logger class will not clean up allocated MessageReceivers. Once
+     * the logger is started they are called from its thread.
      */
     struct MessageReceiver {
         virtual void messageReceived(const LogMessage&) = 0;
     };
 
-    Logger(std::initializer_list<MessageReceiver*> initial = {})
-        : receivers(initial) {
-    }
+    Logger(std::initializer_list<MessageReceiver*> initial = {});
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
 
     void addReceiver(MessageReceiver* out);
     void removeReceiver(MessageReceiver* out);
 
+    /// Start the thread passing messages to the receivers
+    void start();
+
+    /// Pass on the remaining messages and stop the thread
+    void stop();
+
+    /// Pass on the messages logged so far, from any thread
+    void flush();
+
     void log(const std::string& component, Logger::MessageSeverity severity,
              const std::string& message);
 
-    void verbose(const std::string& component, const std::string& message);
-    void info(const std::string& component, const std::string& message);
-    void warning(const std::string& component, const std::string& message);
-    void error(const std::string& component, const std::string& message);
+    void verbose(const std::string& component, const std::string& message) {
+        if constexpr (Verbose >= kMinSeverity) {
+            log(component, Verbose, message);
+        }
+    }
+    void info(const std::string& component, const std::string& message) {
+        if constexpr (Info >= kMinSeverity) {
+            log(component, Info, message);
+        }
+    }
+    void warning(const std::string& component, const std::string& message) {
+        if constexpr (Warning >= kMinSeverity) {
+            log(component, Warning, message);
+        }
+    }
+    void error(const std::string& component, const std::string& message) {
+        log(component, Error, message);
+    }
+
+    /// Number of messages lost because a thread's queue was full
+    size_t getDroppedCount() const {
+        return droppedCount.load(std::memory_order_relaxed);
+    }
+
+    /// Number of repeated messages that weren't passed on
+    size_t getSuppressedCount() const {
+        return suppressedCount.load(std::memory_order_relaxed);
+    }
 
 private:
+    struct Record {
+        std::chrono::system_clock::time_point time{};
+        uint32_t thread = 0;
+        MessageSeverity severity = Verbose;
+        uint16_t componentSize = 0;
+        uint16_t messageSize = 0;
+        bool truncated = false;
+        std::array<char, kRecordTextSize> text;
+    };
+    using RecordQueue = SpscQueue<Record, kQueueSize>;
+
+    struct RepeatedMessage {
+        std::chrono::system_clock::time_point windowStart{};
+        unsigned int count = 0;
+        size_t suppressed = 0;
+        /// Copied once the message is first suppressed
+        MessageSeverity severity = Verbose;
+        std::string component;
+        std::string message;
+    };
+
+    /// The queue of the calling thread, created when it first logs
+    RecordQueue& getThreadQueue();
+    void flushMain();
+
+    /// @name Called with receiverMutex held
+    /// @{
+    void drain();
+    /// Rate limit and pass on the message
+    void dispatch(const LogMessage& message);
+    void send(const LogMessage& message);
+    /// Report the suppressed repeats of messages whose window is over
+    void reportRepeats(std::chrono::system_clock::time_point now, bool all);
+    void reportRepeat(const RepeatedMessage& repeat,
+                      std::chrono::system_clock::time_point now);
+    /// @}
+
+    /// Tells the thread local queues of different loggers apart
+    const uint64_t id;
+
+    std::mutex receiverMutex;
     std::vector<MessageReceiver*> receivers;
+    std::unordered_map<size_t, RepeatedMessage> repeats;
+    std::chrono::system_clock::time_point lastRepeatReport{};
+    LogMessage current{"", Verbose, ""};
+    size_t reportedDropCount = 0;
+
+    std::mutex queueMutex;
+    std::vector<std::unique_ptr<RecordQueue>> queues;
+    /// Copy of queues used while draining, guarded by receiverMutex
+    std::vector<RecordQueue*> drainQueues;
+
+    std::atomic<size_t> droppedCount{0};
+    std::atomic<size_t> suppressedCount{0};
+    std::atomic<bool> running{false};
+    std::thread thread;
 };
 
 class StdOutReceiver final : public Logger::MessageReceiver {
     void messageReceived(const Logger::LogMessage&) override;
 };
 
+/**
+ * Writes messages to a file as JSON lines:
+ * {"time":<ms since epoch>,"thread":0,"severity":"I","component":"",
+ * "message":""}
+ */
+class JsonFileReceiver final : public Logger::MessageReceiver {
+public:
+    explicit JsonFileReceiver(const std::string& path);
+
+    bool isOpen() const {
+        return file.is_open();
+    }
+
+    void messageReceived(const Logger::LogMessage&) override;
+
+private:
+    std::ofstream file;
+};
+
 #endif
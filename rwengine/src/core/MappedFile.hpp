@@ -0,0 +1,51 @@
+#ifndef _RWENGINE_MAPPEDFILE_HPP_
+#define _RWENGINE_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The pages are only read from disk when they are touched, and stay shared
+ * with the file cache of the operating system.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps path, replacing the file mapped before
+     * @return false if the file can't be opened or is empty
+     */
+    bool open(const std::filesystem::path& path);
+
+    void close();
+
+    bool isOpen() const {
+        return mapping != nullptr;
+    }
+
+    const std::uint8_t* data() const {
+        return static_cast<const std::uint8_t*>(mapping);
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+private:
+    void* mapping = nullptr;
+    std::size_t length = 0;
+#ifdef RW_WINDOWS
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+#endif
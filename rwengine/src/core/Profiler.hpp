@@ -12,14 +12,33 @@
 #define RW_TIMELINE_ENTER(name, color) MICROPROFILE_TIMELINE_ENTER_STATIC(color, name)
 #define RW_TIMELINE_LEAVE(name) MICROPROFILE_TIMELINE_LEAVE_STATIC(name)
 #else
-#define RW_PROFILE_THREAD(name) do {} while (0)
-#define RW_PROFILE_FRAME_BOUNDARY() do {} while (0)
-#define RW_PROFILE_SCOPE(label) do {} while (0)
-#define RW_PROFILE_SCOPEC(label, colour)  do {} while (0)
-#define RW_PROFILE_COUNTER_ADD(name, qty) do {} while (0)
-#define RW_PROFILE_COUNTER_SET(name, qty) do {} while (0)
-#define RW_TIMELINE_ENTER(name, color) do {} while (0)
-#define RW_TIMELINE_LEAVE(name) do {} while (0)
+#include <core/TraceRecorder.hpp>
+#define RW_TRACE_CONCAT_(a, b) a##b
+#define RW_TRACE_CONCAT(a, b) RW_TRACE_CONCAT_(a, b)
+#define RW_PROFILE_THREAD(name) TraceRecorder::setThreadName(name)
+#define RW_PROFILE_FRAME_BOUNDARY() TraceRecorder::instant("Frame")
+#define RW_PROFILE_SCOPE(label) \
+    TraceScope RW_TRACE_CONCAT(rwTraceScope, __COUNTER__)(label)
+#define RW_PROFILE_SCOPEC(label, colour) \
+    TraceScope RW_TRACE_CONCAT(rwTraceScope, __COUNTER__)(label)
+#define RW_PROFILE_COUNTER_ADD(name, qty)                                    \
+    do {                                                                     \
+        if (TraceRecorder::isCapturing()) {                                  \
+            TraceRecorder::record(TraceRecorder::EventType::CounterAdd, name, \
+                                  TraceRecorder::now(),                      \
+                                  static_cast<int64_t>(qty));                \
+        }                                                                    \
+    } while (0)
+#define RW_PROFILE_COUNTER_SET(name, qty)                                    \
+    do {                                                                     \
+        if (TraceRecorder::isCapturing()) {                                  \
+            TraceRecorder::record(TraceRecorder::EventType::CounterSet, name, \
+                                  TraceRecorder::now(),                      \
+                                  static_cast<int64_t>(qty));                \
+        }                                                                    \
+    } while (0)
+#define RW_TIMELINE_ENTER(name, color) TraceRecorder::begin(name)
+#define RW_TIMELINE_LEAVE(name) TraceRecorder::end(name)
 #endif
 
 #endif
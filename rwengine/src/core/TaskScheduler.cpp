@@ -0,0 +1,103 @@
+#include "core/TaskScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "core/Profiler.hpp"
+
+TaskScheduler::TaskScheduler(unsigned numWorkers) {
+    threads.reserve(numWorkers);
+    for (auto i = 0u; i < numWorkers; ++i) {
+        threads.emplace_back(&TaskScheduler::workerMain, this);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+unsigned TaskScheduler::getDefaultWorkerCount() {
+    auto hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+void TaskScheduler::push(std::function<void()> job) {
+    if (threads.empty()) {
+        job();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    wakeup.notify_one();
+}
+
+void TaskScheduler::workerMain() {
+    RW_PROFILE_THREAD("Worker");
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void TaskScheduler::parallelFor(int begin, int end, int grainSize,
+                                const std::function<void(int, int)>& body) {
+    if (end <= begin) {
+        return;
+    }
+    grainSize = std::max(grainSize, 1);
+    const int numChunks = (end - begin + grainSize - 1) / grainSize;
+    if (numChunks == 1 || threads.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    // Helpers may only be started after all chunks are taken, so the state
+    // is shared; body is only touched while a chunk is outstanding.
+    struct Loop {
+        std::atomic<int> next{0};
+        std::atomic<int> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto loop = std::make_shared<Loop>();
+    loop->remaining = numChunks;
+
+    auto work = [loop, &body, begin, end, grainSize, numChunks]() {
+        for (int chunk = loop->next++; chunk < numChunks;
+             chunk = loop->next++) {
+            int first = begin + chunk * grainSize;
+            body(first, std::min(first + grainSize, end));
+            if (--loop->remaining == 0) {
+                std::lock_guard<std::mutex> lock(loop->mutex);
+                loop->done.notify_all();
+            }
+        }
+    };
+
+    auto helpers = std::min<int>(numChunks - 1, getWorkerCount());
+    for (int i = 0; i < helpers; ++i) {
+        push(work);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->done.wait(lock, [&]() { return loop->remaining == 0; });
+}
@@ -0,0 +1,75 @@
+#ifndef _RWENGINE_TASKSCHEDULER_HPP_
+#define _RWENGINE_TASKSCHEDULER_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Pool of worker threads shared by the engine
+ *
+ * Supports fire-and-forget jobs through submit() and fork-join loops through
+ * parallelFor(), where the calling thread helps with the work.
+ */
+class TaskScheduler {
+public:
+    /**
+     * @param numWorkers Number of worker threads to start, 0 runs every job
+     * on the calling thread.
+     */
+    explicit TaskScheduler(unsigned numWorkers = getDefaultWorkerCount());
+
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief Number of workers to use: one less than the hardware threads
+     */
+    static unsigned getDefaultWorkerCount();
+
+    unsigned getWorkerCount() const {
+        return static_cast<unsigned>(threads.size());
+    }
+
+    /**
+     * @brief Runs job on a worker thread
+     * @return Future holding the result of job
+     */
+    template <class F>
+    auto submit(F&& job) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<F>(job));
+        auto future = task->get_future();
+        push([task]() { (*task)(); });
+        return future;
+    }
+
+    /**
+     * @brief Calls body for sub-ranges of [begin, end) of at most grainSize
+     * elements, in parallel, and returns once all of them are done.
+     */
+    void parallelFor(int begin, int end, int grainSize,
+                     const std::function<void(int, int)>& body);
+
+private:
+    void push(std::function<void()> job);
+
+    void workerMain();
+
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "core/TimerWheel.hpp"
+
+#include <algorithm>
+
+void TimerWheel::schedule(std::uint32_t id, std::uint64_t time) {
+    ++count;
+    if (time <= current) {
+        due.push_back({id, time});
+        return;
+    }
+    insert({id, time});
+}
+
+void TimerWheel::advance(std::uint64_t now,
+                         std::vector<std::uint32_t>& expired) {
+    if (!due.empty()) {
+        std::stable_sort(due.begin(), due.end(),
+                         [](const Timer& a, const Timer& b) {
+                             return a.time < b.time;
+                         });
+        for (const auto& timer : due) {
+            expired.push_back(timer.id);
+        }
+        count -= due.size();
+        due.clear();
+    }
+
+    constexpr std::uint64_t kSlotMask = kSlots - 1;
+    constexpr std::uint64_t kWheelMask = (1ull << (kSlotBits * kLevels)) - 1;
+    while (current < now) {
+        if (count == 0) {
+            current = now;
+            break;
+        }
+        ++current;
+
+        if ((current & kWheelMask) == 0) {
+            cascade(overflow);
+        }
+        for (unsigned level = kLevels - 1; level > 0; --level) {
+            const auto shift = kSlotBits * level;
+            if ((current & ((1ull << shift) - 1)) == 0) {
+                cascade(levels[level][(current >> shift) & kSlotMask]);
+            }
+        }
+
+        auto& slot = levels[0][current & kSlotMask];
+        for (const auto& timer : slot) {
+            expired.push_back(timer.id);
+        }
+        count -= slot.size();
+        slot.clear();
+    }
+}
+
+void TimerWheel::remap(const std::function<bool(std::uint32_t&)>& remap) {
+    auto remapSlot = [&](Slot& slot) {
+        auto end = std::remove_if(slot.begin(), slot.end(), [&](Timer& t) {
+            return !remap(t.id);
+        });
+        count -= static_cast<std::size_t>(slot.end() - end);
+        slot.erase(end, slot.end());
+    };
+    for (auto& level : levels) {
+        for (auto& slot : level) {
+            remapSlot(slot);
+        }
+    }
+    remapSlot(overflow);
+    remapSlot(due);
+}
+
+void TimerWheel::clear() {
+    for (auto& level : levels) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    overflow.clear();
+    due.clear();
+    count = 0;
+}
+
+void TimerWheel::insert(const Timer& timer) {
+    // The timer goes in the lowest level where it shares the enclosing slot
+    // of the next level with the current time, so that it is cascaded or
+    // expired before the wheel passes it.
+    for (unsigned level = 0; level < kLevels; ++level) {
+        const auto shift = kSlotBits * (level + 1);
+        if ((timer.time >> shift) == (current >> shift)) {
+            const auto slot = (timer.time >> (kSlotBits * level)) & (kSlots - 1);
+            levels[level][slot].push_back(timer);
+            return;
+        }
+    }
+    overflow.push_back(timer);
+}
+
+void TimerWheel::cascade(Slot& slot) {
+    if (slot.empty()) {
+        return;
+    }
+    Slot timers;
+    timers.swap(slot);
+    for (const auto& timer : timers) {
+        insert(timer);
+    }
+}
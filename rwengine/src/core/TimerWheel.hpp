@@ -0,0 +1,74 @@
+#ifndef _RWENGINE_TIMERWHEEL_HPP_
+#define _RWENGINE_TIMERWHEEL_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Hierarchical timer wheel with millisecond resolution
+ *
+ * Timers are kept in slots by their expiry time. The first level has one
+ * slot per millisecond, each following level covers 64 times the span of the
+ * previous one. Timers move down a level as their time gets closer, so
+ * advancing only touches the slots that are due instead of every timer.
+ */
+class TimerWheel {
+public:
+    explicit TimerWheel(std::uint64_t now = 0) : current(now) {
+    }
+
+    /**
+     * @brief Adds a timer that expires once the wheel reaches time
+     */
+    void schedule(std::uint32_t id, std::uint64_t time);
+
+    /**
+     * @brief Moves the wheel forward to now
+     * @param expired Receives the ids of the timers that are due, in order of
+     * their expiry time
+     */
+    void advance(std::uint64_t now, std::vector<std::uint32_t>& expired);
+
+    /**
+     * @brief Changes the id of every timer, timers for which remap returns
+     * false are removed.
+     */
+    void remap(const std::function<bool(std::uint32_t&)>& remap);
+
+    void clear();
+
+    std::uint64_t getTime() const {
+        return current;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+private:
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr unsigned kSlots = 1u << kSlotBits;
+    static constexpr unsigned kLevels = 4;
+
+    struct Timer {
+        std::uint32_t id;
+        std::uint64_t time;
+    };
+    using Slot = std::vector<Timer>;
+
+    void insert(const Timer& timer);
+    void cascade(Slot& slot);
+
+    std::array<std::array<Slot, kSlots>, kLevels> levels;
+    /// Timers further away than the last level covers
+    Slot overflow;
+    /// Timers scheduled in the past, returned by the next advance
+    Slot due;
+    std::uint64_t current;
+    std::size_t count = 0;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "core/TraceRecorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::capturing{false};
+
+namespace {
+struct ThreadBuffer {
+    /// Allocated when the thread first records
+    std::vector<TraceRecorder::Event> events;
+    /// Number of events recorded since the capture started
+    std::atomic<uint64_t> head{0};
+    /// Set while the thread records an event
+    std::atomic<bool> busy{false};
+    std::string name;
+    uint32_t thread = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    /// steady_clock time the capture started, in nanoseconds
+    std::atomic<int64_t> start{0};
+};
+
+int64_t getClockTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+Registry& getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer& getThreadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = registry.buffers.back().get();
+        buffer->thread = static_cast<uint32_t>(registry.buffers.size() - 1);
+    }
+    return *buffer;
+}
+
+void writeJsonString(std::ostream& out, const char* string) {
+    out << '"';
+    for (; *string; ++string) {
+        const auto c = *string;
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+void writeTime(std::ostream& out, const char* key, int64_t nanoseconds) {
+    // Scopes that began in an earlier capture can end up before the start
+    nanoseconds = std::max<int64_t>(nanoseconds, 0);
+    // Trace times are in microseconds
+    out << ",\"" << key << "\":" << nanoseconds / 1000 << '.'
+        << (nanoseconds % 1000) / 100;
+}
+
+struct ExportedEvent {
+    TraceRecorder::Event event;
+    uint32_t thread;
+};
+}  // namespace
+
+void TraceRecorder::start() {
+    auto& registry = getRegistry();
+    stop();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& buffer : registry.buffers) {
+        buffer->head.store(0, std::memory_order_relaxed);
+    }
+    registry.start.store(getClockTime());
+    capturing.store(true);
+}
+
+void TraceRecorder::stop() {
+    capturing.store(false);
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& buffer : registry.buffers) {
+        while (buffer->busy.load()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int64_t TraceRecorder::now() {
+    return getClockTime() -
+           getRegistry().start.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::record(EventType type, const char* name, int64_t time,
+                           int64_t value) {
+    auto& buffer = getThreadBuffer();
+    // stop() waits while busy is set, so it never misses an event that's
+    // being written
+    buffer.busy.store(true);
+    if (capturing.load()) {
+        if (buffer.events.empty()) {
+            buffer.events.resize(kBufferSize);
+        }
+        const auto head = buffer.head.load(std::memory_order_relaxed);
+        buffer.events[head % kBufferSize] = {name, time, value, type};
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+    buffer.busy.store(false, std::memory_order_release);
+}
+
+void TraceRecorder::setThreadName(const char* name) {
+    auto& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(getRegistry().mutex);
+    buffer.name = name;
+}
+
+size_t TraceRecorder::getEventCount() {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    size_t count = 0;
+    for (const auto& buffer : registry.buffers) {
+        count += std::min<size_t>(buffer->head.load(std::memory_order_acquire),
+                                  kBufferSize);
+    }
+    return count;
+}
+
+size_t TraceRecorder::getThreadEventCount() {
+    const auto& buffer = getThreadBuffer();
+    return std::min<size_t>(buffer.head.load(std::memory_order_acquire),
+                            kBufferSize);
+}
+
+void TraceRecorder::write(std::ostream& out) {
+    stop();
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto beginEvent = [&](const char* name, const char* phase,
+                          uint32_t thread) {
+        out << (first ? "\n" : ",\n") << "{\"name\":";
+        first = false;
+        writeJsonString(out, name);
+        out << ",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << thread;
+    };
+
+    std::vector<ExportedEvent> counters;
+    for (const auto& buffer : registry.buffers) {
+        if (!buffer->name.empty()) {
+            beginEvent("thread_name", "M", buffer->thread);
+            out << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->name.c_str());
+            out << "}}";
+        }
+
+        const auto head = buffer->head.load(std::memory_order_acquire);
+        const auto count = std::min<uint64_t>(head, kBufferSize);
+        for (auto i = head - count; i < head; ++i) {
+            const auto& event = buffer->events[i % kBufferSize];
+            switch (event.type) {
+                case EventType::Complete:
+                    beginEvent(event.name, "X", buffer->thread);
+                    writeTime(out, "ts", event.time);
+                    writeTime(out, "dur", event.value);
+                    out << '}';
+                    break;
+                case EventType::Begin:
+                case EventType::End:
+                    beginEvent(event.name,
+                               event.type == EventType::Begin ? "B" : "E",
+                               buffer->thread);
+                    writeTime(out, "ts", event.time);
+                    out << '}';
+                    break;
+                case EventType::Instant:
+                    beginEvent(event.name, "i", buffer->thread);
+                    writeTime(out, "ts", event.time);
+                    out << ",\"s\":\"g\"}";
+                    break;
+                case EventType::CounterAdd:
+                case EventType::CounterSet:
+                    counters.push_back({event, buffer->thread});
+                    break;
+            }
+        }
+    }
+
+    // Counters are shared by the threads, and added to in time order
+    std::stable_sort(counters.begin(), counters.end(),
+                     [](const ExportedEvent& a, const ExportedEvent& b) {
+                         return a.event.time < b.event.time;
+                     });
+    std::map<std::string, int64_t> values;
+    for (const auto& counter : counters) {
+        auto& value = values[counter.event.name];
+        if (counter.event.type == EventType::CounterAdd) {
+            value += counter.event.value;
+        } else {
+            value = counter.event.value;
+        }
+        beginEvent(counter.event.name, "C", counter.thread);
+        writeTime(out, "ts", counter.event.time);
+        out << ",\"args\":{\"value\":" << value << "}}";
+    }
+
+    out << "\n]}\n";
+}
+
+bool TraceRecorder::save(const std::string& path) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    write(file);
+    return static_cast<bool>(file);
+}
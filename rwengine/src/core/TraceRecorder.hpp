@@ -0,0 +1,122 @@
+#ifndef _RWENGINE_TRACERECORDER_HPP_
+#define _RWENGINE_TRACERECORDER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Records profiling scopes and counters while capturing
+ *
+ * This backs the RW_PROFILE_* macros when microprofile isn't built in.
+ * Each thread writes its events to its own ring buffer, which keeps the
+ * latest kBufferSize events, so there's no locking while capturing. When
+ * not capturing, recording costs a relaxed atomic load.
+ *
+ * Names have to outlive the capture, string literals and __func__ do.
+ * The capture is written as Chrome trace events, which chrome://tracing
+ * and the Perfetto UI open.
+ */
+class TraceRecorder {
+public:
+    /// Events kept per thread
+    static constexpr size_t kBufferSize = 1 << 15;
+
+    enum class EventType : uint8_t {
+        /// A scope, value holds its duration
+        Complete,
+        Begin,
+        End,
+        CounterAdd,
+        CounterSet,
+        Instant
+    };
+
+    struct Event {
+        const char* name;
+        /// Nanoseconds since the capture started
+        int64_t time;
+        int64_t value;
+        EventType type;
+    };
+
+    static bool isCapturing() {
+        return capturing.load(std::memory_order_relaxed);
+    }
+
+    /// Discard the previous capture and start a new one
+    static void start();
+
+    /// Stop capturing, waits for events that are being recorded
+    static void stop();
+
+    /// Stop capturing and write the capture as Chrome trace JSON
+    static void write(std::ostream& out);
+    static bool save(const std::string& path);
+
+    /// Name the calling thread in the trace
+    static void setThreadName(const char* name);
+
+    /// Number of events kept from the current or last capture
+    static size_t getEventCount();
+
+    /// Number of events the calling thread kept from the current or last
+    /// capture
+    static size_t getThreadEventCount();
+
+    /// Nanoseconds since the capture started
+    static int64_t now();
+
+    static void record(EventType type, const char* name, int64_t time,
+                       int64_t value);
+
+    static void begin(const char* name) {
+        if (isCapturing()) {
+            record(EventType::Begin, name, now(), 0);
+        }
+    }
+
+    static void end(const char* name) {
+        if (isCapturing()) {
+            record(EventType::End, name, now(), 0);
+        }
+    }
+
+    static void instant(const char* name) {
+        if (isCapturing()) {
+            record(EventType::Instant, name, now(), 0);
+        }
+    }
+
+private:
+    static std::atomic<bool> capturing;
+};
+
+/**
+ * Records the time between its construction and destruction
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name(name), start(TraceRecorder::isCapturing() ? TraceRecorder::now()
+                                                         : -1) {
+    }
+
+    ~TraceScope() {
+        if (start >= 0 && TraceRecorder::isCapturing()) {
+            TraceRecorder::record(TraceRecorder::EventType::Complete, name,
+                                  start, TraceRecorder::now() - start);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    int64_t start;
+};
+
+#endif
@@ -4,9 +4,12 @@
 #include <glm/vec3.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+class CollisionShape;
+
 /**
  * @class CollisionModel
  * Collision shapes data container.
@@ -48,6 +51,9 @@ struct CollisionModel {
     std::vector<Box> boxes;
     std::vector<glm::vec3> vertices;
     std::vector<Triangle> faces;
+
+    /// Physics shapes built from this model, shared by all instances
+    std::shared_ptr<CollisionShape> shape;
 };
 
 #endif
@@ -0,0 +1,41 @@
+#include "dynamics/BulletTaskScheduler.hpp"
+
+#include <mutex>
+
+#include "core/TaskScheduler.hpp"
+
+BulletTaskScheduler::BulletTaskScheduler(TaskScheduler& tasks)
+    : btITaskScheduler("OpenRW"), tasks(tasks) {
+}
+
+int BulletTaskScheduler::getMaxNumThreads() const {
+    return static_cast<int>(tasks.getWorkerCount()) + 1;
+}
+
+int BulletTaskScheduler::getNumThreads() const {
+    return getMaxNumThreads();
+}
+
+void BulletTaskScheduler::setNumThreads(int) {
+    // The worker count is fixed by the TaskScheduler
+}
+
+void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize,
+                                      const btIParallelForBody& body) {
+    tasks.parallelFor(iBegin, iEnd, grainSize,
+                      [&](int first, int last) { body.forLoop(first, last); });
+}
+
+#if BT_BULLET_VERSION >= 288
+btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize,
+                                          const btIParallelSumBody& body) {
+    std::mutex mutex;
+    btScalar sum = 0;
+    tasks.parallelFor(iBegin, iEnd, grainSize, [&](int first, int last) {
+        auto partial = body.sumLoop(first, last);
+        std::lock_guard<std::mutex> lock(mutex);
+        sum += partial;
+    });
+    return sum;
+}
+#endif
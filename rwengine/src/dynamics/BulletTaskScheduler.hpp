@@ -0,0 +1,40 @@
+#ifndef _RWENGINE_BULLETTASKSCHEDULER_HPP_
+#define _RWENGINE_BULLETTASKSCHEDULER_HPP_
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <LinearMath/btThreads.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+class TaskScheduler;
+
+/**
+ * @brief Runs Bullet's parallel loops on the engine's TaskScheduler
+ *
+ * Bullet only makes use of this when it has been built with BT_THREADSAFE,
+ * otherwise the multithreaded world runs its loops sequentially.
+ */
+class BulletTaskScheduler final : public btITaskScheduler {
+public:
+    explicit BulletTaskScheduler(TaskScheduler& tasks);
+
+    int getMaxNumThreads() const override;
+    int getNumThreads() const override;
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize,
+                     const btIParallelForBody& body) override;
+
+#if BT_BULLET_VERSION >= 288
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize,
+                         const btIParallelSumBody& body) override;
+#endif
+
+private:
+    TaskScheduler& tasks;
+};
+
+#endif
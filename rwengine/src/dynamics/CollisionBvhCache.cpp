@@ -0,0 +1,160 @@
+#include "dynamics/CollisionBvhCache.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <LinearMath/btScalar.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+#include "data/CollisionModel.hpp"
+
+namespace {
+constexpr uint32_t kBvhCacheMagic = 0x56425752;  // RWBV
+constexpr uint32_t kBvhCacheVersion = 2;
+
+struct BvhCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bulletVersion;
+    uint32_t pointerSize;
+    uint32_t count;
+};
+
+template <class T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(
+        in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <class T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+uint64_t hashGeometry(const CollisionModel& model) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&](const void* data, size_t size) {
+        auto bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    for (const auto& vertex : model.vertices) {
+        add(&vertex.x, sizeof(float) * 3);
+    }
+    for (const auto& face : model.faces) {
+        add(face.tri, sizeof(face.tri));
+    }
+    return hash;
+}
+
+BvhCacheHeader expectedHeader(uint32_t count) {
+    return {kBvhCacheMagic, kBvhCacheVersion, BT_BULLET_VERSION,
+            static_cast<uint32_t>(sizeof(void*)), count};
+}
+}  // namespace
+
+bool CollisionBvhCache::load(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios_base::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    BvhCacheHeader header;
+    if (!readValue(file, header)) {
+        return false;
+    }
+    auto expected = expectedHeader(header.count);
+    if (std::memcmp(&header, &expected, sizeof(header)) != 0) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.count; ++i) {
+        uint32_t nameLength;
+        if (!readValue(file, nameLength)) {
+            return false;
+        }
+        std::string name(nameLength, '\0');
+        Entry entry;
+        if (!file.read(&name[0], nameLength) ||
+            !readValue(file, entry.geometryHash) ||
+            !readValue(file, entry.size)) {
+            return false;
+        }
+        entry.data.resize((entry.size + sizeof(Block) - 1) / sizeof(Block));
+        if (!file.read(reinterpret_cast<char*>(entry.data.data()),
+                       entry.size)) {
+            return false;
+        }
+        entries[name] = std::move(entry);
+    }
+
+    dirty = false;
+    return true;
+}
+
+bool CollisionBvhCache::save(const std::filesystem::path& path) {
+    std::ofstream file(path, std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    writeValue(file, expectedHeader(static_cast<uint32_t>(entries.size())));
+    for (const auto& [name, entry] : entries) {
+        writeValue(file, static_cast<uint32_t>(name.size()));
+        file.write(name.data(), static_cast<std::streamsize>(name.size()));
+        writeValue(file, entry.geometryHash);
+        writeValue(file, entry.size);
+        file.write(reinterpret_cast<const char*>(entry.data.data()),
+                   entry.size);
+    }
+
+    if (!file) {
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+btOptimizedBvh* CollisionBvhCache::find(const CollisionModel& model) {
+    auto it = entries.find(model.name);
+    if (it == entries.end()) {
+        return nullptr;
+    }
+
+    // Edited models keep their name, but need a new BVH
+    auto& entry = it->second;
+    if (entry.geometryHash != hashGeometry(model)) {
+        return nullptr;
+    }
+
+    if (!entry.live.empty()) {
+        return reinterpret_cast<btOptimizedBvh*>(entry.live.data());
+    }
+
+    // Deserializing patches the buffer, keep the original intact for saving
+    entry.live = entry.data;
+    return btOptimizedBvh::deSerializeInPlace(entry.live.data(), entry.size,
+                                              false);
+}
+
+void CollisionBvhCache::store(const CollisionModel& model,
+                              btOptimizedBvh& bvh) {
+    Entry entry;
+    entry.geometryHash = hashGeometry(model);
+    entry.size = bvh.calculateSerializeBufferSize();
+    entry.data.resize((entry.size + sizeof(Block) - 1) / sizeof(Block));
+    if (!bvh.serializeInPlace(entry.data.data(), entry.size, false)) {
+        return;
+    }
+
+    entries[model.name] = std::move(entry);
+    dirty = true;
+}
@@ -0,0 +1,78 @@
+#ifndef _RWENGINE_COLLISIONBVHCACHE_HPP_
+#define _RWENGINE_COLLISIONBVHCACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class btOptimizedBvh;
+struct CollisionModel;
+
+/**
+ * @brief Stores serialized triangle mesh BVHs so that they don't need to be
+ * rebuilt every time the game starts.
+ *
+ * Entries are keyed by the collision model's name and validated against a
+ * hash of its vertices and faces. The file is only valid for the Bullet
+ * version and pointer size that wrote it.
+ */
+class CollisionBvhCache {
+public:
+    /**
+     * @brief Reads previously saved entries from path
+     * @return false if the file is missing or incompatible
+     */
+    bool load(const std::filesystem::path& path);
+
+    /**
+     * @brief Writes all entries to path
+     */
+    bool save(const std::filesystem::path& path);
+
+    /**
+     * @brief Returns the cached BVH for the model, or nullptr.
+     *
+     * The returned BVH is owned by the cache.
+     */
+    btOptimizedBvh* find(const CollisionModel& model);
+
+    /**
+     * @brief Serializes the BVH built for model into the cache
+     */
+    void store(const CollisionModel& model, btOptimizedBvh& bvh);
+
+    /**
+     * @brief Returns true if entries were added since the last load or save
+     */
+    bool isDirty() const {
+        return dirty;
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+private:
+    /// Bullet requires serialized BVHs to be 16 byte aligned
+    struct alignas(16) Block {
+        uint8_t bytes[16];
+    };
+
+    struct Entry {
+        /// Hash of the model's vertices and faces
+        uint64_t geometryHash;
+        uint32_t size;
+        /// Serialized BVH, as written to disk
+        std::vector<Block> data;
+        /// Deserialized copy, pointed to by the BVH returned from find()
+        std::vector<Block> live;
+    };
+
+    std::unordered_map<std::string, Entry> entries;
+    bool dirty = false;
+};
+
+#endif
@@ -1,9 +1,5 @@
 #include "dynamics/CollisionInstance.hpp"
 
-#include <algorithm>
-#include <cstddef>
-#include <limits>
-
 #ifdef _MSC_VER
 #pragma warning(disable : 4305)
 #endif
@@ -13,10 +9,13 @@
 #endif
 
 #include <glm/glm.hpp>
+#include <glm/gtc/epsilon.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 #include "data/CollisionModel.hpp"
 #include "data/ModelData.hpp"
+#include "dynamics/CollisionShape.hpp"
+#include "engine/GameData.hpp"
 #include "engine/GameWorld.hpp"
 #include "objects/GameObject.hpp"
 #include "objects/VehicleInfo.hpp"
@@ -47,67 +46,21 @@ CollisionInstance::~CollisionInstance() {
 bool CollisionInstance::createPhysicsBody(GameObject* object,
                                           CollisionModel* collision,
                                           DynamicObjectData* dynamics,
-                                          VehicleHandlingInfo* handling) {
-    cmpShape = std::make_unique<btCompoundShape>();
+                                          VehicleHandlingInfo* handling,
+                                          const glm::vec3& scale) {
+    m_shape = CollisionShape::get(*collision, &object->engine->data->bvhCache);
+
+    btCompoundShape* cmpShape = m_shape->getShape();
+    if (glm::any(glm::epsilonNotEqual(scale, glm::vec3(1.f), 0.001f))) {
+        m_scaledShape = m_shape->createScaled(scale, m_scaledChildren);
+        cmpShape = m_scaledShape.get();
+    }
 
     m_motionState = std::make_unique<GameObjectMotionState>(object);
     btRigidBody::btRigidBodyConstructionInfo info(0.f, m_motionState.get(),
-                                                  cmpShape.get());
-
-    float colMin = std::numeric_limits<float>::max(),
-          colMax = std::numeric_limits<float>::lowest();
-
-    btTransform t;
-    t.setIdentity();
-
-    // Boxes
-    for (const auto &box : collision->boxes) {
-        auto size = (box.max - box.min) / 2.f;
-        auto mid = (box.min + box.max) / 2.f;
-        auto bshape = std::make_unique<btBoxShape>(
-            btVector3(size.x, size.y, size.z));
-        t.setOrigin(btVector3(mid.x, mid.y, mid.z));
-        cmpShape->addChildShape(t, bshape.get());
-
-        colMin = std::min(colMin, mid.z - size.z);
-        colMax = std::max(colMax, mid.z + size.z);
-
-        m_shapes.push_back(std::move(bshape));
-    }
-
-    // Spheres
-    for (const auto &sphere : collision->spheres) {
-        auto sshape = std::make_unique<btSphereShape>(sphere.radius);
-        t.setOrigin(
-            btVector3(sphere.center.x, sphere.center.y, sphere.center.z));
-        cmpShape->addChildShape(t, sshape.get());
-
-        colMin = std::min(colMin, sphere.center.z - sphere.radius);
-        colMax = std::max(colMax, sphere.center.z + sphere.radius);
-
-        m_shapes.push_back(std::move(sshape));
-    }
-
-    t.setIdentity();
-    auto& verts = collision->vertices;
-    auto& faces = collision->faces;
-    if (!verts.empty() && !faces.empty()) {
-        m_vertArray = std::make_unique<btTriangleIndexVertexArray>(
-            static_cast<int>(faces.size()),
-            reinterpret_cast<int*>(faces.data()),
-            static_cast<int>(sizeof(CollisionModel::Triangle)),
-            static_cast<int>(verts.size()),
-            reinterpret_cast<float*>(verts.data()),
-            static_cast<int>(sizeof(glm::vec3)));
-        auto trishape =
-            std::make_unique<btBvhTriangleMeshShape>(m_vertArray.get(), false);
-        trishape->setMargin(0.05f);
-        cmpShape->addChildShape(t, trishape.get());
-
-        m_shapes.push_back(std::move(trishape));
-    }
+                                                  cmpShape);
 
-    m_collisionHeight = colMax - colMin;
+    m_collisionHeight = m_shape->getBoundingHeight() * scale.z;
 
     if (dynamics) {
         if (dynamics->uprootForce > 0.f) {
@@ -6,9 +6,11 @@
 
 #include <btBulletDynamicsCommon.h>
 
+#include <glm/vec3.hpp>
+
 class btCollisionShape;
 class btCompoundShape;
-class btTriangleIndexVertexArray;
+class CollisionShape;
 struct CollisionModel;
 
 class GameObject;
@@ -30,6 +32,9 @@ private:
 
 /**
  * @brief CollisionInstance stores bullet body information
+ *
+ * The collision shapes are shared with other instances of the same model,
+ * see CollisionShape.
  */
 class CollisionInstance {
 public:
@@ -39,7 +44,8 @@ public:
 
     bool createPhysicsBody(GameObject* object, CollisionModel* collision,
                            DynamicObjectData* dynamics = nullptr,
-                           VehicleHandlingInfo* handling = nullptr);
+                           VehicleHandlingInfo* handling = nullptr,
+                           const glm::vec3& scale = glm::vec3(1.f));
 
     btRigidBody* getBulletBody() const {
         return m_body.get();
@@ -54,9 +60,11 @@ public:
 private:
     std::unique_ptr<btRigidBody> m_body;
 
-    std::unique_ptr<btCompoundShape> cmpShape;
-    std::vector<std::unique_ptr<btCollisionShape>> m_shapes;
-    std::unique_ptr<btTriangleIndexVertexArray> m_vertArray;
+    std::shared_ptr<CollisionShape> m_shape;
+
+    /// Instance specific shapes, only used for scaled instances
+    std::unique_ptr<btCompoundShape> m_scaledShape;
+    std::vector<std::unique_ptr<btCollisionShape>> m_scaledChildren;
 
     std::unique_ptr<btMotionState> m_motionState;
 
@@ -0,0 +1,165 @@
+#include "dynamics/CollisionShape.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+#include <glm/glm.hpp>
+
+#include "data/CollisionModel.hpp"
+#include "dynamics/CollisionBvhCache.hpp"
+
+size_t CollisionShape::shapeCount = 0;
+size_t CollisionShape::shapeBytes = 0;
+size_t CollisionShape::bvhBytes = 0;
+
+CollisionShape::CollisionShape(CollisionModel& model,
+                               CollisionBvhCache* cache)
+    : m_compound(std::make_unique<btCompoundShape>()) {
+    float colMin = std::numeric_limits<float>::max(),
+          colMax = std::numeric_limits<float>::lowest();
+
+    btTransform t;
+    t.setIdentity();
+
+    // Boxes
+    for (const auto& box : model.boxes) {
+        auto size = (box.max - box.min) / 2.f;
+        auto mid = (box.min + box.max) / 2.f;
+        auto bshape =
+            std::make_unique<btBoxShape>(btVector3(size.x, size.y, size.z));
+        t.setOrigin(btVector3(mid.x, mid.y, mid.z));
+        m_compound->addChildShape(t, bshape.get());
+
+        colMin = std::min(colMin, mid.z - size.z);
+        colMax = std::max(colMax, mid.z + size.z);
+
+        m_shapes.push_back(std::move(bshape));
+    }
+
+    // Spheres
+    for (const auto& sphere : model.spheres) {
+        auto sshape = std::make_unique<btSphereShape>(sphere.radius);
+        t.setOrigin(
+            btVector3(sphere.center.x, sphere.center.y, sphere.center.z));
+        m_compound->addChildShape(t, sshape.get());
+
+        colMin = std::min(colMin, sphere.center.z - sphere.radius);
+        colMax = std::max(colMax, sphere.center.z + sphere.radius);
+
+        m_shapes.push_back(std::move(sshape));
+    }
+
+    t.setIdentity();
+    auto& verts = model.vertices;
+    auto& faces = model.faces;
+    if (!verts.empty() && !faces.empty()) {
+        m_vertArray = std::make_unique<btTriangleIndexVertexArray>(
+            static_cast<int>(faces.size()),
+            reinterpret_cast<int*>(faces.data()),
+            static_cast<int>(sizeof(CollisionModel::Triangle)),
+            static_cast<int>(verts.size()),
+            reinterpret_cast<float*>(verts.data()),
+            static_cast<int>(sizeof(glm::vec3)));
+
+        auto bvh = cache ? cache->find(model) : nullptr;
+        std::unique_ptr<btBvhTriangleMeshShape> trishape;
+        if (bvh) {
+            trishape = std::make_unique<btBvhTriangleMeshShape>(
+                m_vertArray.get(), true, false);
+            trishape->setOptimizedBvh(bvh);
+        } else {
+            trishape = std::make_unique<btBvhTriangleMeshShape>(
+                m_vertArray.get(), true);
+            if (cache) {
+                cache->store(model, *trishape->getOptimizedBvh());
+            }
+        }
+        trishape->setMargin(0.05f);
+        m_compound->addChildShape(t, trishape.get());
+
+        m_triangles = trishape.get();
+        m_shapes.push_back(std::move(trishape));
+    }
+
+    m_collisionHeight = colMax - colMin;
+
+    // Bullet's own allocations aren't tracked, so count the objects
+    m_shapeBytes =
+        sizeof(btCompoundShape) +
+        m_compound->getNumChildShapes() * sizeof(btCompoundShapeChild) +
+        model.boxes.size() * sizeof(btBoxShape) +
+        model.spheres.size() * sizeof(btSphereShape);
+    if (m_triangles) {
+        m_shapeBytes +=
+            sizeof(btBvhTriangleMeshShape) + sizeof(btTriangleIndexVertexArray);
+        // Cached BVHs are held by the cache, but used all the same
+        m_bvhBytes =
+            m_triangles->getOptimizedBvh()->calculateSerializeBufferSize();
+    }
+
+    shapeCount++;
+    shapeBytes += m_shapeBytes;
+    bvhBytes += m_bvhBytes;
+}
+
+CollisionShape::~CollisionShape() {
+    shapeCount--;
+    shapeBytes -= m_shapeBytes;
+    bvhBytes -= m_bvhBytes;
+}
+
+std::shared_ptr<CollisionShape> CollisionShape::get(CollisionModel& model,
+                                                    CollisionBvhCache* cache) {
+    if (!model.shape) {
+        model.shape = std::make_shared<CollisionShape>(model, cache);
+    }
+    return model.shape;
+}
+
+std::unique_ptr<btCompoundShape> CollisionShape::createScaled(
+    const glm::vec3& scale,
+    std::vector<std::unique_ptr<btCollisionShape>>& children) const {
+    auto compound = std::make_unique<btCompoundShape>();
+    btVector3 btScale(scale.x, scale.y, scale.z);
+    float maxScale = std::max(scale.x, std::max(scale.y, scale.z));
+
+    for (int i = 0; i < m_compound->getNumChildShapes(); ++i) {
+        auto t = m_compound->getChildTransform(i);
+        t.setOrigin(t.getOrigin() * btScale);
+
+        auto child = m_compound->getChildShape(i);
+        std::unique_ptr<btCollisionShape> scaled;
+        switch (child->getShapeType()) {
+            case BOX_SHAPE_PROXYTYPE: {
+                auto box = static_cast<btBoxShape*>(child);
+                scaled = std::make_unique<btBoxShape>(
+                    box->getHalfExtentsWithoutMargin() * btScale);
+            } break;
+            case SPHERE_SHAPE_PROXYTYPE: {
+                auto sphere = static_cast<btSphereShape*>(child);
+                scaled = std::make_unique<btSphereShape>(sphere->getRadius() *
+                                                         maxScale);
+            } break;
+            case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+                scaled = std::make_unique<btScaledBvhTriangleMeshShape>(
+                    m_triangles, btScale);
+                break;
+            default:
+                continue;
+        }
+
+        compound->addChildShape(t, scaled.get());
+        children.push_back(std::move(scaled));
+    }
+
+    return compound;
+}
@@ -0,0 +1,87 @@
+#ifndef _RWENGINE_COLLISIONSHAPE_HPP_
+#define _RWENGINE_COLLISIONSHAPE_HPP_
+
+#include <memory>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+class btBvhTriangleMeshShape;
+class btCollisionShape;
+class btCompoundShape;
+class btTriangleIndexVertexArray;
+class CollisionBvhCache;
+struct CollisionModel;
+
+/**
+ * @brief Bullet shapes built from a CollisionModel
+ *
+ * The shapes (and the triangle BVH in particular) are built once per model
+ * and shared by every CollisionInstance using it, see CollisionShape::get.
+ * The model must outlive the shape, as the triangle mesh references the
+ * model's vertex and face data.
+ */
+class CollisionShape {
+public:
+    explicit CollisionShape(CollisionModel& model,
+                            CollisionBvhCache* cache = nullptr);
+
+    ~CollisionShape();
+
+    /**
+     * @brief Returns the shared shape for the model, building it if needed
+     * @param cache Optional cache used to avoid rebuilding the BVH
+     */
+    static std::shared_ptr<CollisionShape> get(
+        CollisionModel& model, CollisionBvhCache* cache = nullptr);
+
+    btCompoundShape* getShape() const {
+        return m_compound.get();
+    }
+
+    /**
+     * @brief Creates a compound shape for an instance with non-unit scale.
+     *
+     * The triangle mesh is referenced through btScaledBvhTriangleMeshShape
+     * so its BVH is not rebuilt, the child shapes are created in @p children.
+     */
+    std::unique_ptr<btCompoundShape> createScaled(
+        const glm::vec3& scale,
+        std::vector<std::unique_ptr<btCollisionShape>>& children) const;
+
+    float getBoundingHeight() const {
+        return m_collisionHeight;
+    }
+
+    /// Number of models that currently have a shape built
+    static size_t getShapeCount() {
+        return shapeCount;
+    }
+
+    /// Approximate bytes held by the Bullet shapes of all built models,
+    /// without their triangle BVHs
+    static size_t getShapeBytes() {
+        return shapeBytes;
+    }
+
+    /// Bytes held by the triangle BVHs of all built models
+    static size_t getBvhBytes() {
+        return bvhBytes;
+    }
+
+private:
+    std::unique_ptr<btCompoundShape> m_compound;
+    std::vector<std::unique_ptr<btCollisionShape>> m_shapes;
+    std::unique_ptr<btTriangleIndexVertexArray> m_vertArray;
+    btBvhTriangleMeshShape* m_triangles = nullptr;
+
+    float m_collisionHeight{0.f};
+    size_t m_shapeBytes = 0;
+    size_t m_bvhBytes = 0;
+
+    static size_t shapeCount;
+    static size_t shapeBytes;
+    static size_t bvhBytes;
+};
+
+#endif
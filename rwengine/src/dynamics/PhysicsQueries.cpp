@@ -0,0 +1,206 @@
+#include "dynamics/PhysicsQueries.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <btBulletDynamicsCommon.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+#include "core/Profiler.hpp"
+#include "core/TaskScheduler.hpp"
+
+namespace {
+constexpr int kQueryGrainSize = 64;
+constexpr float kLocalityCellSize = 16.f;
+
+btVector3 toBullet(const glm::vec3& v) {
+    return {v.x, v.y, v.z};
+}
+
+/// Interleaves the bits of the cell coordinates, so that sorting by the
+/// key keeps nearby queries together
+uint32_t localityKey(const glm::vec3& position) {
+    auto spread = [](float coord) {
+        auto v = static_cast<uint32_t>(
+                     static_cast<int32_t>(coord / kLocalityCellSize) + 0x8000) &
+                 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    return spread(position.x) | (spread(position.y) << 1);
+}
+
+/// Tests a ray against the collision objects in a broadphase tree leaf,
+/// like btCollisionWorld::rayTest but re-entrant
+struct RayCollider : btDbvt::ICollide {
+    const btCollisionObject* ignore;
+    btTransform from;
+    btTransform to;
+    btCollisionWorld::RayResultCallback& callback;
+
+    RayCollider(const btCollisionObject* ignore, const btVector3& rayFrom,
+                const btVector3& rayTo,
+                btCollisionWorld::RayResultCallback& callback)
+        : ignore(ignore), callback(callback) {
+        from.setIdentity();
+        from.setOrigin(rayFrom);
+        to.setIdentity();
+        to.setOrigin(rayTo);
+    }
+
+    void Process(const btDbvtNode* leaf) override {
+        auto proxy = static_cast<btBroadphaseProxy*>(leaf->data);
+        auto object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (object == ignore || !callback.needsCollision(proxy)) {
+            return;
+        }
+        btCollisionWorld::rayTestSingle(from, to, object,
+                                        object->getCollisionShape(),
+                                        object->getWorldTransform(), callback);
+    }
+};
+
+/// Collects the collision objects overlapping a volume, matching the
+/// results of a ghost object used by HitTest
+struct OverlapCollider : btDbvt::ICollide {
+    HitTest::TestResult& result;
+
+    explicit OverlapCollider(HitTest::TestResult& result) : result(result) {
+    }
+
+    void Process(const btDbvtNode* leaf) override {
+        auto proxy = static_cast<btBroadphaseProxy*>(leaf->data);
+        if ((proxy->m_collisionFilterMask &
+             btBroadphaseProxy::DefaultFilter) == 0) {
+            return;
+        }
+        auto object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        result.push_back(
+            {object, static_cast<GameObject*>(object->getUserPointer())});
+    }
+};
+}  // namespace
+
+PhysicsQueries::PhysicsQueries(btDbvtBroadphase& broadphase,
+                               TaskScheduler& tasks)
+    : broadphase(broadphase), tasks(tasks) {
+}
+
+PhysicsQueries::Handle PhysicsQueries::queueRay(
+    const glm::vec3& from, const glm::vec3& to,
+    const btCollisionObject* ignore, int filterGroup) {
+    queuedRays.push_back({from, to, ignore, filterGroup});
+    return {pendingBatch, static_cast<uint32_t>(queuedRays.size() - 1)};
+}
+
+PhysicsQueries::Handle PhysicsQueries::queueSphere(const glm::vec3& center,
+                                                   float radius) {
+    queuedSpheres.push_back({center, radius});
+    return {pendingBatch, static_cast<uint32_t>(queuedSpheres.size() - 1)};
+}
+
+void PhysicsQueries::flush() {
+    RW_PROFILE_SCOPE(__func__);
+    RW_PROFILE_COUNTER_SET("physicsQueries/rays", queuedRays.size());
+    RW_PROFILE_COUNTER_SET("physicsQueries/spheres", queuedSpheres.size());
+
+    // Rays are resolved in spatial order so that neighbouring queries on
+    // the same worker walk the same parts of the broadphase.
+    std::vector<uint32_t> order(queuedRays.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return localityKey(queuedRays[a].from) <
+               localityKey(queuedRays[b].from);
+    });
+
+    rayResults.resize(queuedRays.size());
+    tasks.parallelFor(0, static_cast<int>(order.size()), kQueryGrainSize,
+                      [&](int first, int last) {
+                          for (int i = first; i < last; ++i) {
+                              const auto& q = queuedRays[order[i]];
+                              rayResults[order[i]] = castRay(
+                                  q.from, q.to, q.ignore, q.filterGroup);
+                          }
+                      });
+
+    sphereResults.resize(queuedSpheres.size());
+    tasks.parallelFor(0, static_cast<int>(queuedSpheres.size()),
+                      kQueryGrainSize, [&](int first, int last) {
+                          for (int i = first; i < last; ++i) {
+                              const auto& q = queuedSpheres[i];
+                              sphereResults[i] = sphereTest(q.center, q.radius);
+                          }
+                      });
+
+    queuedRays.clear();
+    queuedSpheres.clear();
+    completedBatch = pendingBatch++;
+}
+
+const PhysicsQueries::RayResult* PhysicsQueries::getRay(Handle handle) const {
+    if (handle.batch != completedBatch || handle.index >= rayResults.size()) {
+        return nullptr;
+    }
+    return &rayResults[handle.index];
+}
+
+const HitTest::TestResult* PhysicsQueries::getSphere(Handle handle) const {
+    if (handle.batch != completedBatch ||
+        handle.index >= sphereResults.size()) {
+        return nullptr;
+    }
+    return &sphereResults[handle.index];
+}
+
+PhysicsQueries::RayResult PhysicsQueries::castRay(
+    const glm::vec3& from, const glm::vec3& to,
+    const btCollisionObject* ignore, int filterGroup) const {
+    auto rayFrom = toBullet(from);
+    auto rayTo = toBullet(to);
+    btCollisionWorld::ClosestRayResultCallback callback(rayFrom, rayTo);
+    callback.m_collisionFilterGroup = filterGroup;
+
+    RayCollider collider(ignore, rayFrom, rayTo, callback);
+    for (const auto& set : broadphase.m_sets) {
+        if (set.m_root) {
+            btDbvt::rayTest(set.m_root, rayFrom, rayTo, collider);
+        }
+    }
+
+    RayResult result;
+    if (callback.hasHit()) {
+        const auto& p = callback.m_hitPointWorld;
+        const auto& n = callback.m_hitNormalWorld;
+        result.hit = true;
+        result.fraction = callback.m_closestHitFraction;
+        result.position = {p.x(), p.y(), p.z()};
+        result.normal = {n.x(), n.y(), n.z()};
+        result.body = callback.m_collisionObject;
+        result.object =
+            static_cast<GameObject*>(result.body->getUserPointer());
+    }
+    return result;
+}
+
+HitTest::TestResult PhysicsQueries::sphereTest(const glm::vec3& center,
+                                               float radius) const {
+    auto volume = btDbvtVolume::FromCR(toBullet(center), radius);
+
+    HitTest::TestResult result;
+    OverlapCollider collider(result);
+    for (const auto& set : broadphase.m_sets) {
+        if (set.m_root) {
+            set.collideTV(set.m_root, volume, collider);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,122 @@
+#ifndef _RWENGINE_PHYSICSQUERIES_HPP_
+#define _RWENGINE_PHYSICSQUERIES_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <BulletCollision/BroadphaseCollision/btBroadphaseProxy.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+#include <dynamics/HitTest.hpp>
+
+class btCollisionObject;
+struct btDbvtBroadphase;
+class GameObject;
+class TaskScheduler;
+
+/**
+ * @brief Resolves ray and sphere queries against the physics world in
+ * batches.
+ *
+ * Queries queued during a tick are resolved together by flush(), sorted by
+ * location and spread over the worker threads, and can be read back with
+ * the returned handle until the next flush. castRay() and sphereTest()
+ * resolve a single query immediately, for call sites that need the result
+ * straight away.
+ *
+ * Queries only read the broadphase trees and collision objects, so flush()
+ * must not run during a simulation step.
+ */
+class PhysicsQueries {
+public:
+    struct Handle {
+        uint32_t batch = 0;
+        uint32_t index = 0;
+    };
+
+    struct RayResult {
+        bool hit = false;
+        float fraction = 1.f;
+        glm::vec3 position{};
+        glm::vec3 normal{};
+        const btCollisionObject* body = nullptr;
+        GameObject* object = nullptr;
+    };
+
+    PhysicsQueries(btDbvtBroadphase& broadphase, TaskScheduler& tasks);
+
+    /**
+     * @brief Queues a ray test for the next flush
+     * @param ignore Collision object that the ray should not hit
+     */
+    Handle queueRay(const glm::vec3& from, const glm::vec3& to,
+                    const btCollisionObject* ignore = nullptr,
+                    int filterGroup = btBroadphaseProxy::DefaultFilter);
+
+    /**
+     * @brief Queues a sphere overlap test for the next flush
+     */
+    Handle queueSphere(const glm::vec3& center, float radius);
+
+    /**
+     * @brief Resolves all queued queries
+     */
+    void flush();
+
+    /**
+     * @return The result of a flushed ray query, or nullptr if the handle is
+     * not from the last flush.
+     */
+    const RayResult* getRay(Handle handle) const;
+
+    /**
+     * @return The result of a flushed sphere query, or nullptr if the handle
+     * is not from the last flush.
+     */
+    const HitTest::TestResult* getSphere(Handle handle) const;
+
+    RayResult castRay(const glm::vec3& from, const glm::vec3& to,
+                      const btCollisionObject* ignore = nullptr,
+                      int filterGroup = btBroadphaseProxy::DefaultFilter) const;
+
+    HitTest::TestResult sphereTest(const glm::vec3& center,
+                                   float radius) const;
+
+    size_t getQueuedCount() const {
+        return queuedRays.size() + queuedSpheres.size();
+    }
+
+private:
+    struct RayQuery {
+        glm::vec3 from;
+        glm::vec3 to;
+        const btCollisionObject* ignore;
+        int filterGroup;
+    };
+
+    struct SphereQuery {
+        glm::vec3 center;
+        float radius;
+    };
+
+    btDbvtBroadphase& broadphase;
+    TaskScheduler& tasks;
+
+    uint32_t pendingBatch = 1;
+    uint32_t completedBatch = 0;
+
+    std::vector<RayQuery> queuedRays;
+    std::vector<SphereQuery> queuedSpheres;
+
+    std::vector<RayResult> rayResults;
+    std::vector<HitTest::TestResult> sphereResults;
+};
+
+#endif
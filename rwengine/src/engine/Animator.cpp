@@ -28,12 +28,13 @@ void Animator::tick(float dt) {
         if (state.animation == nullptr) continue;
 
         if (state.boneInstances.empty()) {
-            for (auto& [name, bone] : state.animation->bones) {
-                auto frame = model->findFrame(name);
-                if (!frame) {
+            const auto& bones = state.animation->bones;
+            for (auto i = 0u; i < bones.size(); ++i) {
+                auto frame = model->findFrame(bones[i].name);
+                if (!frame || bones[i].empty()) {
                     continue;
                 }
-                state.boneInstances.emplace(&bone, frame);
+                state.boneInstances.emplace_back(i, frame);
             }
         }
 
@@ -46,13 +47,13 @@ void Animator::tick(float dt) {
             animTime = std::fmod(animTime, state.animation->duration);
         }
 
-        for (auto& [bonePtr, frame] : state.boneInstances) {
-            if (bonePtr->frames.empty()) continue;
-            auto kf = bonePtr->getInterpolatedKeyframe(animTime);
+        for (auto& [index, frame] : state.boneInstances) {
+            const auto& bone = state.animation->bones[index];
+            auto kf = bone.getInterpolatedKeyframe(animTime);
 
             BoneTransform xform;
             xform.rotation = kf.rotation;
-            if (bonePtr->type != AnimationBone::R00) {
+            if (bone.type != AnimationBone::R00) {
                 xform.translation = kf.position;
             }
             frame->setTranslation(frame->getDefaultTranslation() +
@@ -4,10 +4,9 @@
 #include <rw/debug.hpp>
 #include <rw/forward.hpp>
 
-#include <map>
+#include <utility>
 #include <vector>
 
-struct AnimationBone;
 class ModelFrame;
 
 /**
@@ -33,7 +32,9 @@ class Animator {
         float speed;
         /// Automatically restart
         bool repeat;
-        std::map<AnimationBone*, ModelFrame*> boneInstances;
+        /// Bone indices of the animation and the frames they move, found
+        /// when the animation starts
+        std::vector<std::pair<int, ModelFrame*>> boneInstances;
     };
 
     /**
@@ -0,0 +1,604 @@
+#include "engine/DataSnapshot.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+#include "data/PathData.hpp"
+#include "data/Weather.hpp"
+#include "loaders/LoaderIPL.hpp"
+#include "objects/VehicleInfo.hpp"
+
+namespace {
+constexpr uint32_t kSnapshotMagic = 0x53445752;  // RWDS
+constexpr uint32_t kSnapshotVersion = 1;
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pointerSize;
+    /// Sizes of the structures that are stored as they are in memory
+    uint32_t layout;
+    uint32_t count;
+};
+
+SnapshotHeader expectedHeader(uint32_t count) {
+    constexpr auto layout = static_cast<uint32_t>(
+        sizeof(VehicleHandlingInfo) | (sizeof(Weather::Entry) << 10) |
+        (sizeof(PathNode) << 20));
+    return {kSnapshotMagic, kSnapshotVersion,
+            static_cast<uint32_t>(sizeof(void*)), layout, count};
+}
+
+template <class T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class Writer {
+public:
+    template <class T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(const std::string& value) {
+        write(static_cast<uint32_t>(value.size()));
+        bytes.append(value);
+    }
+
+    template <class T>
+    void writeArray(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(static_cast<uint32_t>(values.size()));
+        bytes.append(reinterpret_cast<const char*>(values.data()),
+                     values.size() * sizeof(T));
+    }
+
+    std::string bytes;
+};
+
+/// Reads values from an entry, failing once past its end
+class Reader {
+public:
+    Reader(const char* begin, const char* end) : pos(begin), end(end) {
+    }
+
+    template <class T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (static_cast<size_t>(end - pos) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool read(std::string& value) {
+        uint32_t size;
+        if (!read(size) || static_cast<size_t>(end - pos) < size) {
+            return false;
+        }
+        value.assign(pos, size);
+        pos += size;
+        return true;
+    }
+
+    template <class T>
+    bool readArray(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        uint32_t count;
+        if (!read(count) ||
+            static_cast<size_t>(end - pos) / sizeof(T) < count) {
+            return false;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), pos, count * sizeof(T));
+        pos += count * sizeof(T);
+        return true;
+    }
+
+    bool skip(size_t size) {
+        if (static_cast<size_t>(end - pos) < size) {
+            return false;
+        }
+        pos += size;
+        return true;
+    }
+
+    const char* position() const {
+        return pos;
+    }
+
+private:
+    const char* pos;
+    const char* end;
+};
+
+void writeModel(Writer& out, const BaseModelInfo& model) {
+    out.write(model.type());
+    out.write(model.id());
+    out.write(model.name);
+    out.write(model.textureslot);
+
+    switch (model.type()) {
+        case ModelDataType::SimpleInfo: {
+            const auto& simple = static_cast<const SimpleModelInfo&>(model);
+            out.write(simple.timeOn);
+            out.write(simple.timeOff);
+            out.write(simple.flags);
+            out.write(simple.getNumAtomics());
+            for (int i = 0; i < 3; ++i) {
+                out.write(simple.getLodDistance(i));
+            }
+            out.write(static_cast<uint32_t>(simple.paths.size()));
+            for (const auto& path : simple.paths) {
+                out.write(path.type);
+                out.write(path.ID);
+                out.write(path.modelName);
+                out.writeArray(path.nodes);
+            }
+        } break;
+        case ModelDataType::VehicleInfo: {
+            const auto& vehicle = static_cast<const VehicleModelInfo&>(model);
+            out.write(vehicle.vehicletype_);
+            out.write(vehicle.wheelmodel_);
+            out.write(vehicle.wheelscale_);
+            out.write(vehicle.numdoors_);
+            out.write(vehicle.handling_);
+            out.write(vehicle.vehicleclass_);
+            out.write(vehicle.frequency_);
+            out.write(vehicle.level_);
+            out.write(static_cast<uint64_t>(vehicle.componentrules_));
+            out.write(vehicle.vehiclename_);
+        } break;
+        case ModelDataType::PedInfo: {
+            const auto& ped = static_cast<const PedModelInfo&>(model);
+            out.write(ped.pedtype_);
+            out.write(ped.statindex_);
+            out.write(ped.animgroup_);
+            out.write(ped.carsmask_);
+        } break;
+        default:
+            break;
+    }
+}
+
+std::unique_ptr<BaseModelInfo> readModel(Reader& in) {
+    ModelDataType type;
+    ModelID id;
+    if (!in.read(type) || !in.read(id)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<BaseModelInfo> model;
+    bool valid = true;
+    switch (type) {
+        case ModelDataType::SimpleInfo: {
+            auto simple = std::make_unique<SimpleModelInfo>();
+            valid = in.read(simple->name) && in.read(simple->textureslot);
+            int numAtomics = 0;
+            valid = valid && in.read(simple->timeOn) &&
+                    in.read(simple->timeOff) && in.read(simple->flags) &&
+                    in.read(numAtomics);
+            simple->setNumAtomics(numAtomics);
+            for (int i = 0; valid && i < 3; ++i) {
+                float distance;
+                valid = in.read(distance);
+                simple->setLodDistance(i, distance);
+            }
+            simple->determineFurthest();
+            uint32_t pathCount = 0;
+            valid = valid && in.read(pathCount);
+            for (uint32_t i = 0; valid && i < pathCount; ++i) {
+                PathData path;
+                valid = in.read(path.type) && in.read(path.ID) &&
+                        in.read(path.modelName) && in.readArray(path.nodes);
+                simple->paths.push_back(std::move(path));
+            }
+            model = std::move(simple);
+        } break;
+        case ModelDataType::ClumpInfo: {
+            auto clump = std::make_unique<ClumpModelInfo>();
+            valid = in.read(clump->name) && in.read(clump->textureslot);
+            model = std::move(clump);
+        } break;
+        case ModelDataType::VehicleInfo: {
+            auto vehicle = std::make_unique<VehicleModelInfo>();
+            uint64_t componentRules = 0;
+            valid = in.read(vehicle->name) && in.read(vehicle->textureslot) &&
+                    in.read(vehicle->vehicletype_) &&
+                    in.read(vehicle->wheelmodel_) &&
+                    in.read(vehicle->wheelscale_) &&
+                    in.read(vehicle->numdoors_) &&
+                    in.read(vehicle->handling_) &&
+                    in.read(vehicle->vehicleclass_) &&
+                    in.read(vehicle->frequency_) && in.read(vehicle->level_) &&
+                    in.read(componentRules) && in.read(vehicle->vehiclename_);
+            vehicle->componentrules_ =
+                static_cast<unsigned long>(componentRules);
+            model = std::move(vehicle);
+        } break;
+        case ModelDataType::PedInfo: {
+            auto ped = std::make_unique<PedModelInfo>();
+            valid = in.read(ped->name) && in.read(ped->textureslot) &&
+                    in.read(ped->pedtype_) && in.read(ped->statindex_) &&
+                    in.read(ped->animgroup_) && in.read(ped->carsmask_);
+            model = std::move(ped);
+        } break;
+        default:
+            return nullptr;
+    }
+
+    if (!valid) {
+        return nullptr;
+    }
+    model->setModelID(id);
+    return model;
+}
+}  // namespace
+
+bool DataSnapshot::load(const std::filesystem::path& path) {
+    enabled = true;
+    entries.clear();
+    buffer.clear();
+    dirty = false;
+
+    std::ifstream file(path, std::ios_base::binary | std::ios_base::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // The whole snapshot is read at once, entries refer into the buffer
+    const auto fileSize = static_cast<size_t>(file.tellg());
+    if (fileSize < sizeof(SnapshotHeader)) {
+        return false;
+    }
+    buffer.resize(fileSize);
+    file.seekg(0);
+    if (!file.read(buffer.data(), static_cast<std::streamsize>(fileSize))) {
+        buffer.clear();
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+    auto expected = expectedHeader(header.count);
+    if (std::memcmp(&header, &expected, sizeof(header)) != 0) {
+        buffer.clear();
+        return false;
+    }
+
+    Reader reader(buffer.data() + sizeof(header),
+                  buffer.data() + buffer.size());
+    for (uint32_t i = 0; i < header.count; ++i) {
+        std::string key;
+        Entry entry;
+        uint64_t size;
+        if (!reader.read(key) || !reader.read(entry.hash) ||
+            !reader.read(size)) {
+            entries.clear();
+            buffer.clear();
+            return false;
+        }
+        entry.offset = static_cast<size_t>(reader.position() - buffer.data());
+        entry.size = static_cast<size_t>(size);
+        if (!reader.skip(entry.size)) {
+            entries.clear();
+            buffer.clear();
+            return false;
+        }
+        entries[std::move(key)] = std::move(entry);
+    }
+
+    return true;
+}
+
+bool DataSnapshot::save(const std::filesystem::path& path) {
+    std::ofstream file(path, std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    writeValue(file, expectedHeader(static_cast<uint32_t>(entries.size())));
+    for (const auto& [key, entry] : entries) {
+        const char* data =
+            entry.stored.empty() ? buffer.data() + entry.offset
+                                 : entry.stored.data();
+        writeValue(file, static_cast<uint32_t>(key.size()));
+        file.write(key.data(), static_cast<std::streamsize>(key.size()));
+        writeValue(file, entry.hash);
+        writeValue(file, static_cast<uint64_t>(entry.size));
+        file.write(data, static_cast<std::streamsize>(entry.size));
+    }
+
+    if (!file) {
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+std::uint64_t DataSnapshot::hashFile(const std::filesystem::path& path) const {
+    if (!enabled) {
+        return 0;
+    }
+
+    std::ifstream file(path, std::ios_base::binary);
+    if (!file.is_open()) {
+        return 0;
+    }
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    char chunk[16384];
+    while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+        const auto count = static_cast<size_t>(file.gcount());
+        for (size_t i = 0; i < count; ++i) {
+            hash = (hash ^ static_cast<uint8_t>(chunk[i])) * 1099511628211ull;
+        }
+    }
+    // Zero means "no hash"
+    return hash != 0 ? hash : 1;
+}
+
+bool DataSnapshot::find(const std::string& key, std::uint64_t hash,
+                        const char*& begin, const char*& end) const {
+    if (hash == 0) {
+        return false;
+    }
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.hash != hash) {
+        return false;
+    }
+    const auto& entry = it->second;
+    begin = entry.stored.empty() ? buffer.data() + entry.offset
+                                 : entry.stored.data();
+    end = begin + entry.size;
+    return true;
+}
+
+void DataSnapshot::store(const std::string& key, std::uint64_t hash,
+                         std::string&& data) {
+    if (hash == 0) {
+        return;
+    }
+    Entry entry;
+    entry.hash = hash;
+    entry.offset = 0;
+    entry.size = data.size();
+    entry.stored = std::move(data);
+    entries[key] = std::move(entry);
+    dirty = true;
+}
+
+bool DataSnapshot::readModels(const std::string& path, std::uint64_t hash,
+                              ModelInfoTable& out) const {
+    const char *begin, *end;
+    if (!find("ide:" + path, hash, begin, end)) {
+        return false;
+    }
+
+    Reader in(begin, end);
+    uint32_t count;
+    if (!in.read(count)) {
+        return false;
+    }
+    ModelInfoTable models;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto model = readModel(in);
+        if (!model) {
+            return false;
+        }
+        models.emplace(model->id(), std::move(model));
+    }
+
+    std::move(models.begin(), models.end(), std::inserter(out, out.end()));
+    return true;
+}
+
+void DataSnapshot::storeModels(const std::string& path, std::uint64_t hash,
+                               const ModelInfoTable& models) {
+    Writer out;
+    out.write(static_cast<uint32_t>(models.size()));
+    for (const auto& model : models) {
+        writeModel(out, *model.second);
+    }
+    store("ide:" + path, hash, std::move(out.bytes));
+}
+
+bool DataSnapshot::readIPL(const std::string& path, std::uint64_t hash,
+                           LoaderIPL& out) const {
+    const char *begin, *end;
+    if (!find("ipl:" + path, hash, begin, end)) {
+        return false;
+    }
+
+    Reader in(begin, end);
+    uint32_t count;
+    if (!in.read(count)) {
+        return false;
+    }
+    std::vector<InstanceData> instances;
+    instances.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        int id;
+        std::string model;
+        glm::vec3 pos, scale;
+        glm::quat rot;
+        if (!in.read(id) || !in.read(model) || !in.read(pos) ||
+            !in.read(scale) || !in.read(rot)) {
+            return false;
+        }
+        instances.emplace_back(id, std::move(model), pos, scale, rot);
+    }
+
+    if (!in.read(count)) {
+        return false;
+    }
+    ZoneDataList zones(count);
+    for (auto& zone : zones) {
+        if (!in.read(zone.name) || !in.read(zone.type) || !in.read(zone.min) ||
+            !in.read(zone.max) || !in.read(zone.island) ||
+            !in.read(zone.text) || !in.read(zone.gangDensityDay) ||
+            !in.read(zone.gangDensityNight) ||
+            !in.read(zone.gangCarDensityDay) ||
+            !in.read(zone.gangCarDensityNight) ||
+            !in.read(zone.pedGroupDay) || !in.read(zone.pedGroupNight)) {
+            return false;
+        }
+    }
+
+    std::move(instances.begin(), instances.end(),
+              std::back_inserter(out.m_instances));
+    std::move(zones.begin(), zones.end(), std::back_inserter(out.zones));
+    return true;
+}
+
+void DataSnapshot::storeIPL(const std::string& path, std::uint64_t hash,
+                            const LoaderIPL& ipl) {
+    Writer out;
+    out.write(static_cast<uint32_t>(ipl.m_instances.size()));
+    for (const auto& instance : ipl.m_instances) {
+        out.write(instance.id);
+        out.write(instance.model);
+        out.write(instance.pos);
+        out.write(instance.scale);
+        out.write(instance.rot);
+    }
+
+    out.write(static_cast<uint32_t>(ipl.zones.size()));
+    for (const auto& zone : ipl.zones) {
+        out.write(zone.name);
+        out.write(zone.type);
+        out.write(zone.min);
+        out.write(zone.max);
+        out.write(zone.island);
+        out.write(zone.text);
+        out.write(zone.gangDensityDay);
+        out.write(zone.gangDensityNight);
+        out.write(zone.gangCarDensityDay);
+        out.write(zone.gangCarDensityNight);
+        out.write(zone.pedGroupDay);
+        out.write(zone.pedGroupNight);
+    }
+    store("ipl:" + path, hash, std::move(out.bytes));
+}
+
+bool DataSnapshot::readWeather(const std::string& path, std::uint64_t hash,
+                               Weather& out) const {
+    const char *begin, *end;
+    if (!find("weather:" + path, hash, begin, end)) {
+        return false;
+    }
+
+    Reader in(begin, end);
+    std::vector<Weather::Entry> weather;
+    if (!in.readArray(weather)) {
+        return false;
+    }
+    out.entries.insert(out.entries.end(), weather.begin(), weather.end());
+    return true;
+}
+
+void DataSnapshot::storeWeather(const std::string& path, std::uint64_t hash,
+                                const Weather& weather) {
+    Writer out;
+    out.writeArray(weather.entries);
+    store("weather:" + path, hash, std::move(out.bytes));
+}
+
+bool DataSnapshot::readHandling(
+    const std::string& path, std::uint64_t hash,
+    std::unordered_map<std::string, VehicleInfo>& out) const {
+    const char *begin, *end;
+    if (!find("handling:" + path, hash, begin, end)) {
+        return false;
+    }
+
+    Reader in(begin, end);
+    uint32_t count;
+    if (!in.read(count)) {
+        return false;
+    }
+    std::vector<std::pair<std::string, VehicleHandlingInfo>> handling(count);
+    for (auto& [name, info] : handling) {
+        if (!in.read(name) || !in.read(info)) {
+            return false;
+        }
+    }
+
+    // Same as GenericDATLoader::loadHandling, keep the cached wheels and seats
+    for (auto& [name, info] : handling) {
+        auto it = out.find(name);
+        if (it == out.end()) {
+            out.emplace(std::move(name),
+                        VehicleInfo{info, std::vector<WheelInfo>{},
+                                    VehicleInfo::Seats{}});
+        } else {
+            it->second.handling = info;
+        }
+    }
+    return true;
+}
+
+void DataSnapshot::storeHandling(
+    const std::string& path, std::uint64_t hash,
+    const std::unordered_map<std::string, VehicleInfo>& vehicles) {
+    Writer out;
+    out.write(static_cast<uint32_t>(vehicles.size()));
+    for (const auto& [name, info] : vehicles) {
+        out.write(name);
+        out.write(info.handling);
+    }
+    store("handling:" + path, hash, std::move(out.bytes));
+}
+
+bool DataSnapshot::readPedStats(const std::string& path, std::uint64_t hash,
+                                PedStatsList& out) const {
+    const char *begin, *end;
+    if (!find("pedstats:" + path, hash, begin, end)) {
+        return false;
+    }
+
+    Reader in(begin, end);
+    uint32_t count;
+    if (!in.read(count)) {
+        return false;
+    }
+    PedStatsList stats(count);
+    for (auto& s : stats) {
+        if (!in.read(s.id_) || !in.read(s.name_) ||
+            !in.read(s.fleedistance_) || !in.read(s.rotaterate_) ||
+            !in.read(s.fear_) || !in.read(s.temper_) || !in.read(s.lawful_) ||
+            !in.read(s.sexy_) || !in.read(s.attackstrength_) ||
+            !in.read(s.defendweakness_) || !in.read(s.flags_)) {
+            return false;
+        }
+    }
+    out.insert(out.end(), stats.begin(), stats.end());
+    return true;
+}
+
+void DataSnapshot::storePedStats(const std::string& path, std::uint64_t hash,
+                                 const PedStatsList& stats) {
+    Writer out;
+    out.write(static_cast<uint32_t>(stats.size()));
+    for (const auto& s : stats) {
+        out.write(s.id_);
+        out.write(s.name_);
+        out.write(s.fleedistance_);
+        out.write(s.rotaterate_);
+        out.write(s.fear_);
+        out.write(s.temper_);
+        out.write(s.lawful_);
+        out.write(s.sexy_);
+        out.write(s.attackstrength_);
+        out.write(s.defendweakness_);
+        out.write(s.flags_);
+    }
+    store("pedstats:" + path, hash, std::move(out.bytes));
+}
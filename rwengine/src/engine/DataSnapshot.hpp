@@ -0,0 +1,121 @@
+#ifndef _RWENGINE_DATASNAPSHOT_HPP_
+#define _RWENGINE_DATASNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <data/ModelData.hpp>
+#include <data/PedData.hpp>
+
+class LoaderIPL;
+class Weather;
+struct VehicleInfo;
+
+/**
+ * @brief Stores the parsed contents of the text data files so that they
+ * don't need to be parsed every time the game starts.
+ *
+ * Entries are keyed by the data file's path and validated against a hash
+ * of its contents (and of the files it depends on), so editing a file only
+ * invalidates its own entry. The file is read with a single read and is
+ * only valid for the build that wrote it, as plain structures are stored
+ * as they are in memory.
+ *
+ * The snapshot does nothing until it is enabled by load().
+ */
+class DataSnapshot {
+public:
+    /**
+     * @brief Enables the snapshot and reads previously saved entries
+     * @return false if the file is missing or incompatible
+     */
+    bool load(const std::filesystem::path& path);
+
+    /**
+     * @brief Writes all entries to path
+     */
+    bool save(const std::filesystem::path& path);
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    /**
+     * @brief Returns true if entries were added since the last load or save
+     */
+    bool isDirty() const {
+        return dirty;
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    /**
+     * @brief Hashes the contents of a file, 0 if the snapshot is disabled
+     * or the file can't be read
+     */
+    std::uint64_t hashFile(const std::filesystem::path& path) const;
+
+    static std::uint64_t combineHashes(std::uint64_t a, std::uint64_t b) {
+        return a ^ (b + 0x9e3779b97f4a7c15ull + (a << 6) + (a >> 2));
+    }
+
+    /// @name Typed entries
+    /// The read functions add to out and return true if there was a valid
+    /// entry for path, the store functions do nothing for a zero hash.
+    /// @{
+    bool readModels(const std::string& path, std::uint64_t hash,
+                    ModelInfoTable& out) const;
+    void storeModels(const std::string& path, std::uint64_t hash,
+                     const ModelInfoTable& models);
+
+    bool readIPL(const std::string& path, std::uint64_t hash,
+                 LoaderIPL& out) const;
+    void storeIPL(const std::string& path, std::uint64_t hash,
+                  const LoaderIPL& ipl);
+
+    bool readWeather(const std::string& path, std::uint64_t hash,
+                     Weather& out) const;
+    void storeWeather(const std::string& path, std::uint64_t hash,
+                      const Weather& weather);
+
+    bool readHandling(const std::string& path, std::uint64_t hash,
+                      std::unordered_map<std::string, VehicleInfo>& out) const;
+    void storeHandling(
+        const std::string& path, std::uint64_t hash,
+        const std::unordered_map<std::string, VehicleInfo>& vehicles);
+
+    bool readPedStats(const std::string& path, std::uint64_t hash,
+                      PedStatsList& out) const;
+    void storePedStats(const std::string& path, std::uint64_t hash,
+                       const PedStatsList& stats);
+    /// @}
+
+private:
+    struct Entry {
+        std::uint64_t hash;
+        /// Offset and size in buffer, for entries from the file
+        std::size_t offset;
+        std::size_t size;
+        /// Data of entries stored since
+        std::string stored;
+    };
+
+    /// Returns the data of the entry for key if its hash matches
+    bool find(const std::string& key, std::uint64_t hash, const char*& begin,
+              const char*& end) const;
+    void store(const std::string& key, std::uint64_t hash, std::string&& data);
+
+    /// The contents of the loaded file
+    std::vector<char> buffer;
+    std::unordered_map<std::string, Entry> entries;
+    bool enabled = false;
+    bool dirty = false;
+};
+
+#endif
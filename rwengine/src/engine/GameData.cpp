@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
@@ -9,6 +10,7 @@
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_set>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -37,7 +39,11 @@ GameData::GameData(Logger* log, const std::filesystem::path& path)
     : datpath(path), logger(log) {
     dffLoader.setTextureLookupCallback(
         [&](const std::string& texture, const std::string&) {
-            return findSlotTexture(currenttextureslot, texture);
+            auto found = findSlotTexture(currenttextureslot, texture);
+            if (found) {
+                dffTextureSlots.insert(currenttextureslot);
+            }
+            return found;
         });
 }
 
@@ -143,9 +149,18 @@ void GameData::loadLevelFile(const std::string& path) {
 
 void GameData::loadIDE(const std::string& path) {
     auto systempath = index.findFilePath(path).string();
-    LoaderIDE idel;
 
+    auto hash = snapshot.hashFile(systempath);
+    if (hash != 0) {
+        hash = DataSnapshot::combineHashes(hash, pedStatsHash);
+    }
+    if (snapshot.readModels(path, hash, modelinfo)) {
+        return;
+    }
+
+    LoaderIDE idel;
     if (idel.load(systempath, pedstats)) {
+        snapshot.storeModels(path, hash, idel.objects);
         std::move(idel.objects.begin(), idel.objects.end(),
                   std::inserter(modelinfo, modelinfo.end()));
     } else {
@@ -208,7 +223,7 @@ bool GameData::loadZone(const std::string& path) {
     LoaderIPL ipll;
 
     // Load the zones
-    if (!ipll.load(path)) {
+    if (!readIPL(path, ipll)) {
         logger->error("Data", "Failed to load zones from " + path);
         return false;
     }
@@ -227,6 +242,18 @@ bool GameData::loadZone(const std::string& path) {
     return true;
 }
 
+bool GameData::readIPL(const std::string& path, LoaderIPL& ipl) {
+    auto hash = snapshot.hashFile(path);
+    if (snapshot.readIPL(path, hash, ipl)) {
+        return true;
+    }
+    if (!ipl.load(path)) {
+        return false;
+    }
+    snapshot.storeIPL(path, hash, ipl);
+    return true;
+}
+
 enum ColSection {
     Unknown,
     COL,
@@ -284,16 +311,26 @@ void GameData::loadCarcols(const std::string& path) {
 
 void GameData::loadWeather(const std::string& path) {
     auto syspath = index.findFilePath(path).string();
+    auto hash = snapshot.hashFile(syspath);
+    if (snapshot.readWeather(path, hash, weather)) {
+        return;
+    }
     if (!WeatherLoader::load(syspath, weather)) {
         throw std::runtime_error("Loading Weather " + path + " failed");
     }
+    snapshot.storeWeather(path, hash, weather);
 }
 
 void GameData::loadHandling(const std::string& path) {
     GenericDATLoader l;
     auto syspath = index.findFilePath(path).string();
 
+    auto hash = snapshot.hashFile(syspath);
+    if (snapshot.readHandling(path, hash, vehicleInfos)) {
+        return;
+    }
     l.loadHandling(syspath, vehicleInfos);
+    snapshot.storeHandling(path, hash, vehicleInfos);
 }
 
 SCMFile GameData::loadSCM(const std::string& path) {
@@ -372,13 +409,54 @@ void GameData::loadTXD(const std::string& name) {
         return;
     }
 
-    textureSlots[slot] = loadTextureArchive(name);
+    std::vector<DecodedTexture> decoded;
+    auto it = prefetchedTextures.find(FileIndex::normalizeFilePath(name));
+    if (it != prefetchedTextures.end()) {
+        auto textures = std::move(it->second);
+        prefetchedTextures.erase(it);
+        try {
+            decoded = textures.get();
+        } catch (const std::exception& e) {
+            logger->error("Data",
+                          "Failed to prefetch " + name + ": " + e.what());
+        }
+    }
+    if (decoded.empty()) {
+        auto file = openFile(name);
+        if (!file.data) {
+            logger->error("Data", "Failed to open txd: " + name);
+        } else if (!TextureLoader::decode(file, decoded,
+                                          keepTexturePalettes)) {
+            logger->error("Data", "Error loading txd: " + name);
+        } else if (packTextureArrays) {
+            TextureLoader::packArrays(decoded);
+        }
+    }
+
+    // The larger mip levels are uploaded over the next frames
+    auto& textures = textureSlots[slot];
+    for (auto& texture : decoded) {
+        if (!texture.isArray()) {
+            auto textureName = texture.name;
+            textures[textureName] = textureUploader.add(std::move(texture));
+            continue;
+        }
+        const auto layers = texture.layers;
+        std::shared_ptr<TextureData> array =
+            textureUploader.add(std::move(texture));
+        const auto count = static_cast<int>(layers.size());
+        for (int i = 0; i < count; ++i) {
+            textures[layers[i].name] = TextureData::createLayer(
+                array, i, count, layers[i].transparent);
+        }
+    }
+    textureResidency.add(slot, textures);
 }
 
 TextureArchive GameData::loadTextureArchive(const std::string& name) {
     RW_PROFILE_COUNTER_ADD("loadTextureArchive", 1);
     /// @todo refactor loadTXD to use correct file locations
-    auto file = index.openFile(name);
+    auto file = openFile(name);
     if (!file.data) {
         logger->error("Data", "Failed to open txd: " + name);
         return {};
@@ -424,7 +502,7 @@ ClumpPtr GameData::loadClump(const std::string& name) {
         logger->error("Data", "Failed to load model " + name);
         return nullptr;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    auto m = loadDFF(file);
     if (!m) {
         logger->error("Data", "Error loading model file " + name);
         return nullptr;
@@ -432,6 +510,20 @@ ClumpPtr GameData::loadClump(const std::string& name) {
     return m;
 }
 
+ClumpPtr GameData::loadDFF(const FileContentsInfo& file) {
+    dffTextureSlots.clear();
+    auto clump = dffLoader.loadFromMemory(file);
+    if (clump) {
+        for (const auto& slot : dffTextureSlots) {
+            for (const auto& atomic : clump->getAtomics()) {
+                textureResidency.bind(slot, atomic->getGeometry());
+            }
+        }
+    }
+    dffTextureSlots.clear();
+    return clump;
+}
+
 ClumpPtr GameData::loadClump(const std::string& name, const std::string& textureSlot) {
     std::string currentSlot = currenttextureslot;
     if (!textureSlot.empty())
@@ -447,7 +539,7 @@ void GameData::loadModelFile(const std::string& name) {
         logger->log("Data", Logger::Error, "Failed to load model file " + name);
         return;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    auto m = loadDFF(file);
     if (!m) {
         logger->log("Data", Logger::Error, "Error loading model file " + name);
         return;
@@ -474,18 +566,19 @@ void GameData::loadModelFile(const std::string& name) {
     }
 }
 
-bool GameData::loadModel(ModelID model) {
-    auto info = modelinfo[model].get();
+void GameData::getModelFiles(ModelID model, std::string& name,
+                             std::string& slot) const {
+    auto info = modelinfo.at(model).get();
     /// @todo replace openFile with API for loading from CDIMAGE archives
-    auto name = info->name;
-    auto slotname = info->textureslot;
+    name = info->name;
+    slot = info->textureslot;
 
     // Re-direct special models
     switch (info->type()) {
         case ModelDataType::ClumpInfo:
             // Re-direct the hier objects to the special object ids
             name = engine->state->specialModels[info->id()];
-            slotname = name;
+            slot = name;
             break;
         case ModelDataType::PedInfo: {
             static const std::string specialPrefix("special");
@@ -493,7 +586,7 @@ bool GameData::loadModel(ModelID model) {
                 auto sid = name.substr(specialPrefix.size());
                 unsigned short specialID = lexical_cast<int>(sid);
                 name = engine->state->specialCharacters[specialID];
-                slotname = name;
+                slot = name;
                 break;
             }
         }
@@ -502,19 +595,25 @@ bool GameData::loadModel(ModelID model) {
     }
 
     std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-    std::transform(slotname.begin(), slotname.end(), slotname.begin(),
-                   ::tolower);
+    std::transform(slot.begin(), slot.end(), slot.begin(), ::tolower);
+}
+
+bool GameData::loadModel(ModelID model) {
+    auto info = modelinfo[model].get();
+    std::string name;
+    std::string slotname;
+    getModelFiles(model, name, slotname);
 
     /// @todo remove this from here
     loadTXD(slotname + ".txd");
 
-    auto file = index.openFile(name + ".dff");
+    auto file = openFile(name + ".dff");
     if (!file.data) {
         logger->error("Data", "Failed to load model for " +
                                   std::to_string(model) + " [" + name + "]");
         return false;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    auto m = loadDFF(file);
     if (!m) {
         logger->error("Data",
                       "Error loading model file for " + std::to_string(model));
@@ -543,6 +642,106 @@ bool GameData::loadModel(ModelID model) {
     return true;
 }
 
+void GameData::prefetchFile(const std::string& name) {
+    auto path = FileIndex::normalizeFilePath(name);
+    if (prefetchedFiles.count(path) != 0) {
+        return;
+    }
+    RW_PROFILE_COUNTER_ADD("prefetchFile", 1);
+    prefetchedFiles.emplace(
+        path, workers.submit([this, path]() { return index.openFile(path); }));
+}
+
+void GameData::prefetchTextures(const std::string& name) {
+    auto path = FileIndex::normalizeFilePath(name);
+    if (prefetchedTextures.count(path) != 0) {
+        return;
+    }
+    RW_PROFILE_COUNTER_ADD("prefetchTextures", 1);
+    const auto keepPalettes = keepTexturePalettes;
+    const auto packArrays = packTextureArrays;
+    prefetchedTextures.emplace(
+        path, workers.submit([this, path, keepPalettes, packArrays]() {
+            std::vector<DecodedTexture> textures;
+            auto file = index.openFile(path);
+            if (file.data) {
+                TextureLoader::decode(file, textures, keepPalettes);
+                if (packArrays) {
+                    TextureLoader::packArrays(textures);
+                }
+            }
+            return textures;
+        }));
+}
+
+void GameData::prefetchModel(ModelID model) {
+    auto it = modelinfo.find(model);
+    if (it == modelinfo.end() || it->second->isLoaded()) {
+        return;
+    }
+    std::string name;
+    std::string slot;
+    getModelFiles(model, name, slot);
+    if (name.empty()) {
+        return;
+    }
+    prefetchFile(name + ".dff");
+    if (textureSlots.find(slot) == textureSlots.end()) {
+        prefetchTextures(slot + ".txd");
+    }
+}
+
+bool GameData::isFileReady(const std::string& name) const {
+    auto path = FileIndex::normalizeFilePath(name);
+    auto it = prefetchedFiles.find(path);
+    if (it != prefetchedFiles.end() &&
+        it->second.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready) {
+        return false;
+    }
+    auto textures = prefetchedTextures.find(path);
+    return textures == prefetchedTextures.end() ||
+           textures->second.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+}
+
+bool GameData::isModelReady(ModelID model) const {
+    std::string name;
+    std::string slot;
+    getModelFiles(model, name, slot);
+    return isFileReady(name + ".dff") && isFileReady(slot + ".txd");
+}
+
+void GameData::waitForModel(ModelID model) const {
+    std::string name;
+    std::string slot;
+    getModelFiles(model, name, slot);
+    auto file = prefetchedFiles.find(FileIndex::normalizeFilePath(name + ".dff"));
+    if (file != prefetchedFiles.end()) {
+        file->second.wait();
+    }
+    auto textures =
+        prefetchedTextures.find(FileIndex::normalizeFilePath(slot + ".txd"));
+    if (textures != prefetchedTextures.end()) {
+        textures->second.wait();
+    }
+}
+
+FileContentsInfo GameData::openFile(const std::string& name) {
+    auto it = prefetchedFiles.find(FileIndex::normalizeFilePath(name));
+    if (it == prefetchedFiles.end()) {
+        return index.openFile(name);
+    }
+    auto file = std::move(it->second);
+    prefetchedFiles.erase(it);
+    try {
+        return file.get();
+    } catch (const std::exception& e) {
+        logger->error("Data", "Failed to prefetch " + name + ": " + e.what());
+        return index.openFile(name);
+    }
+}
+
 void GameData::loadIFP(const std::string& name, bool cutsceneAnimation) {
     auto f = index.openFile(name);
 
@@ -569,6 +768,11 @@ void GameData::loadWeaponDAT(const std::string& path) {
 
 void GameData::loadPedStats(const std::string& path) {
     auto syspath = index.findFilePath(path).string();
+    pedStatsHash = snapshot.hashFile(syspath);
+    if (snapshot.readPedStats(path, pedStatsHash, pedstats)) {
+        return;
+    }
+
     std::ifstream fs(syspath.c_str());
     if (!fs.is_open()) {
         throw std::runtime_error("Failed to open " + path);
@@ -596,6 +800,7 @@ void GameData::loadPedStats(const std::string& path) {
 
         pedstats.push_back(stats);
     }
+    snapshot.storePedStats(path, pedStatsHash, pedstats);
 }
 
 void GameData::loadPedRelations(const std::string& path) {
@@ -700,7 +905,16 @@ bool GameData::loadAudioClip(const std::string& name,
         return false;
     }
 
-    bool loaded = engine->sound.loadSound(name, systempath);
+    bool loaded = false;
+    auto prefetched =
+        prefetchedAudio.find(FileIndex::normalizeFilePath("audio/" + fileName));
+    if (prefetched != prefetchedAudio.end()) {
+        auto source = std::move(prefetched->second);
+        prefetchedAudio.erase(prefetched);
+        loaded = engine->sound.addMusic(name, source.get());
+    } else {
+        loaded = engine->sound.loadSound(name, systempath);
+    }
 
     if (!loaded) {
         logger->error("Data", "Error loading audio clip " + systempath);
@@ -712,6 +926,30 @@ bool GameData::loadAudioClip(const std::string& name,
     return true;
 }
 
+void GameData::prefetchAudioClip(const std::string& fileName) {
+    if (!engine || engine->sound.isNullAudio()) {
+        return;
+    }
+    auto path = FileIndex::normalizeFilePath("audio/" + fileName);
+    if (prefetchedAudio.count(path) != 0) {
+        return;
+    }
+    std::string systempath;
+    try {
+        systempath = index.findFilePath(path).string();
+    } catch (const std::out_of_range&) {
+        return;
+    }
+    // Mission audio plays through OpenAL, only cutscenes can use MP3
+    if (systempath.find(".mp3") != std::string::npos) {
+        return;
+    }
+    RW_PROFILE_COUNTER_ADD("prefetchAudioClip", 1);
+    prefetchedAudio.emplace(path, workers.submit([systempath]() {
+                                return SoundManager::openMusic(systempath);
+                            }));
+}
+
 void GameData::loadSplash(const std::string& name) {
     std::string lower(name);
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
@@ -721,6 +959,41 @@ void GameData::loadSplash(const std::string& name) {
     engine->state->currentSplash = lower;
 }
 
+TextureMemoryReport GameData::getTextureMemoryReport() const {
+    TextureMemoryReport report;
+    for (const auto& [slot, textures] : textureSlots) {
+        for (const auto& [name, texture] : textures) {
+            if (texture) {
+                report.add(*texture);
+            }
+        }
+    }
+    return report;
+}
+
+void GameData::updateTextureResidency() {
+    textureResidency.beginFrame();
+    if (!textureResidency.isOverBudget()) {
+        return;
+    }
+
+    std::unordered_set<std::string> referenced;
+    std::string name;
+    std::string slot;
+    for (const auto& [id, info] : modelinfo) {
+        if (!info->isLoaded()) {
+            continue;
+        }
+        // Special models are redirected through the game state
+        if (engine && engine->state) {
+            getModelFiles(id, name, slot);
+            referenced.insert(slot);
+        }
+        referenced.insert(info->textureslot);
+    }
+    textureResidency.evict(textureSlots, referenced);
+}
+
 TextureData* GameData::findSlotTexture(const std::string &slot, const std::string &texture) const {
     auto slotIt = textureSlots.find(slot);
     if (slotIt == textureSlots.end()) {
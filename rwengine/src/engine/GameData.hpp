@@ -5,12 +5,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <core/TaskScheduler.hpp>
+#include <platform/FileHandle.hpp>
 #include <platform/FileIndex.hpp>
 #include <rw/debug.hpp>
 #include <rw/forward.hpp>
@@ -21,17 +25,23 @@
 #include <data/WeaponData.hpp>
 #include <data/Weather.hpp>
 #include <data/ZoneData.hpp>
+#include <dynamics/CollisionBvhCache.hpp>
+#include <engine/DataSnapshot.hpp>
+#include <engine/TextureResidency.hpp>
 #include <fonts/GameTexts.hpp>
+#include <gl/TextureUploader.hpp>
 #include <loaders/LoaderDFF.hpp>
 #include <loaders/LoaderIMG.hpp>
 #include <loaders/LoaderTXD.hpp>
 #include <objects/VehicleInfo.hpp>
 
 class Logger;
+class LoaderIPL;
 struct WeaponData;
 class GameWorld;
 class TextureAtlas;
 class SCMFile;
+class SoundSource;
 
 /**
  * @brief Loads and stores all "static" data such as loaded models, handling
@@ -49,6 +59,23 @@ private:
 
     Logger* logger;
     LoaderDFF dffLoader;
+    /// Slots the textures of the DFF being loaded were found in
+    std::unordered_set<std::string> dffTextureSlots;
+
+    /// Loads a DFF and binds the slots its materials use to its geometry
+    ClumpPtr loadDFF(const FileContentsInfo& file);
+
+    /// Files read by the workers and not opened yet, by normalized path
+    std::unordered_map<std::string, std::future<FileContentsInfo>>
+        prefetchedFiles;
+
+    /// Texture dictionaries decoded by the workers, by normalized path
+    std::unordered_map<std::string, std::future<std::vector<DecodedTexture>>>
+        prefetchedTextures;
+
+    /// Audio clips opened by the workers, by normalized path under audio/
+    std::unordered_map<std::string, std::future<std::shared_ptr<SoundSource>>>
+        prefetchedAudio;
 
 public:
     /**
@@ -96,6 +123,12 @@ public:
      */
     bool loadZone(const std::string& path);
 
+    /**
+     * Reads the instances and zones of an IPL file, from the data snapshot
+     * if it is up to date
+     */
+    bool readIPL(const std::string& path, LoaderIPL& ipl);
+
     void loadCarcols(const std::string& path);
 
     void loadWeather(const std::string& path);
@@ -160,6 +193,67 @@ public:
      */
     bool loadModel(ModelID model);
 
+    /**
+     * Finds the DFF name and texture slot of a model, following special
+     * characters and models to the names the scripts chose for them
+     */
+    void getModelFiles(ModelID model, std::string& name,
+                       std::string& slot) const;
+
+    /**
+     * @brief Starts reading a file on a worker thread
+     *
+     * The next openFile of the file, through loadModel or loadTXD for
+     * example, takes the data instead of reading it again.
+     */
+    void prefetchFile(const std::string& name);
+
+    /**
+     * @brief Starts reading and decoding a texture dictionary on a worker
+     * thread, the next loadTXD of it only has to upload the textures
+     */
+    void prefetchTextures(const std::string& name);
+
+    /**
+     * @brief Prefetches the files of a model that isn't loaded yet
+     */
+    void prefetchModel(ModelID model);
+
+    /**
+     * @return false while a prefetched file is still being read
+     */
+    bool isFileReady(const std::string& name) const;
+
+    /**
+     * @return false while the files of the model are still being read
+     */
+    bool isModelReady(ModelID model) const;
+
+    /**
+     * Waits until the prefetched files of the model have been read
+     */
+    void waitForModel(ModelID model) const;
+
+    /**
+     * Opens a file from the index, taking prefetched data if there is any
+     */
+    FileContentsInfo openFile(const std::string& name);
+
+    /**
+     * Drops the data of a prefetched file that won't be opened
+     */
+    void discardPrefetchedFile(const std::string& name) {
+        auto path = FileIndex::normalizeFilePath(name);
+        prefetchedFiles.erase(path);
+        prefetchedTextures.erase(path);
+        prefetchedAudio.erase(path);
+    }
+
+    std::size_t getPrefetchedFileCount() const {
+        return prefetchedFiles.size() + prefetchedTextures.size() +
+               prefetchedAudio.size();
+    }
+
     /**
      * Loads an IFP file containing animations
      */
@@ -191,10 +285,31 @@ public:
     void loadPedGroups(const std::string& path);
 
     bool loadAudioStream(const std::string& name);
+    /**
+     * Loads an audio clip as the mission audio, taking it from
+     * prefetchAudioClip if it was prefetched
+     */
     bool loadAudioClip(const std::string& name, const std::string& fileName);
 
+    /**
+     * @brief Starts opening an audio clip from the audio directory on a
+     * worker thread, for loadAudioClip
+     */
+    void prefetchAudioClip(const std::string& fileName);
+
     void loadSplash(const std::string& name);
 
+    /**
+     * Memory used by the textures of all slots, by how they are stored
+     */
+    TextureMemoryReport getTextureMemoryReport() const;
+
+    /**
+     * Starts a new frame for the texture residency, and evicts texture slots
+     * that no loaded model or live geometry uses if they exceed the budget
+     */
+    void updateTextureResidency();
+
     TextureData* findSlotTexture(const std::string& slot,
                                         const std::string& texture) const;
 
@@ -225,6 +340,16 @@ public:
 
     std::unordered_map<ModelID, std::unique_ptr<BaseModelInfo>> modelinfo;
 
+    /**
+     * Serialized collision BVHs, used when building collision shapes
+     */
+    CollisionBvhCache bvhCache;
+
+    /**
+     * Parsed data files, used instead of parsing them again when enabled
+     */
+    DataSnapshot snapshot;
+
     uint16_t findModelObject(const std::string model);
 
     template <class T>
@@ -262,6 +387,30 @@ public:
      */
     Weather weather;
 
+    /**
+     * Uploads the mip levels of textures loaded by loadTXD, has to outlive
+     * the texture slots.
+     */
+    TextureUploader textureUploader;
+
+    /**
+     * Keep PAL8 textures loaded by loadTXD as palette indices, which uses a
+     * quarter of the memory. Only the world shaders can draw them.
+     */
+    bool keepTexturePalettes = false;
+
+    /**
+     * Pack the textures of each TXD loaded by loadTXD into texture arrays
+     * where their size and sampling match, so fewer textures are bound per
+     * frame. Only the world shaders can draw them.
+     */
+    bool packTextureArrays = false;
+
+    /**
+     * Tracks the slots loaded by loadTXD and evicts unused ones
+     */
+    TextureResidency textureResidency;
+
     /**
      * Texture slots, containing loaded textures.
      */
@@ -306,6 +455,11 @@ public:
      */
     std::vector<PedStats> pedstats;
 
+    /**
+     * Hash of the ped stats file, IDE snapshots depend on the ped stats
+     */
+    std::uint64_t pedStatsHash = 0;
+
     /**
      * Pedestrian relationships
      */
@@ -359,6 +513,14 @@ public:
 
     GameTexts texts;
 
+    /**
+     * Worker threads for background loading and parallel simulation.
+     *
+     * Declared last so that it is stopped before the data it works on is
+     * destroyed.
+     */
+    TaskScheduler workers;
+
 private:
     /**
      * Determines whether the given path is a valid game directory.
@@ -3,7 +3,9 @@
 #ifdef _MSC_VER
 #pragma warning(disable : 4305)
 #endif
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <btBulletDynamicsCommon.h>
 #ifdef _MSC_VER
 #pragma warning(default : 4305)
@@ -11,6 +13,8 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include <stdexcept>
+
 #include <data/Clump.hpp>
 
 #include "core/Profiler.hpp"
@@ -23,9 +27,11 @@
 #include "ai/AIGraphNode.hpp"
 #include "ai/DefaultAIController.hpp"
 #include "ai/PlayerController.hpp"
+#include "ai/RoutePlanner.hpp"
 #include "ai/TrafficDirector.hpp"
 
-#include "dynamics/HitTest.hpp"
+#include "dynamics/BulletTaskScheduler.hpp"
+#include "dynamics/PhysicsQueries.hpp"
 
 #include "data/CutsceneData.hpp"
 #include "data/InstanceData.hpp"
@@ -78,18 +84,49 @@ public:
     }
 };
 
-GameWorld::GameWorld(Logger* log, GameData* dat)
-    : logger(log), data(dat), sound(this) {
+GameWorld::GameWorld(Logger* log, GameData* dat, bool multithreadedPhysics,
+                     bool nullAudio)
+    : logger(log), data(dat), sound(this, nullAudio) {
     data->engine = this;
 
     collisionConfig = std::make_unique<btDefaultCollisionConfiguration>();
-    collisionDispatcher =
-        std::make_unique<WorldCollisionDispatcher>(collisionConfig.get());
     broadphase = std::make_unique<btDbvtBroadphase>();
-    solver = std::make_unique<btSequentialImpulseConstraintSolver>();
-    dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(
-        collisionDispatcher.get(), broadphase.get(), solver.get(),
-        collisionConfig.get());
+
+    if (multithreadedPhysics) {
+        physicsScheduler =
+            std::make_unique<BulletTaskScheduler>(data->workers);
+        btSetTaskScheduler(physicsScheduler.get());
+
+        collisionDispatcher =
+            std::make_unique<btCollisionDispatcherMt>(collisionConfig.get());
+        auto solverPool = std::make_unique<btConstraintSolverPoolMt>(
+            physicsScheduler->getMaxNumThreads());
+#if BT_BULLET_VERSION >= 288
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+            collisionDispatcher.get(), broadphase.get(), solverPool.get(),
+            nullptr, collisionConfig.get());
+#else
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+            collisionDispatcher.get(), broadphase.get(), solverPool.get(),
+            collisionConfig.get());
+#endif
+        solver = std::move(solverPool);
+        logger->info("World", "Using multithreaded physics with " +
+                                  std::to_string(
+                                      physicsScheduler->getMaxNumThreads()) +
+                                  " threads");
+    } else {
+        collisionDispatcher =
+            std::make_unique<WorldCollisionDispatcher>(collisionConfig.get());
+        solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(
+            collisionDispatcher.get(), broadphase.get(), solver.get(),
+            collisionConfig.get());
+    }
+
+    queries = std::make_unique<PhysicsQueries>(*broadphase, data->workers);
+    routePlanner = std::make_unique<ai::RoutePlanner>(aigraph, data->workers);
+    trafficDirector = std::make_unique<ai::TrafficDirector>(&aigraph, this);
 
     dynamicsWorld->setGravity(btVector3(0.f, 0.f, -9.81f));
     _overlappingPairCallback = std::make_unique<btGhostPairCallback>();
@@ -108,12 +145,17 @@ GameWorld::~GameWorld() {
     pickupPool.clear();
     cutscenePool.clear();
     projectilePool.clear();
+
+    if (physicsScheduler) {
+        dynamicsWorld.reset();
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+    }
 }
 
 bool GameWorld::placeItems(const std::string& name) {
     LoaderIPL ipll;
 
-    if (ipll.load(name)) {
+    if (data->readIPL(name, ipll)) {
         // Find the object.
         for (const auto& inst : ipll.m_instances) {
             if (!createInstance(inst.id, inst.pos, inst.rot)) {
@@ -174,38 +216,11 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
 }
 
 void GameWorld::createTraffic(const ViewCamera& viewCamera) {
-    ai::TrafficDirector director(&aigraph, this);
-
-    director.populateNearby(viewCamera, kMaxTrafficSpawnRadius, 5);
+    trafficDirector->update(viewCamera, kMaxTrafficSpawnRadius);
 }
 
 void GameWorld::cleanupTraffic(const ViewCamera& focus) {
-    for (auto& p : pedestrianPool.objects) {
-        if (p.second->getLifetime() != GameObject::TrafficLifetime) {
-            continue;
-        }
-
-        if (glm::distance(focus.position, p.second->getPosition()) >=
-            kMaxTrafficCleanupRadius) {
-            if (!focus.frustum.intersects(p.second->getPosition(), 1.f)) {
-                destroyObjectQueued(p.second.get());
-            }
-        }
-    }
-    for (auto& p : vehiclePool.objects) {
-        if (p.second->getLifetime() != GameObject::TrafficLifetime) {
-            continue;
-        }
-
-        if (glm::distance(focus.position, p.second->getPosition()) >=
-            kMaxTrafficCleanupRadius) {
-            if (!focus.frustum.intersects(p.second->getPosition(), 1.f)) {
-                destroyObjectQueued(p.second.get());
-            }
-        }
-    }
-
-    destroyQueuedObjects();
+    trafficDirector->cleanup(focus, kMaxTrafficCleanupRadius);
 }
 
 CutsceneObject* GameWorld::createCutsceneObject(const uint16_t id,
@@ -361,6 +376,7 @@ CharacterObject* GameWorld::createPlayer(const glm::vec3& pos,
     std::string texturename = "player";
 
     data->loadTXD(texturename + ".txd");
+    data->textureResidency.pin(texturename);
     if (!pt->isLoaded()) {
         auto model = data->loadClump(modelname + ".dff");
         pt->setModel(model);
@@ -445,26 +461,34 @@ Payphone* GameWorld::createPayphone(const glm::vec2 coord) {
 
 void GameWorld::ObjectPool::insert(std::unique_ptr<GameObject> object) {
     if (object->getGameObjectID() == 0) {
-        // Find the lowest free GameObjectID.
-        GameObjectID availID = 1;
-        for (auto& [id, objectPtr] : objects) {
-            if (id == availID) availID++;
-        }
-
-        object->setGameObjectID(availID);
+        object->setGameObjectID(firstFree);
     }
-    objects[object->getGameObjectID()] = std::move(object);
-}
-
-GameObject* GameWorld::ObjectPool::find(GameObjectID id) const {
-    auto it = objects.find(id);
-    return (it == objects.end()) ? nullptr : it->second.get();
+    const auto id = object->getGameObjectID();
+    if (id >= handles.size()) {
+        handles.resize(id + 1u, nullptr);
+    }
+    // The object in use is replaced, as it always has been, but mustn't be
+    // left behind in the grid
+    if (auto old = handles[id]) {
+        RW_ERROR("GameObjectID " << id << " in use, replacing it");
+        grid.remove(old);
+    }
+    handles[id] = object.get();
+    while (firstFree < handles.size() && handles[firstFree] != nullptr) {
+        ++firstFree;
+    }
+    grid.insert(object.get());
+    objects[id] = std::move(object);
 }
 
 void GameWorld::ObjectPool::remove(GameObject* object) {
     if (object) {
         auto it = objects.find(object->getGameObjectID());
         if (it != objects.end()) {
+            const auto id = it->first;
+            handles[id] = nullptr;
+            firstFree = std::min(firstFree, id);
+            grid.remove(object);
             it = objects.erase(it);
         }
     }
@@ -472,6 +496,9 @@ void GameWorld::ObjectPool::remove(GameObject* object) {
 
 void GameWorld::ObjectPool::clear() {
     objects.clear();
+    handles.clear();
+    firstFree = 1;
+    grid.clear();
 }
 
 GameWorld::ObjectPool& GameWorld::getTypeObjectPool(GameObject* object) {
@@ -571,8 +598,7 @@ void GameWorld::destroyEffect(VisualFX& effect) {
 
 void GameWorld::doWeaponScan(const WeaponScan& scan) {
     if (scan.type == ScanType::Radius) {
-        HitTest test {*dynamicsWorld};
-        const auto& result = test.sphereTest(scan.center, scan.radius);
+        const auto result = queries->sphereTest(scan.center, scan.radius);
 
         for(const auto& target : result) {
             if (!scan.doesDamage(target.object)) {
@@ -587,22 +613,16 @@ void GameWorld::doWeaponScan(const WeaponScan& scan) {
         }
 
     } else if (scan.type == ScanType::HitScan) {
-        btVector3 from(scan.center.x, scan.center.y, scan.center.z),
-            to(scan.end.x, scan.end.y, scan.end.z);
-        btCollisionWorld::ClosestRayResultCallback cb(from, to);
-        cb.m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
-        dynamicsWorld->rayTest(from, to, cb);
-        if (!cb.hasHit()) {
+        const auto hit = queries->castRay(scan.center, scan.end, nullptr,
+                                          btBroadphaseProxy::AllFilter);
+        if (!hit.hit || !hit.object) {
             return;
         }
 
-        auto go = static_cast<GameObject *>(
-            cb.m_collisionObject->getUserPointer());
-        go->takeDamage(
+        hit.object->takeDamage(
             {
                 GameObject::DamageInfo::DamageType::Bullet,
-                {cb.m_hitPointWorld.x(), cb.m_hitPointWorld.y(),
-                 cb.m_hitPointWorld.z()},
+                hit.position,
                 scan.center, scan.damage
             });
     }
@@ -637,16 +657,11 @@ void GameWorld::offsetGameTime(int minutes) {
 }
 
 glm::vec3 GameWorld::getGroundAtPosition(const glm::vec3& pos) const {
-    btVector3 rayFrom(pos.x, pos.y, 100.f);
-    btVector3 rayTo(pos.x, pos.y, -100.f);
+    const auto hit = queries->castRay({pos.x, pos.y, 100.f},
+                                      {pos.x, pos.y, -100.f});
 
-    btDynamicsWorld::ClosestRayResultCallback rr(rayFrom, rayTo);
-
-    dynamicsWorld->rayTest(rayFrom, rayTo, rr);
-
-    if (rr.hasHit()) {
-        auto& ws = rr.m_hitPointWorld;
-        return {ws.x(), ws.y(), ws.z()};
+    if (hit.hit) {
+        return hit.position;
     }
 
     return pos;
@@ -657,37 +672,33 @@ float GameWorld::getGameTime() const {
 }
 
 namespace {
-void handleVehicleResponse(GameObject* object, btManifoldPoint& mp, bool isA) {
+void handleVehicleResponse(GameObject* object,
+                           const GameWorld::PhysicsContact& contact, bool isA) {
     bool isVehicle = object->type() == GameObject::Vehicle;
     if (!isVehicle) return;
-    if (mp.getAppliedImpulse() <= 100.f) return;
+    if (contact.impulse <= 100.f) return;
 
-    btVector3 src, dmg;
-    if (isA) {
-        src = mp.getPositionWorldOnB();
-        dmg = mp.getPositionWorldOnA();
-    } else {
-        src = mp.getPositionWorldOnA();
-        dmg = mp.getPositionWorldOnB();
-    }
+    const auto& src = isA ? contact.positionB : contact.positionA;
+    const auto& dmg = isA ? contact.positionA : contact.positionB;
 
     object->takeDamage({
                            GameObject::DamageInfo::DamageType::Physics,
-                           {dmg.x(), dmg.y(), dmg.z()},
-                           {src.x(), src.y(), src.z()},
+                           dmg,
+                           src,
                            0.f,
-                           mp.getAppliedImpulse()
+                           contact.impulse
                        });
 }
 
-void handleInstanceResponse(InstanceObject* instance, const btManifoldPoint& mp,
+void handleInstanceResponse(InstanceObject* instance,
+                            const GameWorld::PhysicsContact& contact,
                             bool isA) {
     if (!instance->dynamics) {
         return;
     }
 
-    auto dmg = isA ? mp.m_positionWorldOnA : mp.m_positionWorldOnB;
-    auto impulse = mp.getAppliedImpulse();
+    const auto& dmg = isA ? contact.positionA : contact.positionB;
+    auto impulse = contact.impulse;
 
     if (impulse <= 0.0f) {
         return;
@@ -698,8 +709,8 @@ void handleInstanceResponse(InstanceObject* instance, const btManifoldPoint& mp,
     const auto hp = std::max(0.f, impulse - kMinimumDamageImpulse);
     instance->takeDamage({
                              GameObject::DamageInfo::DamageType::Physics,
-                             {dmg.x(), dmg.y(), dmg.z()},
-                             {dmg.x(), dmg.y(), dmg.z()},
+                             dmg,
+                             dmg,
                              hp,
                              impulse
                          });
@@ -716,8 +727,30 @@ bool GameWorld::ContactProcessedCallback(btManifoldPoint& mp, void* body0,
         return false;
     }
 
-    GameObject* a = static_cast<GameObject*>(obA->getUserPointer());
-    GameObject* b = static_cast<GameObject*>(obB->getUserPointer());
+    const auto& pA = mp.getPositionWorldOnA();
+    const auto& pB = mp.getPositionWorldOnB();
+    PhysicsContact contact{static_cast<GameObject*>(obA->getUserPointer()),
+                           static_cast<GameObject*>(obB->getUserPointer()),
+                           {pA.x(), pA.y(), pA.z()},
+                           {pB.x(), pB.y(), pB.z()},
+                           mp.getAppliedImpulse()};
+
+    // Contacts may be reported from worker threads, the responses are
+    // deferred until the physics tick callback on the main thread.
+    auto world = contact.a->engine;
+    if (world->isPhysicsMultithreaded()) {
+        std::lock_guard<std::mutex> lock(world->contactMutex);
+        world->queuedContacts.push_back(contact);
+    } else {
+        handleContact(contact);
+    }
+
+    return true;
+}
+
+void GameWorld::handleContact(const PhysicsContact& contact) {
+    GameObject* a = contact.a;
+    GameObject* b = contact.b;
 
     bool aIsInstance = a && a->type() == GameObject::Instance;
     bool bIsInstance = b && b->type() == GameObject::Instance;
@@ -733,14 +766,12 @@ bool GameWorld::ContactProcessedCallback(btManifoldPoint& mp, void* body0,
             instance = static_cast<InstanceObject*>(b);
         }
 
-        handleInstanceResponse(instance, mp, aIsInstance);
+        handleInstanceResponse(instance, contact, aIsInstance);
     }
 
     // Handle vehicles
-    if (a) handleVehicleResponse(a, mp, true);
-    if (b) handleVehicleResponse(b, mp, false);
-
-    return true;
+    if (a) handleVehicleResponse(a, contact, true);
+    if (b) handleVehicleResponse(b, contact, false);
 }
 
 void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
@@ -748,6 +779,17 @@ void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
     RW_PROFILE_SCOPEC(__func__, MP_CYAN);
     GameWorld* world = static_cast<GameWorld*>(physWorld->getWorldUserInfo());
 
+    if (world->isPhysicsMultithreaded()) {
+        std::vector<PhysicsContact> contacts;
+        {
+            std::lock_guard<std::mutex> lock(world->contactMutex);
+            contacts.swap(world->queuedContacts);
+        }
+        for (const auto& contact : contacts) {
+            handleContact(contact);
+        }
+    }
+
     RW_PROFILE_COUNTER_SET("physicsTick/vehiclePool", world->vehiclePool.objects.size());
     for (auto& p : world->vehiclePool.objects) {
         RW_PROFILE_SCOPEC("VehicleObject", MP_THISTLE1);
@@ -770,31 +812,146 @@ void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
 }
 
 void GameWorld::loadCutscene(const std::string& name) {
-    auto datfile = data->index.openFile(name + ".dat");
-
+    RW_PROFILE_SCOPE(__func__);
     state->currentCutscene = CutsceneData();
+    state->currentCutscene->meta.name = name;
+    pendingCutsceneAnims.clear();
+    cutsceneStartPending = false;
+
+    // The index isn't modified after loading, but look the audio up here
+    // so the workers only touch the files
+    std::string audioName;
+    std::string audioPath;
+    for (const auto extension : {".mp3", ".wav"}) {
+        if (sound.isNullAudio()) {
+            break;
+        }
+        try {
+            audioPath = data->index.findFilePath("audio/" + name + extension)
+                            .string();
+            audioName = name + extension;
+            break;
+        } catch (const std::out_of_range&) {
+        }
+    }
+
+    cutsceneLoadStart = std::chrono::steady_clock::now();
+    cutsceneLoading = data->workers.submit([index = &data->index, name,
+                                            audioName, audioPath]() {
+        RW_PROFILE_SCOPE("loadCutscene");
+        auto start = std::chrono::steady_clock::now();
+        LoadedCutscene loaded;
+
+        try {
+            auto datfile = index->openFile(name + ".dat");
+            if (datfile.data) {
+                LoaderCutsceneDAT loaderdat;
+                loaderdat.load(loaded.tracks, datfile);
+            }
+
+            auto ifpfile = index->openFile(name + ".ifp");
+            if (LoaderIFP loader{};
+                ifpfile.data && loader.loadFromMemory(ifpfile.data.get())) {
+                loaded.animations = std::move(loader.animations);
+            }
+        } catch (const std::exception&) {
+            // Missing files leave the cutscene empty, as they did before
+        }
+
+        if (!audioPath.empty()) {
+            loaded.audioName = audioName;
+            loaded.audio = SoundManager::openMusic(audioPath);
+        }
 
-    if (datfile.data) {
-        LoaderCutsceneDAT loaderdat;
-        loaderdat.load(state->currentCutscene->tracks, datfile);
+        loaded.loadTime = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        return loaded;
+    });
+}
+
+bool GameWorld::updateCutsceneLoading() {
+    if (!cutsceneLoading.valid()) {
+        return true;
+    }
+    if (cutsceneLoading.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+        return false;
     }
+    finishCutsceneLoading();
+    return true;
+}
 
-    data->loadIFP(name + ".ifp", true);
-    cutsceneAudioLoaded = data->loadAudioStream(name + ".mp3");
+void GameWorld::waitForCutscene() {
+    if (cutsceneLoading.valid()) {
+        cutsceneLoading.wait();
+        finishCutsceneLoading();
+    }
+}
+
+void GameWorld::finishCutsceneLoading() {
+    RW_PROFILE_SCOPE(__func__);
+    auto loaded = cutsceneLoading.get();
+    auto& cutscene = *state->currentCutscene;
+    cutscene.tracks = std::move(loaded.tracks);
+    data->animationsCutscene.insert(loaded.animations.begin(),
+                                    loaded.animations.end());
 
-    if (!cutsceneAudioLoaded) {
-        cutsceneAudioLoaded = data->loadAudioStream(name + ".wav");
+    if (cutsceneAudio.length() > 0) {
+        sound.stopMusic(cutsceneAudio);
+    }
+    cutsceneAudioLoaded =
+        loaded.audio && sound.addMusic(loaded.audioName, loaded.audio);
+    if (cutsceneAudioLoaded) {
+        cutsceneAudio = loaded.audioName;
+    } else if (!sound.isNullAudio()) {
+        logger->warning("Data",
+                        "Failed to load cutscene audio: " + cutscene.meta.name);
     }
 
-    if (!cutsceneAudioLoaded) {
-        logger->warning("Data", "Failed to load cutscene audio: " + name);
+    auto waited = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - cutsceneLoadStart)
+                      .count();
+    logger->info("World", "Loaded cutscene: " + cutscene.meta.name + " in " +
+                              std::to_string(loaded.loadTime) +
+                              " ms, ready after " + std::to_string(waited) +
+                              " ms");
+
+    for (const auto& [id, name] : pendingCutsceneAnims) {
+        if (auto object = cutscenePool.find(id)) {
+            setCutsceneAnimation(object, name);
+        }
     }
+    pendingCutsceneAnims.clear();
 
-    state->currentCutscene->meta.name = name;
-    logger->info("World", "Loaded cutscene: " + name);
+    if (cutsceneStartPending) {
+        cutsceneStartPending = false;
+        startCutscene();
+    }
+}
+
+void GameWorld::setCutsceneAnimation(GameObject* object,
+                                     const std::string& name) {
+    if (!updateCutsceneLoading()) {
+        pendingCutsceneAnims.emplace_back(object->getGameObjectID(), name);
+        return;
+    }
+    auto it = data->animationsCutscene.find(name);
+    if (it != data->animationsCutscene.end() && it->second) {
+        object->animator->playAnimation(AnimIndexMovement, it->second, 1.f,
+                                        false);
+    } else {
+        logger->error("SCM", "Failed to load cutscene anim: " + name);
+    }
 }
 
 void GameWorld::startCutscene() {
+    // Start once everything is loaded so that the tracks, animations and
+    // audio are in sync
+    if (!updateCutsceneLoading()) {
+        cutsceneStartPending = true;
+        return;
+    }
     state->cutsceneStartTime = getGameTime();
     state->skipCutscene = false;
 
@@ -805,6 +962,12 @@ void GameWorld::startCutscene() {
 }
 
 void GameWorld::clearCutscene() {
+    // The workers finish reading a cutscene that is still loading, and the
+    // data is dropped with the future
+    cutsceneLoading = {};
+    pendingCutsceneAnims.clear();
+    cutsceneStartPending = false;
+
     eraseCutsceneObjects();
     eraseCutsceneSound();
     eraseCutsceneAnimations();
@@ -839,6 +1002,9 @@ bool GameWorld::isCutsceneDone() {
         if (state->skipCutscene) {
             return true;
         }
+        if (!updateCutsceneLoading() || cutsceneStartPending) {
+            return false;
+        }
         return time > state->currentCutscene->tracks.duration;
     }
     return true;
@@ -846,10 +1012,9 @@ bool GameWorld::isCutsceneDone() {
 
 void GameWorld::loadSpecialCharacter(const unsigned short index,
                                      const std::string& name) {
-    constexpr uint16_t kFirstSpecialActor = 26;
     logger->info("Data", "Loading special actor " + name + " to " +
                              std::to_string(index));
-    auto modelid = kFirstSpecialActor + index - 1;
+    auto modelid = getSpecialCharacterModel(index);
     auto model = data->findModelInfo<PedModelInfo>(modelid);
     if (model && model->isLoaded()) {
         model->unload();
@@ -858,6 +1023,7 @@ void GameWorld::loadSpecialCharacter(const unsigned short index,
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                    ::tolower);
     state->specialCharacters[index] = lowerName;
+    data->prefetchModel(modelid);
 }
 
 void GameWorld::loadSpecialModel(const unsigned short index,
@@ -873,6 +1039,7 @@ void GameWorld::loadSpecialModel(const unsigned short index,
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                    ::tolower);
     state->specialModels[index] = lowerName;
+    data->prefetchModel(index);
 }
 
 void GameWorld::disableAIPaths(ai::NodeType type, const glm::vec3& min,
@@ -886,6 +1053,7 @@ void GameWorld::disableAIPaths(ai::NodeType type, const glm::vec3& min,
             }
         }
     }
+    routePlanner->invalidate();
 }
 
 void GameWorld::enableAIPaths(ai::NodeType type, const glm::vec3& min,
@@ -899,6 +1067,7 @@ void GameWorld::enableAIPaths(ai::NodeType type, const glm::vec3& min,
             }
         }
     }
+    routePlanner->invalidate();
 }
 
 void GameWorld::drawAreaIndicator(AreaIndicatorInfo::AreaIndicatorType type,
@@ -910,6 +1079,94 @@ void GameWorld::clearTickData() {
     areaIndicators.clear();
 }
 
+void GameWorld::tickTime(float dt) {
+    chase.update(dt);
+
+    // Clear out any per-tick state.
+    clearTickData();
+
+    state->gameTime += dt;
+
+    clockAccumulator += dt;
+    while (clockAccumulator >= 1.f) {
+        state->basic.gameMinute++;
+        while (state->basic.gameMinute >= 60) {
+            state->basic.gameMinute = 0;
+            state->basic.gameHour++;
+            while (state->basic.gameHour >= 24) {
+                state->basic.gameHour = 0;
+            }
+        }
+        clockAccumulator -= 1.f;
+    }
+
+    constexpr float timerClockRate = 1.f / 30.f;
+
+    if (state->scriptTimerVariable && !state->scriptTimerPaused) {
+        scriptTimerAccumulator += dt;
+        while (scriptTimerAccumulator >= timerClockRate &&
+               state->scriptTimerVariable) {
+            // Original game uses milliseconds
+            (*state->scriptTimerVariable) -= timerClockRate * 1000;
+
+            //                                11 seconds
+            if (*state->scriptTimerVariable <= 11000 &&
+                beepTime - *state->scriptTimerVariable >= 1000) {
+                beepTime = *state->scriptTimerVariable;
+
+                // @todo beep
+            }
+
+            if (*state->scriptTimerVariable <= 0) {
+                (*state->scriptTimerVariable) = 0;
+                state->scriptTimerVariable = nullptr;
+            }
+
+            scriptTimerAccumulator -= timerClockRate;
+        }
+    }
+}
+
+void GameWorld::tickObjects(float dt) {
+    RW_PROFILE_SCOPEC(__func__, MP_MAGENTA1);
+    updateEffects();
+
+    {
+        RW_PROFILE_SCOPEC("allObjects", MP_HOTPINK1);
+        RW_PROFILE_COUNTER_SET("tickObjects/allObjects", allObjects.size());
+        for (auto& object : allObjects) {
+            object->tick(dt);
+        }
+    }
+
+    {
+        RW_PROFILE_SCOPEC("garages", MP_HOTPINK2);
+        for (auto& g : garages) {
+            g->tick(dt);
+        }
+    }
+
+    {
+        RW_PROFILE_SCOPEC("payphones", MP_HOTPINK3);
+        for (auto& p : payphones) {
+            p->tick(dt);
+        }
+    }
+
+    destroyQueuedObjects();
+
+    state->text.tick(dt);
+}
+
+void GameWorld::updateTraffic(ViewCamera& camera) {
+    camera.frustum.update(camera.frustum.projection() * camera.getView());
+    cleanupTraffic(camera);
+    // Only create new traffic outside cutscenes
+    if (!state->currentCutscene) {
+        createTraffic(camera);
+    }
+}
+
 void GameWorld::setPaused(bool pause) {
     paused = pause;
     bool resumingCutscene = !pause && !isCutsceneDone();
@@ -1006,26 +1263,14 @@ bool GameWorld::isRaining() const {
 void GameWorld::clearObjectsWithinArea(const glm::vec3 center,
                                        const float radius,
                                        const bool clearParticles) {
-    // Vehicles
-    for (auto& obj : vehiclePool.objects) {
-        if (!obj.second->canBeRemoved()) {
-            continue;
-        }
-
-        if (glm::distance(center, obj.second->getPosition()) < radius) {
-            destroyObjectQueued(obj.second.get());
-        }
-    }
-
-    // Peds
-    for (auto& obj : pedestrianPool.objects) {
-        if (!obj.second->canBeRemoved()) {
-            continue;
-        }
-
-        if (glm::distance(center, obj.second->getPosition()) < radius) {
-            destroyObjectQueued(obj.second.get());
-        }
+    std::vector<GameObject*> objects;
+    const auto removable = [](GameObject* object) {
+        return object->canBeRemoved();
+    };
+    vehiclePool.getGrid().findWithin(center, radius, objects, removable);
+    pedestrianPool.getGrid().findWithin(center, radius, objects, removable);
+    for (auto object : objects) {
+        destroyObjectQueued(object);
     }
 
     /// @todo Do we also have to clear all projectiles + particles *in this
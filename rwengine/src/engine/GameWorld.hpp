@@ -1,9 +1,13 @@
 #ifndef _RWENGINE_GAMEWORLD_HPP_
 #define _RWENGINE_GAMEWORLD_HPP_
 
+#include <chrono>
 #include <cstdint>
+#include <future>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <set>
 #include <string>
@@ -20,17 +24,22 @@
 #include <ai/AIGraph.hpp>
 #include <audio/SoundManager.hpp>
 #include <data/Chase.hpp>
+#include <data/CutsceneData.hpp>
 #include <engine/Garage.hpp>
+#include <engine/ObjectGrid.hpp>
 #include <objects/ObjectTypes.hpp>
+#include <rw/forward.hpp>
 
 class btCollisionDispatcher;
+class btConstraintSolver;
 class btDefaultCollisionConfiguration;
 class btDiscreteDynamicsWorld;
 class btDynamicsWorld;
 class btManifoldPoint;
 class btOverlappingPairCallback;
-class btSequentialImpulseConstraintSolver;
 struct btDbvtBroadphase;
+class BulletTaskScheduler;
+class PhysicsQueries;
 
 class GameState;
 class Garage;
@@ -38,6 +47,8 @@ class Payphone;
 
 namespace ai {
 class PlayerController;
+class RoutePlanner;
+class TrafficDirector;
 }  // namespace ai
 
 class Logger;
@@ -80,7 +91,13 @@ struct AreaIndicatorInfo {
  */
 class GameWorld {
 public:
-    GameWorld(Logger* log, GameData* dat);
+    /**
+     * @param multithreadedPhysics Use Bullet's multithreaded dynamics world,
+     * running on the GameData's worker threads.
+     * @param nullAudio Run without an audio device, see SoundManager
+     */
+    GameWorld(Logger* log, GameData* dat, bool multithreadedPhysics = false,
+              bool nullAudio = false);
 
     ~GameWorld();
 
@@ -98,7 +115,8 @@ public:
      *
      * The position and frustum of the passed in camera is used to determine
      * the radius where traffic can be spawned, and the frustum is used to avoid
-     * spawning traffic in view of the player.
+     * spawning traffic in view of the player. Only a few objects are
+     * created per call, so the area is populated over several ticks.
      */
     void createTraffic(const ViewCamera& viewCamera);
 
@@ -255,8 +273,8 @@ public:
         std::map<GameObjectID, std::unique_ptr<GameObject>> objects;
 
         /**
-         * Allocates the game object a GameObjectID and inserts it into
-         * the pool
+         * Allocates the game object the lowest free GameObjectID and inserts
+         * it into the pool
          */
         void insert(std::unique_ptr<GameObject> object);
 
@@ -268,12 +286,36 @@ public:
         /**
          * Finds a game object if it exists in this pool
          */
-        GameObject* find(GameObjectID id) const;
+        GameObject* find(GameObjectID id) const {
+            return id < handles.size() ? handles[id] : nullptr;
+        }
 
         /**
          * Removes all stored objects
          */
         void clear();
+
+        /**
+         * Objects bucketed by world cell
+         */
+        const ObjectGrid& getGrid() const {
+            return grid;
+        }
+
+        /**
+         * Moves an object of this pool to the grid cell of its position
+         */
+        void updateGrid(GameObject* object) {
+            grid.move(object);
+        }
+
+    private:
+        /// Objects indexed by GameObjectID, for script handle lookups
+        std::vector<GameObject*> handles;
+        /// All IDs below this are in use
+        GameObjectID firstFree = 1;
+
+        ObjectGrid grid;
     };
 
     /**
@@ -313,6 +355,16 @@ public:
      */
     ai::AIGraph aigraph;
 
+    /**
+     * Route searches over aigraph
+     */
+    std::unique_ptr<ai::RoutePlanner> routePlanner;
+
+    /**
+     * Spawns and removes traffic around the camera, see createTraffic
+     */
+    std::unique_ptr<ai::TrafficDirector> trafficDirector;
+
     /**
      * Visual Effects
      * @todo Consider using lighter handing mechanism
@@ -325,9 +377,19 @@ public:
     std::unique_ptr<btDefaultCollisionConfiguration> collisionConfig;
     std::unique_ptr<btCollisionDispatcher> collisionDispatcher;
     std::unique_ptr<btDbvtBroadphase> broadphase;
-    std::unique_ptr<btSequentialImpulseConstraintSolver> solver;
+    std::unique_ptr<btConstraintSolver> solver;
     std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld;
 
+    bool isPhysicsMultithreaded() const {
+        return physicsScheduler != nullptr;
+    }
+
+    /**
+     * Batched ray and sphere queries against dynamicsWorld, flushed once per
+     * simulation step.
+     */
+    std::unique_ptr<PhysicsQueries> queries;
+
     /**
      * @brief physicsNearCallback
      * Used to implement uprooting and other physics oddities.
@@ -335,6 +397,22 @@ public:
     static bool ContactProcessedCallback(btManifoldPoint& mp, void* body0,
                                          void* body1);
 
+    /**
+     * @brief Contact information passed to the collision responses
+     */
+    struct PhysicsContact {
+        GameObject* a;
+        GameObject* b;
+        glm::vec3 positionA;
+        glm::vec3 positionB;
+        float impulse;
+    };
+
+    /**
+     * @brief Applies damage and uprooting for a contact
+     */
+    static void handleContact(const PhysicsContact& contact);
+
     /**
      * @brief PhysicsTickCallback updates object each physics tick.
      * @param physWorld
@@ -344,7 +422,11 @@ public:
                                     btScalar timeStep);
 
     /**
-     * @brief Loads and starts the named cutscene.
+     * @brief Starts loading the named cutscene.
+     *
+     * The tracks, animations and audio are read and decoded on the data
+     * workers and swapped in by updateCutsceneLoading once they are all
+     * ready, starting the cutscene if startCutscene was called meanwhile.
      * @param name
      */
     void loadCutscene(const std::string& name);
@@ -352,6 +434,22 @@ public:
     void clearCutscene();
     bool isCutsceneDone();
 
+    /**
+     * @brief Swaps in the loaded cutscene if the workers are done with it
+     * @return true if no cutscene is loading
+     */
+    bool updateCutsceneLoading();
+
+    /**
+     * @brief Blocks until the loading cutscene has been swapped in
+     */
+    void waitForCutscene();
+
+    /**
+     * @brief Plays a cutscene animation on object, once it is loaded
+     */
+    void setCutsceneAnimation(GameObject* object, const std::string& name);
+
     void eraseCutsceneObjects();
     void eraseCutsceneSound();
     void eraseCutsceneAnimations();
@@ -367,6 +465,14 @@ public:
                               const std::string& name);
     void loadSpecialModel(const unsigned short index, const std::string& name);
 
+    /**
+     * @return The model ID used by a special character slot
+     */
+    static uint16_t getSpecialCharacterModel(const unsigned short index) {
+        constexpr uint16_t kFirstSpecialActor = 26;
+        return kFirstSpecialActor + index - 1;
+    }
+
     void disableAIPaths(ai::NodeType type, const glm::vec3& min,
                         const glm::vec3& max);
     void enableAIPaths(ai::NodeType type, const glm::vec3& min,
@@ -381,6 +487,27 @@ public:
 
     void clearTickData();
 
+    /**
+     * Start a tick: clear the per-tick state and advance the chase, the
+     * game clock and the script timer by dt.
+     *
+     * The world update is split into tickTime, tickObjects and updateTraffic
+     * so the game and rwheadless run the same steps in the same order.
+     */
+    void tickTime(float dt);
+
+    /**
+     * Tick the objects, garages and payphones, destroy the objects queued
+     * for deletion and tick the on screen text
+     */
+    void tickObjects(float dt);
+
+    /**
+     * Remove traffic far from camera and spawn new traffic around it,
+     * except during cutscenes. Updates the camera's frustum.
+     */
+    void updateTraffic(ViewCamera& camera);
+
     void setPaused(bool pause);
     bool isPaused() const;
 
@@ -402,6 +529,13 @@ public:
 
     ai::PlayerController* getPlayer();
 
+    /**
+     * @brief Restarts the random number sequence, for reproducible runs
+     */
+    void setRandomSeed(unsigned int seed) {
+        randomNumberGen.seed(seed);
+    }
+
     template <
         typename T1, typename T2 = T1,
         typename std::enable_if<std::is_integral<T1>::value>::type* = nullptr,
@@ -430,6 +564,33 @@ private:
 
     std::vector<AreaIndicatorInfo> areaIndicators;
 
+    /// Game time that hasn't advanced the game clock yet
+    float clockAccumulator = 0.f;
+    /// Game time that hasn't counted down the script timer yet
+    float scriptTimerAccumulator = 0.f;
+    /// Script timer value at the last beep
+    int32_t beepTime = std::numeric_limits<int32_t>::max();
+
+    /**
+     * The cutscene data that is read off the main thread
+     */
+    struct LoadedCutscene {
+        CutsceneTracks tracks;
+        AnimationSet animations;
+        std::string audioName;
+        std::shared_ptr<SoundSource> audio;
+        /// Time taken by the workers in ms
+        double loadTime = 0.;
+    };
+
+    void finishCutsceneLoading();
+
+    std::future<LoadedCutscene> cutsceneLoading;
+    std::chrono::steady_clock::time_point cutsceneLoadStart;
+    /// set_cutscene_anim calls made while the animations were loading
+    std::vector<std::pair<GameObjectID, std::string>> pendingCutsceneAnims;
+    bool cutsceneStartPending = false;
+
     /**
      * Flag for pausing the simulation
      */
@@ -440,6 +601,14 @@ private:
      */
     std::unique_ptr<btOverlappingPairCallback> _overlappingPairCallback;
 
+    /**
+     * Multithreaded physics: Bullet's view of the worker threads, and the
+     * contacts reported from them, which are handled in PhysicsTickCallback
+     */
+    std::unique_ptr<BulletTaskScheduler> physicsScheduler;
+    std::mutex contactMutex;
+    std::vector<PhysicsContact> queuedContacts;
+
     /**
      * Randomness Engine
      */
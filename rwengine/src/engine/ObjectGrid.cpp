@@ -0,0 +1,108 @@
+#include "engine/ObjectGrid.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/common.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include "objects/GameObject.hpp"
+
+void ObjectGrid::clear() {
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+    objectCells.clear();
+}
+
+void ObjectGrid::insert(GameObject* object) {
+    const auto cell = cellIndex(object->getPosition());
+    cells[cell].push_back(object);
+    objectCells[object] = cell;
+}
+
+void ObjectGrid::remove(GameObject* object) {
+    auto it = objectCells.find(object);
+    if (it == objectCells.end()) {
+        return;
+    }
+    removeFromCell(it->second, object);
+    objectCells.erase(it);
+}
+
+void ObjectGrid::move(GameObject* object) {
+    auto it = objectCells.find(object);
+    if (it == objectCells.end()) {
+        return;
+    }
+    const auto cell = cellIndex(object->getPosition());
+    if (cell == it->second) {
+        return;
+    }
+    removeFromCell(it->second, object);
+    cells[cell].push_back(object);
+    it->second = cell;
+}
+
+void ObjectGrid::removeFromCell(std::size_t cell, GameObject* object) {
+    auto& objects = cells[cell];
+    auto it = std::find(objects.begin(), objects.end(), object);
+    if (it != objects.end()) {
+        *it = objects.back();
+        objects.pop_back();
+    }
+}
+
+glm::ivec2 ObjectGrid::cellCoord(const glm::vec2& world) {
+    const float lowerCoord = -(WORLD_GRID_SIZE) / 2.f;
+    auto coord = glm::ivec2(glm::floor((world - glm::vec2(lowerCoord)) /
+                                       glm::vec2(WORLD_CELL_SIZE)));
+    return glm::clamp(coord, glm::ivec2(0),
+                      glm::ivec2(static_cast<int>(WORLD_GRID_WIDTH) - 1));
+}
+
+std::size_t ObjectGrid::cellIndex(const glm::vec3& position) {
+    const auto cell = cellCoord(glm::vec2(position));
+    return cell.x * WORLD_GRID_WIDTH + cell.y;
+}
+
+GameObject* ObjectGrid::findNearest(const glm::vec3& center, float radius,
+                                    const Filter& filter) const {
+    GameObject* nearest = nullptr;
+    float nearestDistance = radius * radius;
+    const auto planar = glm::vec2(center);
+    visit(planar - glm::vec2(radius), planar + glm::vec2(radius),
+          [&](GameObject* object) {
+              const float d = glm::distance2(center, object->getPosition());
+              if (d > nearestDistance || (filter && !filter(object))) {
+                  return false;
+              }
+              if (d < nearestDistance || nearest == nullptr ||
+                  object->getGameObjectID() < nearest->getGameObjectID()) {
+                  nearest = object;
+                  nearestDistance = d;
+              }
+              return false;
+          });
+    return nearest;
+}
+
+void ObjectGrid::findWithin(const glm::vec3& center, float radius,
+                            std::vector<GameObject*>& out,
+                            const Filter& filter) const {
+    const auto first = out.size();
+    const auto planar = glm::vec2(center);
+    visit(planar - glm::vec2(radius), planar + glm::vec2(radius),
+          [&](GameObject* object) {
+              if (glm::distance2(center, object->getPosition()) <
+                      radius * radius &&
+                  (!filter || filter(object))) {
+                  out.push_back(object);
+              }
+              return false;
+          });
+    std::sort(out.begin() + first, out.end(),
+              [](const GameObject* a, const GameObject* b) {
+                  return a->getGameObjectID() < b->getGameObjectID();
+              });
+}
@@ -0,0 +1,92 @@
+#ifndef _RWENGINE_OBJECTGRID_HPP_
+#define _RWENGINE_OBJECTGRID_HPP_
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <rw/types.hpp>
+
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class GameObject;
+
+/**
+ * @brief Buckets game objects by world grid cell for area queries
+ *
+ * Cells are WORLD_CELL_SIZE wide, objects outside of the grid are stored in
+ * the closest cell. Its pool inserts and removes objects as they are added
+ * to and removed from the pool, and objects tell it when their position
+ * changes, so an object is only moved to another bucket when its cell
+ * changes. Results are tested against the current positions.
+ */
+class ObjectGrid {
+public:
+    using Filter = std::function<bool(GameObject*)>;
+
+    /// Adds the object to the cell of its position
+    void insert(GameObject* object);
+
+    void remove(GameObject* object);
+
+    /// Moves the object to the cell of its position, if it was inserted
+    void move(GameObject* object);
+
+    void clear();
+
+    /**
+     * Calls visitor with each object in the cells covering the rectangle,
+     * stopping early if visitor returns true.
+     * @return true if visitor returned true
+     */
+    template <class F>
+    bool visit(const glm::vec2& min, const glm::vec2& max, F&& visitor) const {
+        const auto lower = cellCoord(min);
+        const auto upper = cellCoord(max);
+        for (int x = lower.x; x <= upper.x; ++x) {
+            for (int y = lower.y; y <= upper.y; ++y) {
+                for (const auto object : cells[x * WORLD_GRID_WIDTH + y]) {
+                    if (visitor(object)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Finds the closest object within radius of center
+     * @param filter Optional predicate that the object must satisfy
+     * @return The closest object, the lowest GameObjectID on ties, or
+     * nullptr if none matched
+     */
+    GameObject* findNearest(const glm::vec3& center, float radius,
+                            const Filter& filter = {}) const;
+
+    /**
+     * @brief Appends the objects within radius of center to out, in
+     * GameObjectID order
+     */
+    void findWithin(const glm::vec3& center, float radius,
+                    std::vector<GameObject*>& out,
+                    const Filter& filter = {}) const;
+
+    std::size_t size() const {
+        return objectCells.size();
+    }
+
+private:
+    static glm::ivec2 cellCoord(const glm::vec2& world);
+    static std::size_t cellIndex(const glm::vec3& position);
+
+    void removeFromCell(std::size_t cell, GameObject* object);
+
+    std::array<std::vector<GameObject*>, WORLD_GRID_CELLS> cells;
+    /// The cell each object is stored in
+    std::unordered_map<GameObject*, std::size_t> objectCells;
+};
+
+#endif
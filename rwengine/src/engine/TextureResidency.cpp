@@ -0,0 +1,108 @@
+#include "engine/TextureResidency.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "core/Profiler.hpp"
+
+void TextureResidency::add(const std::string& slot,
+                           const TextureArchive& textures) {
+    auto& entry = tracked[slot];
+    residentBytes -= entry.bytes;
+    entry.bytes = 0;
+    for (const auto& [name, texture] : textures) {
+        if (texture) {
+            entry.bytes += texture->getMemorySize();
+        }
+    }
+    entry.loadedFrame = frame;
+    residentBytes += entry.bytes;
+}
+
+void TextureResidency::pin(const std::string& slot) {
+    auto it = tracked.find(slot);
+    if (it != tracked.end()) {
+        it->second.pinned = true;
+    }
+}
+
+void TextureResidency::bind(const std::string& slot,
+                            const GeometryPtr& geometry) {
+    auto& geometries = bindings[slot];
+    geometries.erase(std::remove_if(geometries.begin(), geometries.end(),
+                                    [](const std::weak_ptr<Geometry>& g) {
+                                        return g.expired();
+                                    }),
+                     geometries.end());
+    geometries.push_back(geometry);
+}
+
+bool TextureResidency::isBound(const std::string& slot) {
+    auto it = bindings.find(slot);
+    if (it == bindings.end()) {
+        return false;
+    }
+    for (const auto& geometry : it->second) {
+        if (!geometry.expired()) {
+            return true;
+        }
+    }
+    bindings.erase(it);
+    return false;
+}
+
+std::size_t TextureResidency::evict(
+    std::unordered_map<std::string, TextureArchive>& slots,
+    const std::unordered_set<std::string>& referenced) {
+    if (!isOverBudget()) {
+        return 0;
+    }
+    RW_PROFILE_SCOPE(__func__);
+
+    struct Candidate {
+        std::uint64_t lastUsed;
+        const std::string* slot;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto& [name, entry] : tracked) {
+        // Materials keep raw pointers to the textures, so they must stay
+        // until the geometry is gone
+        if (entry.pinned || referenced.count(name) != 0 || isBound(name)) {
+            continue;
+        }
+        auto lastUsed = entry.loadedFrame;
+        auto it = slots.find(name);
+        if (it != slots.end()) {
+            for (const auto& [textureName, texture] : it->second) {
+                if (texture) {
+                    lastUsed = std::max(lastUsed, texture->getLastUsedFrame());
+                }
+            }
+        }
+        if (frame - lastUsed >= kMinIdleFrames) {
+            candidates.push_back({lastUsed, &name});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) {
+                  return a.lastUsed < b.lastUsed;
+              });
+
+    std::size_t evicted = 0;
+    for (const auto& candidate : candidates) {
+        if (!isOverBudget()) {
+            break;
+        }
+        // Copied, the key goes away with the entry
+        const auto name = *candidate.slot;
+        const auto bytes = tracked[name].bytes;
+        slots.erase(name);
+        tracked.erase(name);
+        residentBytes -= bytes;
+        evictedBytes += bytes;
+        evictionCount++;
+        evicted++;
+    }
+    RW_PROFILE_COUNTER_ADD("textures/evictions", evicted);
+    return evicted;
+}
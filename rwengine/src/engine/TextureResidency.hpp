@@ -0,0 +1,112 @@
+#ifndef _RWENGINE_TEXTURERESIDENCY_HPP_
+#define _RWENGINE_TEXTURERESIDENCY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <gl/TextureData.hpp>
+#include <rw/forward.hpp>
+
+/**
+ * @brief Keeps the texture slots loaded for models within a memory budget
+ *
+ * The renderer marks the textures it draws with the current frame. Once the
+ * tracked slots use more than the budget, the slots that were used the
+ * longest ago are evicted, skipping those that loaded models or live
+ * geometry still point to. Evicted slots are loaded again by loadTXD when a
+ * model needs them.
+ *
+ * Only slots added with add() count towards the budget, the HUD, font,
+ * particle and radar slots stay resident.
+ */
+class TextureResidency {
+public:
+    static constexpr std::size_t kDefaultBudget = 256 * 1024 * 1024;
+    /// Slots used within this many frames are never evicted
+    static constexpr std::uint64_t kMinIdleFrames = 60;
+
+    /// Start a new frame
+    /// @return The number of the frame
+    std::uint64_t beginFrame() {
+        return ++frame;
+    }
+
+    std::uint64_t getFrame() const {
+        return frame;
+    }
+
+    void setBudget(std::size_t bytes) {
+        budget = bytes;
+    }
+
+    std::size_t getBudget() const {
+        return budget;
+    }
+
+    /// Track a slot that may be evicted, after its textures are loaded
+    void add(const std::string& slot, const TextureArchive& textures);
+
+    /// Keep a tracked slot resident, for textures used outside of models
+    void pin(const std::string& slot);
+
+    /// Keep a slot resident while the geometry, whose materials point to
+    /// the slot's textures, is alive
+    void bind(const std::string& slot, const GeometryPtr& geometry);
+
+    /// Whether live geometry still points to the slot's textures
+    bool isBound(const std::string& slot);
+
+    /**
+     * Evict the least recently used slots from slots, until the tracked
+     * slots fit in the budget
+     * @param referenced Slots of the loaded models, which are kept along
+     * with the bound slots
+     * @return Number of slots evicted
+     */
+    std::size_t evict(std::unordered_map<std::string, TextureArchive>& slots,
+                      const std::unordered_set<std::string>& referenced);
+
+    bool isOverBudget() const {
+        return residentBytes > budget;
+    }
+
+    bool isTracked(const std::string& slot) const {
+        return tracked.count(slot) != 0;
+    }
+
+    std::size_t getResidentBytes() const {
+        return residentBytes;
+    }
+
+    std::size_t getEvictionCount() const {
+        return evictionCount;
+    }
+
+    std::size_t getEvictedBytes() const {
+        return evictedBytes;
+    }
+
+private:
+    struct Slot {
+        std::size_t bytes = 0;
+        std::uint64_t loadedFrame = 0;
+        bool pinned = false;
+    };
+
+    std::unordered_map<std::string, Slot> tracked;
+    /// Geometry that points to each slot's textures, by slot
+    std::unordered_map<std::string, std::vector<std::weak_ptr<Geometry>>>
+        bindings;
+    std::uint64_t frame = 0;
+    std::size_t budget = kDefaultBudget;
+    std::size_t residentBytes = 0;
+    std::size_t evictionCount = 0;
+    std::size_t evictedBytes = 0;
+};
+
+#endif
@@ -4,58 +4,211 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <memory>
 
-bool findKeyframes(float t, AnimationBone* bone, AnimationKeyframe& f1,
-                   AnimationKeyframe& f2, float& alpha) {
-    for (size_t f = 0; f < bone->frames.size(); ++f) {
-        if (t <= bone->frames[f].starttime) {
-            f2 = bone->frames[f];
-
-            if (f == 0) {
-                if (bone->frames.size() != 1) {
-                    f1 = bone->frames.back();
-                } else {
-                    f1 = f2;
-                }
-            } else {
-                f1 = bone->frames[f - 1];
-            }
+namespace {
+constexpr float kRotationRange = 0.70710678f;  // 1 / sqrt(2)
+/// Components are stored in 15 bits with 0 at the center, so that zero is
+/// exact
+constexpr int kRotationCenter = 0x3FFF;
+constexpr std::uint16_t kRotationMask = 0x7FFF;
+constexpr std::uint16_t kRotationIndexBit = 0x8000;
+constexpr float kPositionMax = 65535.f;
 
-            float tdiff = (f2.starttime - f1.starttime);
-            if (tdiff == 0.f) {
-                alpha = 1.f;
-            } else {
-                alpha = glm::clamp((t - f1.starttime) / tdiff, 0.f, 1.f);
-            }
+std::uint16_t packComponent(float v) {
+    auto unit = glm::clamp(v / kRotationRange, -1.f, 1.f);
+    return static_cast<std::uint16_t>(std::lround(unit * kRotationCenter) +
+                                      kRotationCenter);
+}
+
+float unpackComponent(std::uint16_t v) {
+    return (int(v & kRotationMask) - kRotationCenter) /
+           float(kRotationCenter) * kRotationRange;
+}
+}  // namespace
+
+AnimationBlob::PackedRotation AnimationBlob::packRotation(
+    const glm::quat& rotation) {
+    const auto q = glm::normalize(rotation);
+    float c[4] = {q.x, q.y, q.z, q.w};
+
+    // Drop the largest component, it is recovered from the others since the
+    // quaternion is normalized. q and -q are the same rotation, so the
+    // dropped component is made positive.
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::abs(c[i]) > std::abs(c[largest])) {
+            largest = i;
+        }
+    }
+    const float sign = c[largest] < 0.f ? -1.f : 1.f;
+
+    PackedRotation packed{};
+    for (int i = 0, o = 0; i < 4; ++i) {
+        if (i != largest) {
+            packed[o++] = packComponent(c[i] * sign);
+        }
+    }
+    if (largest & 1) {
+        packed[0] |= kRotationIndexBit;
+    }
+    if (largest & 2) {
+        packed[1] |= kRotationIndexBit;
+    }
+    return packed;
+}
 
-            return true;
+glm::quat AnimationBlob::unpackRotation(const PackedRotation& packed) {
+    const int largest = ((packed[0] & kRotationIndexBit) ? 1 : 0) |
+                        ((packed[1] & kRotationIndexBit) ? 2 : 0);
+    float c[4];
+    float sum = 0.f;
+    for (int i = 0, o = 0; i < 4; ++i) {
+        if (i != largest) {
+            c[i] = unpackComponent(packed[o++]);
+            sum += c[i] * c[i];
         }
     }
-    return false;
+    c[largest] = std::sqrt(std::max(0.f, 1.f - sum));
+    return glm::normalize(glm::quat(c[3], c[0], c[1], c[2]));
+}
+
+std::size_t AnimationBlob::getMemoryUsage() const {
+    return sizeof(*this) + times.capacity() * sizeof(float) +
+           rotations.capacity() * sizeof(PackedRotation) +
+           positions.capacity() * sizeof(PackedPosition) +
+           scales.capacity() * sizeof(glm::vec3);
+}
+
+AnimationKeyframe AnimationBone::getFrame(std::uint32_t i) const {
+    AnimationKeyframe frame;
+    const auto index = firstFrame + i;
+    frame.rotation = AnimationBlob::unpackRotation(blob->rotations[index]);
+    frame.starttime = blob->times[index];
+    frame.id = static_cast<int>(i);
+    if (type != R00) {
+        const auto& p = blob->positions[firstPosition + i];
+        frame.position = positionMin + glm::vec3(p[0], p[1], p[2]) /
+                                           kPositionMax * positionExtent;
+    }
+    if (type == RTS) {
+        frame.scale = blob->scales[firstScale + i];
+    }
+    return frame;
 }
 
-AnimationKeyframe AnimationBone::getInterpolatedKeyframe(float time) {
-    AnimationKeyframe f1, f2;
-    float alpha;
+AnimationKeyframe AnimationBone::getInterpolatedKeyframe(float time) const {
+    if (empty()) {
+        return {};
+    }
+    const auto begin = blob->times.begin() + firstFrame;
+    const auto end = begin + frameCount;
+
+    // The first frame at or after time
+    const auto next = std::lower_bound(begin, end, time);
+    if (next == end) {
+        return getFrame(frameCount - 1);
+    }
+
+    const auto f = static_cast<std::uint32_t>(next - begin);
+    const auto f2 = getFrame(f);
+    // Before the first frame, blend from the last one
+    const auto f1 = f != 0 ? getFrame(f - 1)
+                           : frameCount != 1 ? getFrame(frameCount - 1) : f2;
 
-    if (findKeyframes(time, this, f1, f2, alpha)) {
-        return {glm::normalize(glm::slerp(f1.rotation, f2.rotation, alpha)),
-                glm::mix(f1.position, f2.position, alpha),
-                glm::mix(f1.scale, f2.scale, alpha), time,
-                std::max(f1.id, f2.id)};
+    float alpha = 1.f;
+    float tdiff = (f2.starttime - f1.starttime);
+    if (tdiff != 0.f) {
+        alpha = glm::clamp((time - f1.starttime) / tdiff, 0.f, 1.f);
     }
 
-    return frames.back();
+    return {glm::normalize(glm::slerp(f1.rotation, f2.rotation, alpha)),
+            glm::mix(f1.position, f2.position, alpha),
+            glm::mix(f1.scale, f2.scale, alpha), time, std::max(f1.id, f2.id)};
+}
+
+AnimationKeyframe AnimationBone::getKeyframe(float time) const {
+    if (empty()) {
+        return {};
+    }
+    const auto begin = blob->times.begin() + firstFrame;
+    const auto end = begin + frameCount;
+    const auto after = std::upper_bound(begin, end, time);
+    const auto f = after == begin ? 0 : (after - begin) - 1;
+    return getFrame(static_cast<std::uint32_t>(f));
 }
 
-AnimationKeyframe AnimationBone::getKeyframe(float time) {
-    for (auto &frame : frames) {
-        if (time >= frame.starttime) {
-            return frame;
+AnimationBone& Animation::addBone(const std::string& name,
+                                  AnimationBone::Data type,
+                                  const std::vector<AnimationKeyframe>& frames) {
+    auto it = std::lower_bound(
+        bones.begin(), bones.end(), name,
+        [](const AnimationBone& b, const std::string& n) { return b.name < n; });
+    if (it != bones.end() && it->name == name) {
+        return *it;
+    }
+
+    if (!blob) {
+        blob = std::make_shared<AnimationBlob>();
+    }
+
+    AnimationBone bone;
+    bone.name = name;
+    bone.type = type;
+    bone.blob = blob.get();
+    bone.firstFrame = static_cast<std::uint32_t>(blob->times.size());
+    bone.frameCount = static_cast<std::uint32_t>(frames.size());
+    bone.duration = frames.empty() ? 0.f : frames.back().starttime;
+
+    for (const auto& frame : frames) {
+        blob->times.push_back(frame.starttime);
+        blob->rotations.push_back(AnimationBlob::packRotation(frame.rotation));
+    }
+
+    if (type != AnimationBone::R00 && !frames.empty()) {
+        glm::vec3 min = frames[0].position;
+        glm::vec3 max = min;
+        for (const auto& frame : frames) {
+            min = glm::min(min, frame.position);
+            max = glm::max(max, frame.position);
         }
+        bone.positionMin = min;
+        bone.positionExtent = max - min;
+        bone.firstPosition = static_cast<std::uint32_t>(blob->positions.size());
+        for (const auto& frame : frames) {
+            AnimationBlob::PackedPosition packed{};
+            for (int i = 0; i < 3; ++i) {
+                const auto extent = bone.positionExtent[i];
+                packed[i] = extent > 0.f
+                                ? static_cast<std::uint16_t>(std::lround(
+                                      (frame.position[i] - min[i]) / extent *
+                                      kPositionMax))
+                                : 0;
+            }
+            blob->positions.push_back(packed);
+        }
+    }
+
+    if (type == AnimationBone::RTS) {
+        bone.firstScale = static_cast<std::uint32_t>(blob->scales.size());
+        for (const auto& frame : frames) {
+            blob->scales.push_back(frame.scale);
+        }
+    }
+
+    duration = std::max(duration, bone.duration);
+    return *bones.insert(it, std::move(bone));
+}
+
+int Animation::findBone(const std::string& name) const {
+    auto it = std::lower_bound(
+        bones.begin(), bones.end(), name,
+        [](const AnimationBone& b, const std::string& n) { return b.name < n; });
+    if (it == bones.end() || it->name != name) {
+        return -1;
     }
-    return frames.back();
+    return static_cast<int>(it - bones.begin());
 }
 
 bool LoaderIFP::loadFromMemory(char* data) {
@@ -67,6 +220,10 @@ bool LoaderIFP::loadFromMemory(char* data) {
 
     animations.reserve(fileRoot->info.entries);
 
+    // All the animations in the file share their keyframe data
+    auto blob = std::make_shared<AnimationBlob>();
+    std::vector<AnimationKeyframe> keyframes;
+
     for (auto a = 0u; a < fileRoot->info.entries; ++a) {
         // something about a name?
         /*NAME* n =*/read<NAME>(data, dataI);
@@ -75,6 +232,7 @@ bool LoaderIFP::loadFromMemory(char* data) {
         auto animation = std::make_shared<Animation>();
         animation->duration = 0.f;
         animation->name = animname;
+        animation->blob = blob;
 
         size_t animstart = data_offs + 8;
         DGAN* animroot = read<DGAN>(data, dataI);
@@ -87,9 +245,9 @@ bool LoaderIFP::loadFromMemory(char* data) {
             CPAN* cpan = read<CPAN>(data, dataI);
             ANIM* frames = read<ANIM>(data, dataI);
 
-            AnimationBone boneData{};
-            boneData.name = frames->name;
-            boneData.frames.reserve(frames->frames);
+            keyframes.clear();
+            keyframes.reserve(frames->frames);
+            auto boneType = AnimationBone::R00;
 
             data_offs += ((8 + frames->base.size) - sizeof(ANIM));
 
@@ -99,45 +257,40 @@ bool LoaderIFP::loadFromMemory(char* data) {
             float time = 0.f;
 
             if (type == "KR00") {
-                boneData.type = AnimationBone::R00;
+                boneType = AnimationBone::R00;
                 for (auto d = 0u; d < frames->frames; ++d) {
                     glm::quat q = glm::conjugate(*read<glm::quat>(data, dataI));
                     time = *read<float>(data, dataI);
-                    boneData.frames.emplace_back(q, glm::vec3(0.f, 0.f, 0.f),
-                                                glm::vec3(1.f, 1.f, 1.f), time,
-                                                d);
+                    keyframes.emplace_back(q, glm::vec3(0.f, 0.f, 0.f),
+                                           glm::vec3(1.f, 1.f, 1.f), time, d);
                 }
             } else if (type == "KRT0") {
-                boneData.type = AnimationBone::RT0;
+                boneType = AnimationBone::RT0;
                 for (auto d = 0u; d < frames->frames; ++d) {
                     glm::quat q = glm::conjugate(*read<glm::quat>(data, dataI));
                     glm::vec3 p = *read<glm::vec3>(data, dataI);
                     time = *read<float>(data, dataI);
-                    boneData.frames.emplace_back(
-                        q, p, glm::vec3(1.f, 1.f, 1.f), time, d);
+                    keyframes.emplace_back(q, p, glm::vec3(1.f, 1.f, 1.f),
+                                           time, d);
                 }
             } else if (type == "KRTS") {
-                boneData.type = AnimationBone::RTS;
+                boneType = AnimationBone::RTS;
                 for (auto d = 0u; d < frames->frames; ++d) {
                     glm::quat q = glm::conjugate(*read<glm::quat>(data, dataI));
                     glm::vec3 p = *read<glm::vec3>(data, dataI);
                     glm::vec3 s = *read<glm::vec3>(data, dataI);
                     time = *read<float>(data, dataI);
-                    boneData.frames.emplace_back(q, p, s, time, d);
+                    keyframes.emplace_back(q, p, s, time, d);
                 }
             }
 
-            boneData.duration = time;
-            animation->duration =
-                std::max(boneData.duration, animation->duration);
-
             data_offs = start + sizeof(CPAN) + cpan->base.size;
 
             std::string framename(frames->name);
             std::transform(framename.begin(), framename.end(),
                            framename.begin(), ::tolower);
 
-            animation->bones.emplace(framename, std::move(boneData));
+            animation->addBone(framename, boneType, keyframes);
         }
 
         data_offs = animstart + animroot->base.size;
@@ -147,6 +300,11 @@ bool LoaderIFP::loadFromMemory(char* data) {
         animations.emplace(animname, animation);
     }
 
+    blob->times.shrink_to_fit();
+    blob->rotations.shrink_to_fit();
+    blob->positions.shrink_to_fit();
+    blob->scales.shrink_to_fit();
+
     return true;
 }
 
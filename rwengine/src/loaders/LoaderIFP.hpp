@@ -1,8 +1,10 @@
 #ifndef _RWENGINE_LOADERIFP_HPP_
 #define _RWENGINE_LOADERIFP_HPP_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,34 +32,56 @@ struct AnimationKeyframe {
     AnimationKeyframe() = default;
 };
 
+/**
+ * @brief Keyframe data of the animations of an IFP, shared by them
+ *
+ * Rotations are stored as their three smallest components, 15 bits each,
+ * positions as 16 bit fractions of the bounds of their bone. Times,
+ * rotations, positions and scales are in separate arrays, bones refer to
+ * ranges of them. The blob is immutable once its animations are loaded.
+ */
+struct AnimationBlob {
+    using PackedRotation = std::array<std::uint16_t, 3>;
+    using PackedPosition = std::array<std::uint16_t, 3>;
+
+    std::vector<float> times;
+    std::vector<PackedRotation> rotations;
+    std::vector<PackedPosition> positions;
+    std::vector<glm::vec3> scales;
+
+    static PackedRotation packRotation(const glm::quat& rotation);
+    static glm::quat unpackRotation(const PackedRotation& packed);
+
+    std::size_t getMemoryUsage() const;
+};
+
 struct AnimationBone {
     std::string name;
-    int32_t previous;
-    int32_t next;
-    float duration;
+    float duration = 0.f;
 
     enum Data { R00, RT0, RTS };
 
-    Data type;
-    std::vector<AnimationKeyframe> frames;
+    Data type = R00;
 
-    AnimationBone() = default;
+    /// Keyframe ranges in the blob, positions and scales are only stored
+    /// for RT0 and RTS bones
+    const AnimationBlob* blob = nullptr;
+    std::uint32_t firstFrame = 0;
+    std::uint32_t frameCount = 0;
+    std::uint32_t firstPosition = 0;
+    std::uint32_t firstScale = 0;
+    glm::vec3 positionMin{};
+    glm::vec3 positionExtent{};
 
-    AnimationBone(const std::string& p_name, int32_t p_previous, int32_t p_next,
-                  float p_duration, Data p_type,
-                  const std::vector<AnimationKeyframe>& p_frames)
-        : name(p_name)
-        , previous(p_previous)
-        , next(p_next)
-        , duration(p_duration)
-        , type(p_type)
-        , frames(p_frames) {
+    bool empty() const {
+        return frameCount == 0;
     }
 
-    ~AnimationBone() = default;
+    AnimationKeyframe getInterpolatedKeyframe(float time) const;
+    AnimationKeyframe getKeyframe(float time) const;
 
-    AnimationKeyframe getInterpolatedKeyframe(float time);
-    AnimationKeyframe getKeyframe(float time);
+    /// Decodes frame i of the bone
+    AnimationKeyframe getFrame(std::uint32_t i) const;
 };
 
 /**
@@ -67,11 +91,23 @@ struct AnimationBone {
  */
 struct Animation {
     std::string name;
-    std::unordered_map<std::string, AnimationBone> bones;
+    /// Sorted by name
+    std::vector<AnimationBone> bones;
+    std::shared_ptr<AnimationBlob> blob;
 
     ~Animation() = default;
 
-    float duration;
+    float duration = 0.f;
+
+    /**
+     * @brief Compresses frames into the blob, creating it if there isn't
+     * one yet, and adds a bone using them.
+     */
+    AnimationBone& addBone(const std::string& name, AnimationBone::Data type,
+                           const std::vector<AnimationKeyframe>& frames);
+
+    /// @return The index of the named bone, or -1
+    int findBone(const std::string& name) const;
 };
 
 class LoaderIFP {
@@ -243,9 +243,9 @@ glm::vec3 CharacterObject::updateMovementAnimation(float dt) {
     if (movementAnimation != animations->animation(AnimCycle::Idle) &&
         !modelroot->getChildren().empty()) {
         const auto& root = modelroot->getChildren()[0];
-        auto it = movementAnimation->bones.find(root->getName());
-        if (it != movementAnimation->bones.end()) {
-            auto& rootBone = it->second;
+        auto index = movementAnimation->findBone(root->getName());
+        if (index >= 0) {
+            const auto& rootBone = movementAnimation->bones[index];
             float step = dt;
             RW_CHECK(
                 animator->getAnimation(AnimIndexMovement),
@@ -324,6 +324,8 @@ void CharacterObject::changeCharacterModel(const std::string& name) {
     /// @todo don't model leak here
 
     engine->data->loadTXD(modelName + ".txd");
+    // The model isn't tracked by a model info
+    engine->data->textureResidency.pin(modelName);
     auto newmodel = engine->data->loadClump(modelName + ".dff");
 
     setModel(newmodel);
@@ -383,6 +385,7 @@ void CharacterObject::updateCharacter(float dt) {
             physCharacter->getGhostObject()->getWorldTransform().getOrigin();
         position = glm::vec3(Pos.x(), Pos.y(), Pos.z());
         getClump()->getFrame()->setTranslation(position);
+        updateGridCell();
 
         // Handle above waist height water.
         auto wi = engine->data->getWaterIndexAt(getPosition());
@@ -438,6 +441,7 @@ void CharacterObject::setPosition(const glm::vec3& pos) {
     }
     position = realPos;
     getClump()->getFrame()->setTranslation(pos);
+    updateGridCell();
 }
 
 glm::vec3 CharacterObject::getCenterOffset() {
@@ -7,6 +7,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "engine/Animator.hpp"
+#include "engine/GameWorld.hpp"
 
 const AtomicPtr GameObject::NullAtomic;
 const ClumpPtr GameObject::NullClump;
@@ -19,6 +20,7 @@ GameObject::~GameObject() {
 
 void GameObject::setPosition(const glm::vec3& pos) {
     position = pos;
+    updateGridCell();
 }
 
 void GameObject::setRotation(const glm::quat& orientation) {
@@ -39,6 +41,7 @@ void GameObject::setHeading(float heading) {
 void GameObject::updateTransform(const glm::vec3& pos, const glm::quat& rot) {
     position = pos;
     rotation = rot;
+    updateGridCell();
 
     const auto& clump = getClump();
     const auto& atomic = getAtomic();
@@ -51,3 +54,9 @@ void GameObject::updateTransform(const glm::vec3& pos, const glm::quat& rot) {
         atomic->getFrame()->setTranslation(pos);
     }
 }
+
+void GameObject::updateGridCell() {
+    if (engine) {
+        engine->getTypeObjectPool(this).updateGrid(this);
+    }
+}
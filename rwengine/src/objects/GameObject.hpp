@@ -38,6 +38,10 @@ protected:
         modelinfo_ = next;
     }
 
+    /// Moves the object to its new cell in its pool's grid, called after
+    /// position changes
+    void updateGridCell();
+
 public:
     glm::vec3 position;
     glm::quat rotation;
@@ -171,7 +171,7 @@ void InstanceObject::changeModel(BaseModelInfo* incoming, int atomicNumber) {
 
         if (collision) {
             body = std::make_unique<CollisionInstance>();
-            body->createPhysicsBody(this, collision, dynamics);
+            body->createPhysicsBody(this, collision, dynamics, nullptr, scale);
         }
     }
 }
@@ -53,6 +53,9 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
                                GameShaders::WorldObject::FragmentShader);
 
     renderer->setUniformTexture(worldProg.get(), "texture", 0);
+    renderer->setUniformTexture(worldProg.get(), "palette", 1);
+    renderer->setUniformTexture(worldProg.get(), "texArray",
+                                Renderer::kTextureArrayUnit);
     renderer->setProgramBlockBinding(worldProg.get(), "SceneData", 1);
     renderer->setProgramBlockBinding(worldProg.get(), "ObjectData", 2);
 
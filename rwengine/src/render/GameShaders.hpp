@@ -186,6 +186,8 @@ struct WorldObject {
                 float diffusefac;
                 float ambientfac;
                 float visibility;
+                float paletted;
+                float layer;
             };
 
             void main() {
@@ -207,6 +209,8 @@ struct WorldObject {
             in vec4 Colour;
             in vec4 WorldSpace;
             uniform sampler2D tex;
+            uniform sampler2D palette;
+            uniform sampler2DArray texArray;
             out vec4 fragOut;
 
             layout(std140) uniform SceneData {
@@ -226,16 +230,51 @@ struct WorldObject {
                 float diffusefac;
                 float ambientfac;
                 float visibility;
+                float paletted;
+                float layer;
             };
 
             float alphaThreshold = (1.0/255.0);
 
+            vec4 paletteLookup(vec2 uv, int level) {
+                float index = textureLod(tex, uv, float(level)).r;
+                return texelFetch(palette, ivec2(int(index * 255.0 + 0.5), 0), 0);
+            }
+
+            // Paletted textures hold indices, so they are sampled without
+            // filtering and bilinear filtering is done on the palette colours,
+            // using the mip level closest to the screen space footprint.
+            vec4 paletteTexture(vec2 uv) {
+                vec2 baseSize = vec2(textureSize(tex, 0));
+                vec2 dx = dFdx(uv * baseSize);
+                vec2 dy = dFdy(uv * baseSize);
+                float lod = 0.5 * log2(max(dot(dx, dx), dot(dy, dy)));
+                float maxLod = floor(log2(max(baseSize.x, baseSize.y)));
+                int level = int(clamp(lod + 0.5, 0.0, maxLod));
+
+                vec2 size = vec2(textureSize(tex, level));
+                vec2 coord = uv * size - 0.5;
+                vec2 f = fract(coord);
+                vec2 texelSize = 1.0 / size;
+                vec2 st = (floor(coord) + 0.5) * texelSize;
+                vec4 c00 = paletteLookup(st, level);
+                vec4 c10 = paletteLookup(st + vec2(texelSize.x, 0.0), level);
+                vec4 c01 = paletteLookup(st + vec2(0.0, texelSize.y), level);
+                vec4 c11 = paletteLookup(st + texelSize, level);
+                return mix(mix(c00, c10, f.x), mix(c01, c11, f.x), f.y);
+            }
+
             void main() {
                 // Only the visibility parameter invokes the screen door.
                 vec4 diffuse = Colour;
                 diffuse.rgb += ambient.rgb*ambientfac;
                 diffuse *= colour;
-                diffuse *= texture(tex, TexCoords);
+                if (layer >= 0.0) {
+                    diffuse *= texture(texArray, vec3(TexCoords, layer));
+                } else {
+                    diffuse *= paletted > 0.5 ? paletteTexture(TexCoords)
+                                              : texture(tex, TexCoords);
+                }
                 if(diffuse.a <= alphaThreshold) discard;
                 float fog = 1.0 - clamp( (fogEnd-WorldSpace.w)/(fogEnd-fogStart), 0.0, 1.0 );
                 fragOut = vec4(mix(diffuse.rgb, fogColor.rgb, fog), diffuse.a);
@@ -271,6 +310,8 @@ struct Particle {
                 float diffusefac;
                 float ambientfac;
                 float visibility;
+                float paletted;
+                float layer;
             };
 
             #define ALPHA_DISCARD_THRESHOLD 0.01
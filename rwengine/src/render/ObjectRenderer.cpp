@@ -69,7 +69,12 @@ void ObjectRenderer::renderGeometry(Geometry* geom,
                     if (tex->isTransparent()) {
                         isTransparent = true;
                     }
-                    dp.textures = {{tex->getName()}};
+                    dp.textures = {{tex->getName(), tex->getPaletteName()}};
+                    dp.paletted = tex->isPaletted();
+                    if (tex->isArrayLayer()) {
+                        dp.textureLayer = tex->getLayer();
+                    }
+                    tex->markUsed(m_world->data->textureResidency.getFrame());
                 }
             }
 
@@ -138,13 +138,13 @@ void OpenGLRenderer::useDrawBuffer(DrawBuffer* dbuff) {
     }
 }
 
-void OpenGLRenderer::useTexture(GLuint unit, GLuint tex) {
+void OpenGLRenderer::useTexture(GLuint unit, GLuint tex, GLenum target) {
     if (currentTextures[unit] != tex) {
         if (currentUnit != unit) {
             glActiveTexture(GL_TEXTURE0 + unit);
             currentUnit = unit;
         }
-        glBindTexture(GL_TEXTURE_2D, tex);
+        glBindTexture(target, tex);
         currentTextures[unit] = tex;
         textureCounter++;
 #ifdef RW_GRAPHICS_STATS
@@ -321,8 +321,13 @@ void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
                                   const Renderer::DrawParameters& p) {
     useDrawBuffer(draw);
 
-    for (GLuint u = 0; u < p.textures.size(); ++u) {
-        useTexture(u, p.textures[u]);
+    if (p.textureLayer >= 0) {
+        // Arrays have their own unit, so the 2D textures stay bound
+        useTexture(kTextureArrayUnit, p.textures[0], GL_TEXTURE_2D_ARRAY);
+    } else {
+        for (GLuint u = 0; u < p.textures.size(); ++u) {
+            useTexture(u, p.textures[u]);
+        }
     }
 
     setBlend(p.blendMode);
@@ -332,7 +337,9 @@ void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
     ObjectUniformData objectData{model,
                              glm::vec4(p.colour.r / 255.f, p.colour.g / 255.f,
                                        p.colour.b / 255.f, p.colour.a / 255.f),
-                             1.f, 1.f, p.visibility};
+                             1.f, 1.f, p.visibility,
+                             p.paletted ? 1.f : 0.f,
+                             static_cast<float>(p.textureLayer)};
     uploadUBO(UBOObject, objectData);
 
     drawCounter++;
@@ -74,6 +74,9 @@ class Renderer {
 public:
     typedef std::array<GLuint,2> Textures;
 
+    /// Texture unit that texture arrays are bound to
+    static constexpr GLuint kTextureArrayUnit = 2;
+
     /**
      * @brief The DrawParameters struct stores drawing state
      *
@@ -104,6 +107,10 @@ public:
         float diffuse{1.f};
         /// Material
         float visibility{1.f};
+        /// textures[0] holds palette indices and textures[1] their palette
+        bool paletted = false;
+        /// Layer of the texture array in textures[0], or -1 for 2D textures
+        int textureLayer = -1;
 
         // Default state -- should be moved to materials
         DrawParameters() = default;
@@ -136,6 +143,9 @@ public:
         float diffuse{};
         float ambient{};
         float visibility{};
+        float paletted{};
+        float layer{-1.f};
+        float padding[3]{};
     };
 
     struct SceneUniformData {
@@ -333,7 +343,7 @@ private:
 
     void useDrawBuffer(DrawBuffer* dbuff);
 
-    void useTexture(GLuint unit, GLuint tex);
+    void useTexture(GLuint unit, GLuint tex, GLenum target = GL_TEXTURE_2D);
 
     Buffer UBOObject {};
     Buffer UBOScene {};
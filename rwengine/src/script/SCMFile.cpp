@@ -6,6 +6,7 @@
 void SCMFile::loadFile(char *data, size_t size) {
     _data = std::make_unique<SCMByte[]>(size);
     std::copy(data, data + size, _data.get());
+    this->size = size;
 
     // Bytes required to hop over a jump opcode.
     const unsigned int jumpOpSize = 2u + 1u + 4u;
@@ -36,6 +36,10 @@ public:
         return _data.get();
     }
 
+    size_t getSize() const {
+        return size;
+    }
+
     template <class T>
     T read(unsigned int offset) const {
         return bit_cast<T>(*(_data.get() + offset));
@@ -75,6 +79,7 @@ public:
 
 private:
     std::unique_ptr<SCMByte[]> _data;
+    size_t size{0};
 
     SCMTarget _target{NoTarget};
 
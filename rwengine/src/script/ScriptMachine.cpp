@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 
 #include "ai/PlayerController.hpp"
 #include "core/Logger.hpp"
@@ -12,17 +13,18 @@
 #include "script/SCMFile.hpp"
 #include "script/ScriptModule.hpp"
 
-void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
-    auto player = state->world->getPlayer();
-
-    if (player) {
-        if (t.isMission && t.deathOrArrestCheck &&
-            (player->isWasted() || player->isBusted())) {
-            t.wastedOrBusted = true;
-            t.stackDepth = 0;
-            t.programCounter = t.calls[t.stackDepth];
-        }
+namespace {
+/// Sends mission threads back to their death or arrest handler
+void checkWastedOrBusted(SCMThread& t) {
+    if (t.isMission && t.deathOrArrestCheck) {
+        t.wastedOrBusted = true;
+        t.stackDepth = 0;
+        t.programCounter = t.calls[t.stackDepth];
     }
+}
+}  // namespace
+
+void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
     // There is 02a1 opcode that is used only during "Kingdom Come", which
     // basically acts like a wait command, but waiting time can be skipped
     // by pressing 'X'? PS2 button
@@ -36,90 +38,37 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
     if (t.wakeCounter > 0) return;
 
     while (t.wakeCounter == 0) {
-        auto pc = t.programCounter;
-        auto opcode = file.read<SCMOpcode>(pc);
-
-        bool isNegatedConditional = ((opcode & SCM_NEGATE_CONDITIONAL_MASK) ==
-                                     SCM_NEGATE_CONDITIONAL_MASK);
-        opcode = opcode & ~SCM_NEGATE_CONDITIONAL_MASK;
-
-        ScriptFunctionMeta* foundcode;
-        if (!module->findOpcode(opcode, &foundcode)) {
-            throw IllegalInstruction(opcode, pc, t.name);
+#ifdef RW_SCRIPT_PROFILER
+        const auto instructionStart = ScriptProfiler::Clock::now();
+        const auto instructionAddress = t.programCounter;
+#endif
+        SCMInstruction decoded;
+        SCMParams uncached;
+        const SCMParams* decodedParams = &instructionParameters;
+        if (instructionCacheEnabled) {
+            decoded = fetchInstruction(t.programCounter, t);
+        } else {
+            decoded = decodeInstruction(t.programCounter, t, uncached);
+            decodedParams = &uncached;
         }
-        ScriptFunctionMeta& code = *foundcode;
-
-        pc += sizeof(SCMOpcode);
-
-        SCMParams parameters;
+        ScriptFunctionMeta& code = *decoded.code;
+        const auto opcode = decoded.opcode;
+        const auto pc = decoded.next;
 
-        bool hasExtraParameters = code.arguments < 0;
-        auto requiredParams = std::abs(code.arguments);
-
-        for (int p = 0; p < requiredParams || hasExtraParameters; ++p) {
-            auto type_r = file.read<SCMByte>(pc);
-            auto type = static_cast<SCMType>(type_r);
-
-            if (type_r > 42) {
-                // for implicit strings, we need the byte we just read.
-                type = TString;
-            } else {
-                pc += sizeof(SCMByte);
+        // Resolve variable offsets for this thread
+        parameters.clear();
+        for (auto p = decoded.firstParameter;
+             p < decoded.firstParameter + decoded.parameterCount; ++p) {
+            auto parameter = (*decodedParams)[p];
+            if (parameter.outOfBounds) {
+                reportOutOfBounds(parameter);
             }
-
-            parameters.push_back(SCMOpcodeParameter{type, {0}});
-            switch (type) {
-                case EndOfArgList:
-                    hasExtraParameters = false;
-                    break;
-                case TInt8:
-                    parameters.back().integer = file.read<std::int8_t>(pc);
-                    pc += sizeof(SCMByte);
-                    break;
-                case TInt16:
-                    parameters.back().integer = file.read<std::int16_t>(pc);
-                    pc += sizeof(SCMByte) * 2;
-                    break;
-                case TGlobal: {
-                    auto v = file.read<std::uint16_t>(pc);
-                    parameters.back().globalPtr =
-                        globalData.data() + v;  //* SCM_VARIABLE_SIZE;
-                    if (v >= file.getGlobalsSize()) {
-                        state->world->logger->error(
-                            "SCM", "Global Out of bounds! " +
-                                       std::to_string(v) + " " +
-                                       std::to_string(file.getGlobalsSize()));
-                    }
-                    pc += sizeof(SCMByte) * 2;
-                } break;
-                case TLocal: {
-                    auto v = file.read<std::uint16_t>(pc);
-                    parameters.back().globalPtr =
-                        t.locals.data() + v * SCM_VARIABLE_SIZE;
-                    if (v >= SCM_THREAD_LOCAL_SIZE) {
-                        state->world->logger->error("SCM",
-                                                    "Local Out of bounds!");
-                    }
-                    pc += sizeof(SCMByte) * 2;
-                } break;
-                case TInt32:
-                    parameters.back().integer = file.read<std::int32_t>(pc);
-                    pc += sizeof(SCMByte) * 4;
-                    break;
-                case TString:
-                    std::copy(file.data() + pc, file.data() + pc + 8,
-                              parameters.back().string);
-                    pc += sizeof(SCMByte) * 8;
-                    break;
-                case TFloat16:
-                    parameters.back().real =
-                        file.read<std::int16_t>(pc) / 16.f;
-                    pc += sizeof(SCMByte) * 2;
-                    break;
-                default:
-                    throw UnknownType(type, pc, t.name);
-                    break;
-            };
+            if (parameter.type == TGlobal) {
+                parameter.globalPtr = globalData.data() + parameter.integer;
+            } else if (parameter.type == TLocal) {
+                parameter.globalPtr = t.locals.data() + parameter.integer;
+            }
+            parameters.push_back(parameter);
         }
 
         ScriptArguments sca(&parameters, &t, this);
@@ -149,7 +98,7 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
             code.function(sca);
         }
 
-        if (isNegatedConditional) {
+        if (decoded.negated) {
             t.conditionResult = !t.conditionResult;
         }
 
@@ -173,6 +122,12 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
 
             t.conditionResult = (t.conditionMask != 0);
         }
+
+#ifdef RW_SCRIPT_PROFILER
+        profiler.recordInstruction(decoded.code, opcode, instructionAddress,
+                                   ScriptProfiler::Clock::now() -
+                                       instructionStart);
+#endif
     }
 
     SCMOpcodeParameter p;
@@ -186,18 +141,220 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
     }
 }
 
+SCMInstruction ScriptMachine::decodeInstruction(SCMAddress pc,
+                                                const SCMThread& t,
+                                                SCMParams& params) {
+    const auto size = file.getSize();
+    if (pc + sizeof(SCMOpcode) > size) {
+        throw IllegalInstruction(0, pc, t.name);
+    }
+    auto opcode = file.read<SCMOpcode>(pc);
+
+    SCMInstruction instruction;
+    instruction.negated = ((opcode & SCM_NEGATE_CONDITIONAL_MASK) ==
+                           SCM_NEGATE_CONDITIONAL_MASK);
+    instruction.opcode = opcode & ~SCM_NEGATE_CONDITIONAL_MASK;
+
+    if (!module->findOpcode(instruction.opcode, &instruction.code)) {
+        throw IllegalInstruction(instruction.opcode, pc, t.name);
+    }
+    const ScriptFunctionMeta& code = *instruction.code;
+
+    pc += sizeof(SCMOpcode);
+
+    instruction.firstParameter = static_cast<std::uint32_t>(params.size());
+
+    bool hasExtraParameters = code.arguments < 0;
+    auto requiredParams = std::abs(code.arguments);
+
+    // Guards against running off the end of the file
+    const auto require = [&](size_t bytes) {
+        if (pc + bytes > size) {
+            throw IllegalInstruction(instruction.opcode, pc, t.name);
+        }
+    };
+
+    for (int p = 0; p < requiredParams || hasExtraParameters; ++p) {
+        require(sizeof(SCMByte));
+        auto type_r = file.read<SCMByte>(pc);
+        auto type = static_cast<SCMType>(type_r);
+
+        if (type_r > 42) {
+            // for implicit strings, we need the byte we just read.
+            type = TString;
+        } else {
+            pc += sizeof(SCMByte);
+        }
+
+        // Variables are stored as byte offsets, see executeThread
+        params.push_back(SCMOpcodeParameter{type, {0}});
+        switch (type) {
+            case EndOfArgList:
+                hasExtraParameters = false;
+                break;
+            case TInt8:
+                require(sizeof(SCMByte));
+                params.back().integer = file.read<std::int8_t>(pc);
+                pc += sizeof(SCMByte);
+                break;
+            case TInt16:
+                require(sizeof(SCMByte) * 2);
+                params.back().integer = file.read<std::int16_t>(pc);
+                pc += sizeof(SCMByte) * 2;
+                break;
+            case TGlobal: {
+                require(sizeof(SCMByte) * 2);
+                auto v = file.read<std::uint16_t>(pc);
+                params.back().integer = v;  //* SCM_VARIABLE_SIZE;
+                // The bytes may be data that never runs, so errors wait
+                // until the instruction does
+                params.back().outOfBounds = v >= file.getGlobalsSize();
+                pc += sizeof(SCMByte) * 2;
+            } break;
+            case TLocal: {
+                require(sizeof(SCMByte) * 2);
+                auto v = file.read<std::uint16_t>(pc);
+                params.back().integer = v * SCM_VARIABLE_SIZE;
+                params.back().outOfBounds = v >= SCM_THREAD_LOCAL_SIZE;
+                pc += sizeof(SCMByte) * 2;
+            } break;
+            case TInt32:
+                require(sizeof(SCMByte) * 4);
+                params.back().integer = file.read<std::int32_t>(pc);
+                pc += sizeof(SCMByte) * 4;
+                break;
+            case TString:
+                require(sizeof(SCMByte) * 8);
+                std::copy(file.data() + pc, file.data() + pc + 8,
+                          params.back().string);
+                pc += sizeof(SCMByte) * 8;
+                break;
+            case TFloat16:
+                require(sizeof(SCMByte) * 2);
+                params.back().real = file.read<std::int16_t>(pc) / 16.f;
+                pc += sizeof(SCMByte) * 2;
+                break;
+            default:
+                throw UnknownType(type, pc, t.name);
+                break;
+        };
+    }
+
+    instruction.parameterCount =
+        static_cast<std::uint32_t>(params.size()) - instruction.firstParameter;
+    instruction.next = pc;
+    return instruction;
+}
+
+void ScriptMachine::reportOutOfBounds(const SCMOpcodeParameter& parameter) {
+    if (parameter.type == TGlobal) {
+        state->world->logger->error(
+            "SCM", "Global Out of bounds! " +
+                       std::to_string(parameter.integer) + " " +
+                       std::to_string(file.getGlobalsSize()));
+    } else {
+        state->world->logger->error("SCM", "Local Out of bounds!");
+    }
+}
+
+void ScriptMachine::scanCode(
+    SCMAddress start, SCMAddress end,
+    const std::function<bool(const SCMInstruction&, const SCMParams&)>&
+        visitor) {
+    SCMThread scanner{};
+    strncpy(scanner.name, "SCAN", 16);
+    SCMParams params;
+    auto pc = start;
+    while (pc < end) {
+        params.clear();
+        SCMInstruction instruction;
+        try {
+            instruction = decodeInstruction(pc, scanner, params);
+        } catch (const SCMException&) {
+            break;
+        }
+        if (!visitor(instruction, params)) {
+            break;
+        }
+        pc = instruction.next;
+    }
+}
+
+namespace {
+constexpr int kMaxBlockLength = 64;
+
+/// Opcodes that may leave a basic block
+bool isBlockEnd(SCMOpcode opcode) {
+    switch (opcode) {
+        case 0x0002:  // goto
+        case 0x004C:  // goto_if_true
+        case 0x004D:  // goto_if_false
+        case 0x004E:  // terminate_this_script
+        case 0x0050:  // gosub
+        case 0x0051:  // return
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+const SCMInstruction& ScriptMachine::fetchInstruction(SCMAddress pc,
+                                                      const SCMThread& t) {
+    if (instructionIndex.empty()) {
+        instructionIndex.resize(file.getSize(), -1);
+    }
+    if (pc < instructionIndex.size() && instructionIndex[pc] >= 0) {
+        return instructions[instructionIndex[pc]];
+    }
+
+    // Decode the basic block starting here. Only the first instruction has
+    // to be valid, the code after a block may be data or mission code.
+    auto first = static_cast<std::int32_t>(instructions.size());
+    auto address = pc;
+    for (int i = 0; i < kMaxBlockLength; ++i) {
+        if (address >= instructionIndex.size() ||
+            instructionIndex[address] >= 0) {
+            break;
+        }
+        SCMInstruction instruction;
+        try {
+            instruction = decodeInstruction(address, t, instructionParameters);
+        } catch (SCMException&) {
+            if (i == 0) {
+                throw;
+            }
+            break;
+        }
+        instructionIndex[address] =
+            static_cast<std::int32_t>(instructions.size());
+        instructions.push_back(instruction);
+        address = instruction.next;
+        if (isBlockEnd(instruction.opcode)) {
+            break;
+        }
+    }
+
+    return instructions[first];
+}
+
 ScriptMachine::ScriptMachine(GameState* _state, SCMFile& file,
                              ScriptModule* ops)
     : file(file)
     , module(ops)
     , state(_state)
-    , debugFlag(false) {
+    , debugFlag(false)
+    , preloader(*this) {
     // Copy globals
     auto size = file.getGlobalsSize();
     globalData.resize(size);
     auto offset = file.getGlobalSection();
     std::copy(file.data() + offset, file.data() + offset + size,
               globalData.begin());
+
+#ifdef RW_SCRIPT_PROFILER
+    profiler.reset(file.getSize());
+#endif
 }
 
 void ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
@@ -219,6 +376,12 @@ void ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
     t.wastedOrBusted = false;
     t.allowWaitSkip = false;
     _activeThreads.push_back(t);
+
+    // Threads started by a script are picked up by the running execute()
+    if (!executing) {
+        readyThreads.push_back(
+            static_cast<uint32_t>(_activeThreads.size() - 1));
+    }
 }
 
 SCMByte* ScriptMachine::getGlobals() {
@@ -228,12 +391,114 @@ SCMByte* ScriptMachine::getGlobals() {
 void ScriptMachine::execute(float dt) {
     RW_PROFILE_SCOPEC(__func__, MP_ORANGERED);
     int ms = static_cast<int>(dt * 1000.f);
-    for (auto t = _activeThreads.begin(); t != _activeThreads.end(); ++t) {
-        auto& thread = *t;
-        executeThread(thread, ms);
+    scriptTime += ms;
 
-        if (thread.finished) {
-            t = _activeThreads.erase(t);
+    // The player is looked up once per tick rather than for every thread
+    auto player = state->world->getPlayer();
+    const bool wastedOrBusted =
+        player && (player->isWasted() || player->isBusted());
+    if (wastedOrBusted) {
+        for (auto& thread : _activeThreads) {
+            checkWastedOrBusted(thread);
         }
     }
+
+    runnableThreads.clear();
+    sleepingThreads.advance(scriptTime, runnableThreads);
+    for (auto index : runnableThreads) {
+        _activeThreads[index].wakeCounter = 0;
+    }
+    runnableThreads.insert(runnableThreads.end(), readyThreads.begin(),
+                           readyThreads.end());
+    runnableThreads.insert(runnableThreads.end(), skippableThreads.begin(),
+                           skippableThreads.end());
+    readyThreads.clear();
+    skippableThreads.clear();
+
+    // Threads run in the order they were started, as they did when every
+    // thread was visited
+    std::sort(runnableThreads.begin(), runnableThreads.end());
+    runnableThreads.erase(
+        std::unique(runnableThreads.begin(), runnableThreads.end()),
+        runnableThreads.end());
+    RW_PROFILE_COUNTER_SET("script/runnableThreads", runnableThreads.size());
+
+#ifdef RW_SCRIPT_PROFILER
+    profiler.beginTick();
+#endif
+    executing = true;
+    const auto started = static_cast<uint32_t>(_activeThreads.size());
+    for (auto index : runnableThreads) {
+        runThread(index, ms);
+    }
+    // Threads started during this tick run after the existing ones
+    for (auto index = started; index < _activeThreads.size(); ++index) {
+        if (wastedOrBusted) {
+            checkWastedOrBusted(_activeThreads[index]);
+        }
+        runThread(index, ms);
+    }
+    executing = false;
+#ifdef RW_SCRIPT_PROFILER
+    profiler.endTick();
+#endif
+
+    if (threadsFinished) {
+        removeFinishedThreads();
+    }
+}
+
+void ScriptMachine::terminateThread(SCMThread& thread) {
+    thread.wakeCounter = -1;
+    thread.finished = true;
+    threadsFinished = true;
+}
+
+void ScriptMachine::runThread(uint32_t index, int msPassed) {
+    auto& thread = _activeThreads[index];
+#ifdef RW_SCRIPT_PROFILER
+    profiler.beginThread(thread);
+    executeThread(thread, msPassed);
+    profiler.endThread(thread);
+#else
+    executeThread(thread, msPassed);
+#endif
+
+    if (thread.finished) {
+        threadsFinished = true;
+    } else if (thread.wakeCounter > 0 && thread.allowWaitSkip) {
+        skippableThreads.push_back(index);
+    } else if (thread.wakeCounter > 0) {
+        sleepingThreads.schedule(index, scriptTime + thread.wakeCounter);
+    } else {
+        readyThreads.push_back(index);
+    }
+}
+
+void ScriptMachine::removeFinishedThreads() {
+    constexpr auto kRemoved = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(_activeThreads.size(), kRemoved);
+    uint32_t next = 0;
+    for (auto i = 0u; i < _activeThreads.size(); ++i) {
+        if (!_activeThreads[i].finished) {
+            remap[i] = next++;
+        }
+    }
+
+    _activeThreads.erase(
+        std::remove_if(_activeThreads.begin(), _activeThreads.end(),
+                       [](const SCMThread& t) { return t.finished; }),
+        _activeThreads.end());
+
+    auto update = [&](uint32_t& index) {
+        index = remap[index];
+        return index != kRemoved;
+    };
+    sleepingThreads.remap(update);
+    for (auto list : {&readyThreads, &skippableThreads}) {
+        list->erase(std::remove_if(list->begin(), list->end(),
+                                   [&](uint32_t& i) { return !update(i); }),
+                    list->end());
+    }
+    threadsFinished = false;
 }
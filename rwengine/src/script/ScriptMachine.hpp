@@ -3,8 +3,9 @@
 
 #include <array>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <iomanip>
-#include <list>
 #include <random>
 #include <sstream>
 #include <string>
@@ -12,8 +13,14 @@
 #include <utility>
 #include <vector>
 
+#include <core/TimerWheel.hpp>
+#include <script/ScriptPreloader.hpp>
 #include <script/ScriptTypes.hpp>
 
+#ifdef RW_SCRIPT_PROFILER
+#include <script/ScriptProfiler.hpp>
+#endif
+
 class GameState;
 class SCMFile;
 
@@ -88,7 +95,9 @@ struct SCMThread {
     std::uint8_t conditionMask;
     bool conditionAND;
 
-    /** Number of MS until the thread should be waked (-1 = yielded) */
+    /** Number of MS until the thread should be waked (-1 = yielded), for
+     * threads sleeping in the scheduler this is the time left when they went
+     * to sleep */
     int wakeCounter;
     std::array<SCMByte, SCM_THREAD_LOCAL_SIZE*(SCM_VARIABLE_SIZE)> locals;
     bool isMission;
@@ -105,6 +114,20 @@ struct SCMThread {
     bool allowWaitSkip;
 };
 
+/**
+ * Instruction decoded from the SCM file, its parameters are stored with
+ * variable offsets in place of the pointers, as locals depend on the thread.
+ */
+struct SCMInstruction {
+    ScriptFunctionMeta* code;
+    SCMOpcode opcode;
+    bool negated;
+    /// Address of the following instruction
+    SCMAddress next;
+    std::uint32_t firstParameter;
+    std::uint32_t parameterCount;
+};
+
 /**
  * Implements the actual fetch-execute mechanism for the game script virtual
  * machine.
@@ -126,6 +149,10 @@ struct SCMThread {
  * by consuming the correct number of arguments, allowing the next instruction
  * to be found,
  * and then dispatching a call to the opcode's function.
+ *
+ * Threads waiting for a number of milliseconds are kept in a timer wheel and
+ * are only visited once they are due, the remaining threads still run in the
+ * order they were started.
  */
 class ScriptMachine {
 public:
@@ -138,10 +165,23 @@ public:
 
     void startThread(SCMThread::pc_t start, bool mission = false);
 
-    std::list<SCMThread>& getThreads() {
+    std::deque<SCMThread>& getThreads() {
         return _activeThreads;
     }
 
+    /**
+     * @brief Stops a thread from outside of the scripts, it is removed at the
+     * end of the next execute().
+     */
+    void terminateThread(SCMThread& thread);
+
+    /**
+     * @return The number of threads waiting in the timer wheel
+     */
+    size_t getSleepingThreadCount() const {
+        return sleepingThreads.size();
+    }
+
     SCMByte* getGlobals();
     std::vector<SCMByte>& getGlobalData() {
         return globalData;
@@ -169,17 +209,107 @@ public:
      */
     void execute(float dt);
 
+    /**
+     * Instructions are decoded once and kept, unless the cache is disabled
+     * in which case they are decoded every time they run.
+     */
+    void setInstructionCacheEnabled(bool enabled) {
+        instructionCacheEnabled = enabled;
+    }
+
+    bool isInstructionCacheEnabled() const {
+        return instructionCacheEnabled;
+    }
+
+    size_t getCachedInstructionCount() const {
+        return instructions.size();
+    }
+
+    /**
+     * @brief Decodes the code in [start, end) from the start, calling
+     * visitor with each instruction and its parameters until it returns
+     * false. Stops at the first instruction that can't be decoded.
+     */
+    void scanCode(SCMAddress start, SCMAddress end,
+                  const std::function<bool(const SCMInstruction&,
+                                           const SCMParams&)>& visitor);
+
+    ScriptPreloader& getPreloader() {
+        return preloader;
+    }
+
+#ifdef RW_SCRIPT_PROFILER
+    ScriptProfiler& getProfiler() {
+        return profiler;
+    }
+#endif
+
 private:
     SCMFile& file;
     ScriptModule* module = nullptr;
     GameState* state = nullptr;
     bool debugFlag;
 
-    std::list<SCMThread> _activeThreads;
+    /// Threads in the order they were started, a deque keeps references
+    /// valid when threads are started by the executing thread.
+    std::deque<SCMThread> _activeThreads;
 
     void executeThread(SCMThread& t, int msPassed);
 
+    /**
+     * Executes the thread at index and files it under the list matching
+     * what it waits for.
+     */
+    void runThread(uint32_t index, int msPassed);
+
+    /**
+     * Removes the finished threads, updating the indices stored by the
+     * scheduler.
+     */
+    void removeFinishedThreads();
+
+    /// Time the threads have been executed for in ms
+    uint64_t scriptTime = 0;
+    TimerWheel sleepingThreads;
+    /// Threads to run on the next tick
+    std::vector<uint32_t> readyThreads;
+    /// Threads waiting with allowWaitSkip, checked every tick
+    std::vector<uint32_t> skippableThreads;
+    /// Threads run by the current tick
+    std::vector<uint32_t> runnableThreads;
+    bool executing = false;
+    bool threadsFinished = false;
+
+    /**
+     * Decodes the instruction at pc, appending its parameters to params
+     */
+    SCMInstruction decodeInstruction(SCMAddress pc, const SCMThread& t,
+                                     SCMParams& params);
+
+    /**
+     * Returns the cached instruction at pc, decoding the basic block that
+     * starts there if it hasn't been seen yet.
+     */
+    const SCMInstruction& fetchInstruction(SCMAddress pc, const SCMThread& t);
+
+    /// Logs the error for a variable outside of its storage
+    void reportOutOfBounds(const SCMOpcodeParameter& parameter);
+
     std::vector<SCMByte> globalData;
+
+    bool instructionCacheEnabled = true;
+    /// Index into instructions for each address, or -1 if not decoded
+    std::vector<std::int32_t> instructionIndex;
+    std::vector<SCMInstruction> instructions;
+    SCMParams instructionParameters;
+    /// Parameters of the executing instruction, reused to avoid allocations
+    SCMParams parameters;
+
+    ScriptPreloader preloader;
+
+#ifdef RW_SCRIPT_PROFILER
+    ScriptProfiler profiler;
+#endif
 };
 
 #endif
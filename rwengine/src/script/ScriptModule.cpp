@@ -3,11 +3,12 @@
 #include "script/ScriptMachine.hpp"
 #include "script/ScriptTypes.hpp"
 
-bool ScriptModule::findOpcode(ScriptFunctionID id, ScriptFunctionMeta** out) {
-    auto it = functions.find(id);
-    if (it == functions.end()) {
-        return false;
+void ScriptModule::bind(ScriptFunctionID id, int argc,
+                        ScriptFunction function) {
+    RW_CHECK(id < kMaxFunctions, "Opcode out of range");
+    if (id >= functions.size()) {
+        functions.resize(id + 1u);
     }
-    *out = &functions[id];
-    return true;
+    functions[id] = std::make_unique<ScriptFunctionMeta>(
+        ScriptFunctionMeta{function, argc, "opcode", ""});
 }
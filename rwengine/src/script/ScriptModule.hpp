@@ -2,8 +2,10 @@
 #define _RWENGINE_SCRIPTMODULE_HPP_
 
 #include <cstddef>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
+#include <vector>
 
 #include <script/ScriptTypes.hpp>
 #include "ScriptMachine.hpp"
@@ -34,6 +36,68 @@ struct arg_traits<ScriptRGBA> {
     static constexpr size_t arg_size = 4;
 };
 
+/**
+ * Types a bound function may take, the count of script parameters they
+ * consume is given by arg_traits.
+ */
+template <class T>
+struct is_argument : std::false_type {};
+
+template <>
+struct is_argument<ScriptInt> : std::true_type {};
+template <>
+struct is_argument<ScriptFloat> : std::true_type {};
+template <>
+struct is_argument<const char*> : std::true_type {};
+template <>
+struct is_argument<ScriptVec2> : std::true_type {};
+template <>
+struct is_argument<ScriptVec3> : std::true_type {};
+template <>
+struct is_argument<ScriptRGB> : std::true_type {};
+template <>
+struct is_argument<ScriptRGBA> : std::true_type {};
+template <>
+struct is_argument<ScriptGarageType> : std::true_type {};
+template <>
+struct is_argument<ScriptInt&> : std::true_type {};
+template <>
+struct is_argument<ScriptFloat&> : std::true_type {};
+template <class T>
+struct is_argument<ScriptObjectType<T>> : std::true_type {};
+template <class T>
+struct is_argument<ScriptObjectType<T>&> : std::true_type {};
+
+/**
+ * Script functions take ScriptArguments followed by the parameters to
+ * unpack, and return void or a bool for the thread's condition result.
+ */
+template <class F>
+struct function_traits {
+    static constexpr bool valid_signature = false;
+    static constexpr bool reads_arguments = true;
+    static constexpr int parameters = 0;
+};
+
+template <class Tret, class... Targs>
+struct function_traits<Tret (*)(const ScriptArguments&, Targs...)> {
+    static constexpr bool valid_signature =
+        (std::is_same<Tret, void>::value || std::is_same<Tret, bool>::value) &&
+        (is_argument<Targs>::value && ...);
+
+    /// Functions taking only ScriptArguments read their parameters themselves
+    static constexpr bool reads_arguments = sizeof...(Targs) == 0;
+
+    /// Number of script parameters unpacked for the function
+    static constexpr int parameters =
+        static_cast<int>((size_t{0} + ... + arg_traits<Targs>::arg_size));
+};
+
+/**
+ * Parameters are read straight from the decoded instruction: the parameter
+ * count was checked against the function when it was bound, and the
+ * decoder always provides that many.
+ */
 template <class T, unsigned arg>
 struct unpack {
     static T convert(const ScriptArguments& args) {
@@ -41,6 +105,37 @@ struct unpack {
     }
 };
 
+template <unsigned arg>
+struct unpack<ScriptInt, arg> {
+    static ScriptInt convert(const ScriptArguments& args) {
+        return args.getParameters()[arg].integerValue();
+    }
+};
+
+template <unsigned arg>
+struct unpack<ScriptFloat, arg> {
+    static ScriptFloat convert(const ScriptArguments& args) {
+        return args.getParameters()[arg].realValue();
+    }
+};
+
+template <unsigned arg>
+struct unpack<ScriptVec2, arg> {
+    static ScriptVec2 convert(const ScriptArguments& args) {
+        const auto& params = args.getParameters();
+        return {params[arg].realValue(), params[arg + 1].realValue()};
+    }
+};
+
+template <unsigned arg>
+struct unpack<ScriptVec3, arg> {
+    static ScriptVec3 convert(const ScriptArguments& args) {
+        const auto& params = args.getParameters();
+        return {params[arg].realValue(), params[arg + 1].realValue(),
+                params[arg + 2].realValue()};
+    }
+};
+
 template <unsigned arg>
 struct unpack<const ScriptArguments&, arg> {
     static const ScriptArguments& convert(const ScriptArguments& args) {
@@ -55,6 +150,22 @@ struct unpack<T&, arg> {
     }
 };
 
+template <unsigned arg>
+struct unpack<ScriptInt&, arg> {
+    static ScriptInt& convert(const ScriptArguments& args) {
+        return *reinterpret_cast<ScriptInt*>(
+            args.getParameters()[arg].handleValue());
+    }
+};
+
+template <unsigned arg>
+struct unpack<ScriptFloat&, arg> {
+    static ScriptFloat& convert(const ScriptArguments& args) {
+        return *reinterpret_cast<ScriptFloat*>(
+            args.getParameters()[arg].handleValue());
+    }
+};
+
 // unpack ScriptObjectType<T>& as non-ref so object is copied by the caller.
 template <class T, unsigned arg>
 struct unpack<ScriptObjectType<T>&, arg> {
@@ -139,6 +250,15 @@ void do_unpacked_call(Tret (*const& func)(Targs...),
                       const ScriptArguments& args) {
     script_bind::binder<Tret, Targs...>::call(func, args);
 }
+
+/**
+ * Plain function that unpacks the parameters for function and calls it, the
+ * compiler sees the call target so the unpacking is inlined.
+ */
+template <auto function>
+void dispatch(const ScriptArguments& args) {
+    do_unpacked_call(function, args);
+}
 }  // namespace script_bind
 
 /**
@@ -160,24 +280,48 @@ public:
         return name;
     }
 
-    template <class Tfunc>
-    void bind(ScriptFunctionID id, int argc, Tfunc function) {
-        functions.insert({id,
-                          {[=](const ScriptArguments& args) {
-                               script_bind::do_unpacked_call(function, args);
-                           },
-                           argc, "opcode", ""}});
+    /**
+     * Binds function to opcode id, which is decoded with argc parameters, or
+     * with a variable number of parameters if argc is -1.
+     *
+     * The parameters function unpacks must add up to argc, functions that
+     * only take ScriptArguments read the parameters themselves.
+     */
+    template <ScriptFunctionID id, int argc, auto function>
+    void bind() {
+        using traits = script_bind::function_traits<decltype(function)>;
+        static_assert(traits::valid_signature,
+                      "Script function has an unsupported signature");
+        static_assert(argc < 0 || traits::reads_arguments ||
+                          traits::parameters == argc,
+                      "Script function arguments don't match the opcode's "
+                      "parameter count");
+        static_assert(id < kMaxFunctions, "Opcode out of range");
+        bind(id, argc, &script_bind::dispatch<function>);
     }
 
-    bool findOpcode(ScriptFunctionID id, ScriptFunctionMeta** out);
+    void bind(ScriptFunctionID id, int argc, ScriptFunction function);
+
+    bool findOpcode(ScriptFunctionID id, ScriptFunctionMeta** out) {
+        if (id >= functions.size() || !functions[id]) {
+            return false;
+        }
+        *out = functions[id].get();
+        return true;
+    }
 
     void reserveFunctions(size_t nr) {
         functions.reserve(nr);
     }
 
 private:
+    /// Opcodes are 15 bits, the top bit negates conditions
+    static constexpr size_t kMaxFunctions = 0x8000;
+
     const std::string name;
-    std::unordered_map<ScriptFunctionID, ScriptFunctionMeta> functions;
+    /// Indexed by opcode, the metadata doesn't move so decoded instructions
+    /// can keep pointers to it
+    std::vector<std::unique_ptr<ScriptFunctionMeta>> functions;
 };
 
 #endif
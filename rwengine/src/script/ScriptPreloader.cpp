@@ -0,0 +1,195 @@
+#include "script/ScriptPreloader.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "core/Logger.hpp"
+#include "core/Profiler.hpp"
+#include "engine/GameData.hpp"
+#include "engine/GameState.hpp"
+#include "engine/GameWorld.hpp"
+#include "script/SCMFile.hpp"
+#include "script/ScriptMachine.hpp"
+
+namespace {
+/// Stop looking ahead after this many instructions
+constexpr int kMaxScannedInstructions = 20000;
+
+constexpr SCMOpcode kLoadSpecialCharacter = 0x023c;
+constexpr SCMOpcode kRequestModel = 0x0247;
+constexpr SCMOpcode kLoadSpecialModel = 0x02f3;
+constexpr SCMOpcode kLoadWav = 0x03cf;
+
+std::string lowerString(const SCMOpcodeParameter& p) {
+    std::string s(p.string, strnlen(p.string, sizeof(p.string)));
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+}  // namespace
+
+ScriptPreloader::ScriptPreloader(ScriptMachine& machine) : machine(machine) {
+}
+
+void ScriptPreloader::requestModel(ModelID model) {
+    auto data = machine.getState()->world->data;
+    requested.insert(model);
+    data->prefetchModel(model);
+}
+
+void ScriptPreloader::releaseModel(ModelID model) {
+    if (requested.erase(model) == 0) {
+        return;
+    }
+    auto data = machine.getState()->world->data;
+    auto info = data->modelinfo.find(model);
+    if (info == data->modelinfo.end() || info->second->isLoaded()) {
+        return;
+    }
+
+    // Drop the files read for it
+    std::string name;
+    std::string slot;
+    data->getModelFiles(model, name, slot);
+    data->discardPrefetchedFile(name + ".dff");
+    std::string otherName;
+    std::string otherSlot;
+    for (auto other : requested) {
+        data->getModelFiles(other, otherName, otherSlot);
+        if (otherSlot == slot) {
+            // The texture dictionary is still needed
+            return;
+        }
+    }
+    data->discardPrefetchedFile(slot + ".txd");
+}
+
+bool ScriptPreloader::isModelLoaded(ModelID model) {
+    auto data = machine.getState()->world->data;
+    auto info = data->modelinfo.find(model);
+    if (info == data->modelinfo.end() || info->second->isLoaded()) {
+        return true;
+    }
+    requestModel(model);
+    if (!data->isModelReady(model)) {
+        return false;
+    }
+    return finishLoading(model);
+}
+
+void ScriptPreloader::loadRequestedModels() {
+    RW_PROFILE_SCOPE(__func__);
+    auto data = machine.getState()->world->data;
+    for (auto model : requested) {
+        auto info = data->modelinfo.find(model);
+        if (info != data->modelinfo.end() && !info->second->isLoaded()) {
+            finishLoading(model);
+        }
+    }
+}
+
+bool ScriptPreloader::finishLoading(ModelID model) {
+    RW_PROFILE_SCOPE(__func__);
+    auto world = machine.getState()->world;
+    if (!world->data->loadModel(model)) {
+        // Scripts wait for models to load, don't let a missing file stall
+        // them forever
+        world->logger->error("Script", "Failed to load requested model " +
+                                           std::to_string(model));
+    }
+    return true;
+}
+
+std::size_t ScriptPreloader::preloadMission(unsigned int mission) {
+    RW_PROFILE_SCOPE(__func__);
+    auto& file = machine.getFile();
+    const auto& offsets = file.getMissionOffsets();
+    if (mission >= offsets.size()) {
+        return 0;
+    }
+    const SCMAddress start = offsets[mission];
+    const SCMAddress end =
+        mission + 1 < offsets.size() ? offsets[mission + 1]
+                                     : static_cast<SCMAddress>(file.getSize());
+
+    auto data = machine.getState()->world->data;
+
+    // The previous mission is over, drop what it didn't use
+    for (const auto& name : missionFiles) {
+        data->discardPrefetchedFile(name);
+    }
+    missionFiles.clear();
+
+    auto prefetch = [&](const std::string& name) {
+        data->prefetchFile(name);
+        missionFiles.push_back(name);
+    };
+    auto prefetchTextures = [&](const std::string& name) {
+        data->prefetchTextures(name);
+        missionFiles.push_back(name);
+    };
+
+    std::size_t found = 0;
+    std::size_t audio = 0;
+    int scanned = 0;
+    machine.scanCode(
+        start, end,
+        [&](const SCMInstruction& instruction, const SCMParams& params) {
+            const auto& p = params;
+            switch (instruction.opcode) {
+                case kRequestModel: {
+                    if (p.size() < 1 || p[0].isLvalue()) {
+                        break;
+                    }
+                    auto id = p[0].integerValue();
+                    if (id < 0) {
+                        const auto& models = file.getModels();
+                        if (static_cast<size_t>(-id) >= models.size()) {
+                            break;
+                        }
+                        id = data->findModelObject(models[-id]);
+                    }
+                    auto info = data->modelinfo.find(id);
+                    if (info == data->modelinfo.end() ||
+                        info->second->isLoaded()) {
+                        break;
+                    }
+                    std::string name;
+                    std::string slot;
+                    data->getModelFiles(id, name, slot);
+                    data->prefetchModel(id);
+                    missionFiles.push_back(name + ".dff");
+                    missionFiles.push_back(slot + ".txd");
+                    ++found;
+                } break;
+                case kLoadSpecialCharacter:
+                case kLoadSpecialModel: {
+                    if (p.size() < 2 || p[1].type != TString) {
+                        break;
+                    }
+                    auto name = lowerString(p[1]);
+                    prefetch(name + ".dff");
+                    prefetchTextures(name + ".txd");
+                    ++found;
+                } break;
+                case kLoadWav: {
+                    if (p.size() < 1 || p[0].type != TString) {
+                        break;
+                    }
+                    auto name = lowerString(p[0]) + ".wav";
+                    data->prefetchAudioClip(name);
+                    missionFiles.push_back("audio/" + name);
+                    ++audio;
+                } break;
+                default:
+                    break;
+            }
+            return ++scanned < kMaxScannedInstructions;
+        });
+
+    machine.getState()->world->logger->info(
+        "Script", "Preloading " + std::to_string(found) + " models and " +
+                      std::to_string(audio) + " audio clips for mission " +
+                      std::to_string(mission));
+    return found;
+}
@@ -0,0 +1,73 @@
+#ifndef _RWENGINE_SCRIPTPRELOADER_HPP_
+#define _RWENGINE_SCRIPTPRELOADER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+class ScriptMachine;
+
+/**
+ * @brief Streams in the models requested by the scripts
+ *
+ * request_model and load_special_actor start reading the model's files on
+ * the data workers, and the "model loaded" conditions only become true once
+ * the files have been read and the model was created from them. Starting a
+ * mission looks ahead through its code for the models and mission audio it
+ * requests, so their files are usually read before the mission asks for
+ * them.
+ *
+ * Only the reading happens off the main thread, creating the models needs
+ * the GL context and the audio is buffered by load_wav.
+ */
+class ScriptPreloader {
+public:
+    using ModelID = std::uint16_t;
+
+    explicit ScriptPreloader(ScriptMachine& machine);
+
+    /**
+     * @brief Starts reading the files of model if it isn't loaded
+     */
+    void requestModel(ModelID model);
+
+    /**
+     * @brief Forgets a request, the model stays loaded. Files read for a
+     * model that isn't loaded are dropped.
+     */
+    void releaseModel(ModelID model);
+
+    /**
+     * @return true once the model is loaded, creating it if its files have
+     * been read. Models are requested if they weren't before.
+     */
+    bool isModelLoaded(ModelID model);
+
+    /**
+     * @brief Loads every requested model now, waiting for their files
+     */
+    void loadRequestedModels();
+
+    /**
+     * @brief Prefetches the models and mission audio that the code of a
+     * mission requests with immediate values
+     * @return The number of models and special characters found
+     */
+    std::size_t preloadMission(unsigned int mission);
+
+    std::size_t getRequestedCount() const {
+        return requested.size();
+    }
+
+private:
+    bool finishLoading(ModelID model);
+
+    ScriptMachine& machine;
+    std::set<ModelID> requested;
+    /// Files prefetched for the last preloaded mission
+    std::vector<std::string> missionFiles;
+};
+
+#endif
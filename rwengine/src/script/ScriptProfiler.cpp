@@ -0,0 +1,199 @@
+#include "script/ScriptProfiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+
+#include "script/ScriptMachine.hpp"
+
+namespace {
+constexpr std::size_t kOpcodeCount = 0x8000;
+constexpr std::size_t kExportedAddresses = 100;
+
+std::uint64_t elapsed(ScriptProfiler::Clock::time_point since) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            ScriptProfiler::Clock::now() - since)
+            .count());
+}
+
+std::string opcodeName(SCMOpcode opcode) {
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(4) << std::hex << opcode;
+    return ss.str();
+}
+
+std::string signature(const ScriptProfiler::OpcodeStats& stats) {
+    return stats.code ? stats.code->signature : std::string();
+}
+
+/// Quotes s for CSV and JSON, neither of which needs more than escaping
+/// quotes for thread names and opcode signatures
+std::string quoted(const std::string& s, char escape) {
+    std::string out = "\"";
+    for (auto c : s) {
+        if (c == '"' || (escape == '\\' && c == '\\')) {
+            out += escape;
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+}  // namespace
+
+ScriptProfiler::ScriptProfiler() {
+    reset();
+}
+
+void ScriptProfiler::reset(std::size_t codeSize) {
+    opcodes.assign(kOpcodeCount, {});
+    for (auto i = 0u; i < kOpcodeCount; ++i) {
+        opcodes[i].opcode = static_cast<SCMOpcode>(i);
+    }
+    addressHits.assign(codeSize, 0);
+    threads.clear();
+    currentThread = nullptr;
+    ticks = 0;
+    lastTickTime = 0;
+    totalTime = 0;
+}
+
+void ScriptProfiler::beginTick() {
+    tickStart = Clock::now();
+}
+
+void ScriptProfiler::endTick() {
+    lastTickTime = elapsed(tickStart);
+    totalTime += lastTickTime;
+    ++ticks;
+}
+
+void ScriptProfiler::beginThread(const SCMThread& thread) {
+    currentThread = &threads[thread.baseAddress];
+    threadInstructions = 0;
+    threadStart = Clock::now();
+}
+
+void ScriptProfiler::endThread(const SCMThread& thread) {
+    const auto time = elapsed(threadStart);
+    auto& stats = *currentThread;
+    currentThread = nullptr;
+    if (threadInstructions == 0) {
+        return;
+    }
+
+    // Threads get their name from an opcode after they start
+    stats.name = thread.name;
+    stats.baseAddress = thread.baseAddress;
+    ++stats.ticks;
+    stats.instructions += threadInstructions;
+    stats.time += time;
+    stats.tickInstructions = threadInstructions;
+    stats.tickTime = time;
+    stats.peakTickTime = std::max(stats.peakTickTime, time);
+}
+
+std::vector<ScriptProfiler::OpcodeStats> ScriptProfiler::getOpcodeStats()
+    const {
+    std::vector<OpcodeStats> stats;
+    std::copy_if(opcodes.begin(), opcodes.end(), std::back_inserter(stats),
+                 [](const OpcodeStats& s) { return s.count > 0; });
+    std::sort(stats.begin(), stats.end(),
+              [](const OpcodeStats& a, const OpcodeStats& b) {
+                  return a.time > b.time;
+              });
+    return stats;
+}
+
+std::vector<ScriptProfiler::ThreadStats> ScriptProfiler::getThreadStats()
+    const {
+    std::vector<ThreadStats> stats;
+    for (const auto& thread : threads) {
+        if (thread.second.ticks > 0) {
+            stats.push_back(thread.second);
+        }
+    }
+    std::sort(stats.begin(), stats.end(),
+              [](const ThreadStats& a, const ThreadStats& b) {
+                  return a.time > b.time;
+              });
+    return stats;
+}
+
+std::vector<std::pair<SCMAddress, std::uint64_t>>
+ScriptProfiler::getHotAddresses(std::size_t count) const {
+    std::vector<std::pair<SCMAddress, std::uint64_t>> hot;
+    for (auto address = 0u; address < addressHits.size(); ++address) {
+        if (addressHits[address] > 0) {
+            hot.emplace_back(address, addressHits[address]);
+        }
+    }
+    count = std::min(count, hot.size());
+    std::partial_sort(hot.begin(), hot.begin() + count, hot.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second > b.second;
+                      });
+    hot.resize(count);
+    return hot;
+}
+
+void ScriptProfiler::writeCSV(std::ostream& out) const {
+    out << "kind,id,name,ticks,count,time_us\n";
+    for (const auto& op : getOpcodeStats()) {
+        out << "opcode," << opcodeName(op.opcode) << ","
+            << quoted(signature(op), '"') << ",," << op.count << ","
+            << op.time / 1000 << "\n";
+    }
+    for (const auto& thread : getThreadStats()) {
+        out << "thread," << thread.baseAddress << ","
+            << quoted(thread.name, '"') << "," << thread.ticks << ","
+            << thread.instructions << "," << thread.time / 1000 << "\n";
+    }
+    for (const auto& address : getHotAddresses(kExportedAddresses)) {
+        out << "address," << address.first << ",,," << address.second
+            << ",\n";
+    }
+}
+
+void ScriptProfiler::writeJSON(std::ostream& out) const {
+    out << "{\n  \"ticks\": " << ticks << ",\n  \"time_us\": "
+        << totalTime / 1000 << ",\n  \"opcodes\": [";
+    const char* separator = "\n";
+    for (const auto& op : getOpcodeStats()) {
+        out << separator << "    {\"opcode\": \"" << opcodeName(op.opcode)
+            << "\", \"name\": " << quoted(signature(op), '\\')
+            << ", \"count\": " << op.count << ", \"time_us\": "
+            << op.time / 1000 << "}";
+        separator = ",\n";
+    }
+    out << "\n  ],\n  \"threads\": [";
+    separator = "\n";
+    for (const auto& thread : getThreadStats()) {
+        out << separator << "    {\"name\": " << quoted(thread.name, '\\')
+            << ", \"address\": " << thread.baseAddress
+            << ", \"ticks\": " << thread.ticks
+            << ", \"instructions\": " << thread.instructions
+            << ", \"time_us\": " << thread.time / 1000
+            << ", \"peak_tick_us\": " << thread.peakTickTime / 1000 << "}";
+        separator = ",\n";
+    }
+    out << "\n  ],\n  \"hot_addresses\": [";
+    separator = "\n";
+    for (const auto& address : getHotAddresses(kExportedAddresses)) {
+        out << separator << "    {\"address\": " << address.first
+            << ", \"count\": " << address.second << "}";
+        separator = ",\n";
+    }
+    out << "\n  ]\n}\n";
+}
+
+bool ScriptProfiler::save(const std::string& path) const {
+    std::ofstream csv(path + ".csv");
+    writeCSV(csv);
+    std::ofstream json(path + ".json");
+    writeJSON(json);
+    return csv.good() && json.good();
+}
@@ -0,0 +1,128 @@
+#ifndef _RWENGINE_SCRIPTPROFILER_HPP_
+#define _RWENGINE_SCRIPTPROFILER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <script/ScriptTypes.hpp>
+
+struct SCMThread;
+
+/**
+ * @brief Collects instruction counts and timings of the script machine
+ *
+ * Keeps counters and cumulative time per opcode, instruction counts and time
+ * per thread, and the number of times each address was executed. It is only
+ * fed by ScriptMachine in builds with RW_SCRIPT_PROFILER (the
+ * ENABLE_SCRIPT_PROFILING option), other builds don't pay for it.
+ *
+ * Times are stored in nanoseconds.
+ */
+class ScriptProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct OpcodeStats {
+        SCMOpcode opcode = 0;
+        const ScriptFunctionMeta* code = nullptr;
+        std::uint64_t count = 0;
+        std::uint64_t time = 0;
+    };
+
+    struct ThreadStats {
+        std::string name;
+        SCMAddress baseAddress = 0;
+        /// Number of ticks the thread executed instructions in
+        std::uint64_t ticks = 0;
+        std::uint64_t instructions = 0;
+        std::uint64_t time = 0;
+        /// Instructions and time of the last tick the thread ran in
+        std::uint64_t tickInstructions = 0;
+        std::uint64_t tickTime = 0;
+        std::uint64_t peakTickTime = 0;
+    };
+
+    ScriptProfiler();
+
+    /**
+     * @brief Clears all statistics
+     * @param codeSize Size of the script, used to size the address histogram
+     */
+    void reset(std::size_t codeSize = 0);
+
+    void beginTick();
+    void endTick();
+
+    void beginThread(const SCMThread& thread);
+    void endThread(const SCMThread& thread);
+
+    void recordInstruction(const ScriptFunctionMeta* code, SCMOpcode opcode,
+                           SCMAddress address, Clock::duration time) {
+        const auto ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time)
+                .count());
+        auto& stats = opcodes[opcode & 0x7FFF];
+        stats.code = code;
+        ++stats.count;
+        stats.time += ns;
+
+        if (address >= addressHits.size()) {
+            addressHits.resize(address + 1, 0);
+        }
+        ++addressHits[address];
+        ++threadInstructions;
+    }
+
+    std::uint64_t getTickCount() const {
+        return ticks;
+    }
+
+    std::uint64_t getLastTickTime() const {
+        return lastTickTime;
+    }
+
+    std::uint64_t getTotalTime() const {
+        return totalTime;
+    }
+
+    /// @return Opcodes that were executed, slowest first
+    std::vector<OpcodeStats> getOpcodeStats() const;
+
+    /// @return Threads that ran, slowest first
+    std::vector<ThreadStats> getThreadStats() const;
+
+    /// @return The count most executed addresses and their counts
+    std::vector<std::pair<SCMAddress, std::uint64_t>> getHotAddresses(
+        std::size_t count) const;
+
+    void writeCSV(std::ostream& out) const;
+    void writeJSON(std::ostream& out) const;
+
+    /**
+     * @brief Writes path.csv and path.json
+     * @return false if either file can't be written
+     */
+    bool save(const std::string& path) const;
+
+private:
+    std::vector<OpcodeStats> opcodes;
+    std::vector<std::uint64_t> addressHits;
+    /// Threads by base address, restarted missions share their entry
+    std::unordered_map<SCMAddress, ThreadStats> threads;
+    ThreadStats* currentThread = nullptr;
+    std::uint64_t threadInstructions = 0;
+
+    Clock::time_point tickStart;
+    Clock::time_point threadStart;
+    std::uint64_t ticks = 0;
+    std::uint64_t lastTickTime = 0;
+    std::uint64_t totalTime = 0;
+};
+
+#endif
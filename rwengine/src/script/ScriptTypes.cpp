@@ -245,7 +245,9 @@ ScriptObjectType<Sound> ScriptArguments::getScriptObject(
     unsigned int arg) const {
     auto& param = (*this)[arg];
     RW_CHECK(param.isLvalue(), "Non lvalue passed as object");
-    return {param.handleValue(), &getWorld()->sound.getSfxBufferRef(arg)};
+    return {param.handleValue(),
+            getWorld()->sound.getSfxVoice(
+                static_cast<size_t>(*param.handleValue()))};
 }
 
 template <>
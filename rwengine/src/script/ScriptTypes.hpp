@@ -200,6 +200,9 @@ struct SCMOpcodeParameter {
         int32_t* globalInteger;
         float* globalReal;
     };
+    /// Set when a variable is outside of its storage, reported when the
+    /// instruction runs
+    bool outOfBounds = false;
 
     int integerValue() const {
         switch (type) {
@@ -359,8 +362,8 @@ template <>
 ScriptObjectType<Sound> ScriptArguments::getScriptObject(
     unsigned int arg) const;
 
-typedef std::function<void(const ScriptArguments&)> ScriptFunction;
-typedef std::function<bool(const ScriptArguments&)> ScriptFunctionBoolean;
+typedef void (*ScriptFunction)(const ScriptArguments&);
+typedef bool (*ScriptFunctionBoolean)(const ScriptArguments&);
 typedef uint16_t ScriptFunctionID;
 
 struct ScriptFunctionMeta {
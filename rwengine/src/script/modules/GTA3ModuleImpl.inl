@@ -941,8 +941,7 @@ void opcode_0054(const ScriptArguments& args, const ScriptPlayer player, ScriptF
     @arg coord Coordinates
 */
 void opcode_0055(const ScriptArguments& args, const ScriptPlayer player, ScriptVec3 coord) {
-    player->getCharacter()->setPosition(coord);
-    player->getCharacter()->applyOffset();
+    script::setObjectPosition(player->getCharacter(), coord);
     script::clearSpaceForObject(args, player->getCharacter());
 }
 
@@ -1833,11 +1832,9 @@ void opcode_009c(const ScriptArguments& args, const ScriptCharacter character, c
     @brief char_wander_range
 
     opcode 009d
-    @arg character 
 */
-void opcode_009d(const ScriptArguments& args, const ScriptCharacter character) {
+void opcode_009d(const ScriptArguments& args) {
     RW_UNIMPLEMENTED_OPCODE(0x009d);
-    RW_UNUSED(character);
     RW_UNUSED(args);
 }
 
@@ -4291,7 +4288,8 @@ void opcode_018b(const ScriptArguments& args, const ScriptBlip blip, const Scrip
 void opcode_018c(const ScriptArguments& args, ScriptVec3 coord, const ScriptSoundType sound) {
     auto world = args.getWorld();
     auto metaData = getSoundInstanceData(sound);
-    auto name = world->sound.createSfxInstance(metaData->sfx);
+    auto name =
+        world->sound.createSfxInstance(metaData->sfx, coord, metaData->range);
     world->sound.playSfx(name, coord, false, metaData->range);
 }
 
@@ -4306,9 +4304,15 @@ void opcode_018c(const ScriptArguments& args, ScriptVec3 coord, const ScriptSoun
 void opcode_018d(const ScriptArguments& args, ScriptVec3 coord, const ScriptSoundType sound0, ScriptSound& sound1) {
     auto world = args.getWorld();
     auto metaData = getSoundInstanceData(sound0);
-    auto bufferName = world->sound.createSfxInstance(metaData->sfx);
+    auto bufferName =
+        world->sound.createSfxInstance(metaData->sfx, coord, metaData->range);
     world->sound.playSfx(bufferName, coord, true, metaData->range);
-    sound1 = &world->sound.getSfxBufferRef(bufferName);
+    if (auto voice = world->sound.getSfxVoice(bufferName)) {
+        sound1 = voice;
+    } else {
+        // All voices are busy with louder sounds
+        *sound1.m_id = -1;
+    }
 }
 
 /**
@@ -4318,8 +4322,8 @@ void opcode_018d(const ScriptArguments& args, ScriptVec3 coord, const ScriptSoun
     @arg sound 
 */
 void opcode_018e(const ScriptArguments& args, const ScriptSound sound) {
-    RW_UNUSED(args);
-    sound->stop();
+    // Stale handles of stolen voices are ignored
+    args.getWorld()->sound.stopSfx(static_cast<size_t>(*sound.m_id));
 }
 
 /**
@@ -6479,6 +6483,8 @@ void opcode_023b(const ScriptArguments& args, const ScriptCharacter character, c
 */
 void opcode_023c(const ScriptArguments& args, const ScriptInt arg1, const ScriptString arg2) {
     args.getWorld()->loadSpecialCharacter(arg1, arg2);
+    args.getVM()->getPreloader().requestModel(
+        GameWorld::getSpecialCharacterModel(arg1));
 }
 
 /**
@@ -6488,18 +6494,8 @@ void opcode_023c(const ScriptArguments& args, const ScriptInt arg1, const Script
     @arg arg1 
 */
 bool opcode_023d(const ScriptArguments& args, const ScriptInt arg1) {
-    /// @todo re-implement this when streaming is added
-    return true;
-    RW_UNUSED(args);
-    RW_UNUSED(arg1);
-#if 0
-    auto model = args.getState()->specialCharacters[arg1];
-    auto modelfind = args.getWorld()->data->models.find(model);
-    if( modelfind != args.getWorld()->data->models.end() && modelfind->second->resource != nullptr ) {
-    	return true;
-    }
-    return false;
-#endif
+    return args.getVM()->getPreloader().isModelLoaded(
+        GameWorld::getSpecialCharacterModel(arg1));
 }
 
 /**
@@ -6590,9 +6586,7 @@ void opcode_0245(const ScriptArguments& args, const ScriptCharacter character, c
     @arg model Model ID
 */
 void opcode_0247(const ScriptArguments& args, const ScriptModel model) {
-    RW_UNIMPLEMENTED_OPCODE(0x0247);
-    RW_UNUSED(model);
-    RW_UNUSED(args);
+    args.getVM()->getPreloader().requestModel(script::getModel(args, model));
 }
 
 /**
@@ -6602,10 +6596,8 @@ void opcode_0247(const ScriptArguments& args, const ScriptModel model) {
     @arg model Model ID
 */
 bool opcode_0248(const ScriptArguments& args, const ScriptModel model) {
-    RW_UNIMPLEMENTED_OPCODE(0x0248);
-    RW_UNUSED(model);
-    RW_UNUSED(args);
-    return true;
+    return args.getVM()->getPreloader().isModelLoaded(
+        script::getModel(args, model));
 }
 
 /**
@@ -6615,9 +6607,7 @@ bool opcode_0248(const ScriptArguments& args, const ScriptModel model) {
     @arg model Model ID
 */
 void opcode_0249(const ScriptArguments& args, const ScriptModel model) {
-    RW_UNIMPLEMENTED_OPCODE(0x0249);
-    RW_UNUSED(model);
-    RW_UNUSED(args);
+    args.getVM()->getPreloader().releaseModel(script::getModel(args, model));
 }
 
 /**
@@ -6808,9 +6798,8 @@ void opcode_0294(const ScriptArguments& args, const ScriptVehicle vehicle, const
     @arg arg1 
 */
 void opcode_0296(const ScriptArguments& args, const ScriptInt arg1) {
-    RW_UNIMPLEMENTED_OPCODE(0x0296);
-    RW_UNUSED(arg1);
-    RW_UNUSED(args);
+    args.getVM()->getPreloader().releaseModel(
+        GameWorld::getSpecialCharacterModel(arg1));
 }
 
 /**
@@ -7720,25 +7709,29 @@ void opcode_02dd(const ScriptArguments& args, const ScriptString areaName, Scrip
     if (zone) {
         // Create a list of candidate characters by iterating and checking if the char is in this zone
         std::vector<std::pair<GameObjectID, GameObject*>> candidates;
-        for (auto& [id, pedestrianPtr] : args.getWorld()->pedestrianPool.objects) {
-            auto character = static_cast<CharacterObject*>(pedestrianPtr.get());
+        auto& min = zone->min;
+        auto& max = zone->max;
+        const auto& grid = args.getWorld()->pedestrianPool.getGrid();
+        grid.visit(glm::vec2(min), glm::vec2(max), [&](GameObject* object) {
+            auto character = static_cast<CharacterObject*>(object);
 
             // We only consider characters walking around normally
             // @todo not sure if we are able to grab script objects or players too
             // husho: only grab traffic objects
             if (character->getLifetime() != GameObject::TrafficLifetime) {
-                continue;
+                return false;
             }
 
             // Check if character is in this zone
             auto cp = character->getPosition();
-            auto& min = zone->min;
-            auto& max = zone->max;
             if (cp.x > min.x && cp.y > min.y && cp.z > min.z &&
                 cp.x < max.x && cp.y < max.y && cp.z < max.z) {
-                candidates.emplace_back(id, pedestrianPtr.get());
+                candidates.emplace_back(character->getGameObjectID(), character);
             }
-        }
+            return false;
+        });
+        // Keep the random pick independent of the grid's order
+        std::sort(candidates.begin(), candidates.end());
 
         // Only return a result if we found a character
         const auto candidateCount = candidates.size();
@@ -7894,13 +7887,7 @@ void opcode_02e6(const ScriptArguments& args, const ScriptObject object,
     std::string animName = arg2;
     std::transform(animName.begin(), animName.end(), animName.begin(),
                    ::tolower);
-    auto anim = args.getWorld()->data->animationsCutscene.at(animName);
-    if (anim) {
-        cutscene->animator->playAnimation(AnimIndexMovement, anim, 1.f, false);
-    } else {
-        args.getWorld()->logger->error(
-            "SCM", "Failed to load cutscene anim: " + animName);
-    }
+    args.getWorld()->setCutsceneAnimation(cutscene, animName);
 }
 
 /**
@@ -7923,6 +7910,10 @@ void opcode_02e8(const ScriptArguments& args, ScriptInt& arg1) {
     if (args.getState()->skipCutscene) {
         arg1 = cutscene ? cutscene->tracks.duration * 1000 : 0.f;
     }
+    else if (args.getState()->cutsceneStartTime < 0.f) {
+        // Still loading
+        arg1 = 0;
+    }
     else {
     	arg1 = (args.getWorld()->getGameTime() - args.getState()->cutsceneStartTime) * 1000;
     }
@@ -7934,14 +7925,7 @@ void opcode_02e8(const ScriptArguments& args, ScriptInt& arg1) {
     opcode 02e9
 */
 bool opcode_02e9(const ScriptArguments& args) {
-    if (args.getState()->currentCutscene) {
-    	if (args.getState()->skipCutscene) {
-    		return true;
-    	}
-    	auto time = (args.getWorld()->getGameTime() - args.getWorld()->state->cutsceneStartTime);
-        return time >= args.getState()->currentCutscene->tracks.duration;
-    }
-    return true;
+    return args.getWorld()->isCutsceneDone();
 }
 
 /**
@@ -9057,29 +9041,20 @@ bool opcode_0339(const ScriptArguments& args, ScriptVec3 coord0, ScriptVec3 coor
     if (solids) {
     	RW_UNIMPLEMENTED("0x339: solid flag");
     }
-    if (actors) {
-    	auto& actors = args.getWorld()->pedestrianPool.objects;
-    	for (const auto& o : actors) {
-                if (script::objectInBounds(o.second.get(), coord0, coord1)) {
-    			return true;
-    		}
-    	}
+    const auto min = glm::min(glm::vec2(coord0), glm::vec2(coord1));
+    const auto max = glm::max(glm::vec2(coord0), glm::vec2(coord1));
+    const auto inCube = [&](GameObject* object) {
+        return script::objectInBounds(object, coord0, coord1);
+    };
+    auto world = args.getWorld();
+    if (actors && world->pedestrianPool.getGrid().visit(min, max, inCube)) {
+        return true;
     }
-    if (cars) {
-    	auto& cars = args.getWorld()->vehiclePool.objects;
-    	for (const auto& o : cars) {
-                if (script::objectInBounds(o.second.get(), coord0, coord1)) {
-    			return true;
-    		}
-    	}
+    if (cars && world->vehiclePool.getGrid().visit(min, max, inCube)) {
+        return true;
     }
-    if (objects) {
-    	auto& objects = args.getWorld()->instancePool.objects;
-    	for (const auto& o : objects) {
-                if (script::objectInBounds(o.second.get(), coord0, coord1)) {
-    			return true;
-    		}
-    	}
+    if (objects && world->instancePool.getGrid().visit(min, max, inCube)) {
+        return true;
     }
     return false;
 }
@@ -9628,30 +9603,17 @@ void opcode_0363(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloa
     auto& models = args.getVM()->getFile().getModels();
     auto& modelName = models[-model];
 
-    // Attempt to find the closest object
-    InstanceObject* closestObject = nullptr;
-    float closestDistance = radius;
-    for(auto& i : args.getWorld()->instancePool.objects) {
-        InstanceObject* object = static_cast<InstanceObject*>(i.second.get());
-
-    	// Check if this instance has the correct model id, early out if it isn't
-    	auto modelinfo = object->getModelInfo<BaseModelInfo>();
-    	if (!boost::iequals(modelinfo->name, modelName)) {
-    		continue;
-    	}
-
-    	// Calculate distance and check if this is the new closest object
-    	// @todo will this somehow respect the objects centre of mass / bounding box or something?
-    	float distance = glm::length(object->position - coord);
-    	if (distance <= closestDistance) {
-    		closestObject = object;
-    		closestDistance = distance;
-    	}
-    }
+    // Attempt to find the closest object with the model
+    // @todo will this somehow respect the objects centre of mass / bounding box or something?
+    auto closestObject = args.getWorld()->instancePool.getGrid().findNearest(
+        coord, radius, [&](GameObject* object) {
+            auto modelinfo = object->getModelInfo<BaseModelInfo>();
+            return boost::iequals(modelinfo->name, modelName);
+        });
 
     // If an object was found, set its visibility
     if (closestObject) {
-    closestObject->setVisible(visible);
+        static_cast<InstanceObject*>(closestObject)->setVisible(visible);
     }
 }
 
@@ -10302,8 +10264,7 @@ bool opcode_038a(const ScriptArguments& args, ScriptVec3 coord, ScriptVec3 radiu
     opcode 038b
 */
 void opcode_038b(const ScriptArguments& args) {
-    RW_UNIMPLEMENTED_OPCODE(0x038b);
-    RW_UNUSED(args);
+    args.getVM()->getPreloader().loadRequestedModels();
 }
 
 /**
@@ -10898,15 +10859,14 @@ void opcode_03b6(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloa
     auto newobjectid = args.getWorld()->data->findModelObject(newmodel);
     auto nobj = args.getWorld()->data->findModelInfo<SimpleModelInfo>(newobjectid);
 
-    for(auto& p : args.getWorld()->instancePool.objects) {
-        auto o = p.second.get();
-    	if( !o->getClump() ) continue;
-    	if( o->getModelInfo<BaseModelInfo>()->name != oldmodel ) continue;
-    	float d = glm::distance(coord, o->getPosition());
-    	if( d < radius ) {
-    		InstanceObject* inst = static_cast<InstanceObject*>(o);
-    		inst->changeModel(nobj);
-    	}
+    std::vector<GameObject*> objects;
+    args.getWorld()->instancePool.getGrid().findWithin(
+        coord, radius, objects, [&](GameObject* o) {
+            return o->getClump() &&
+                   o->getModelInfo<BaseModelInfo>()->name == oldmodel;
+        });
+    for (auto o : objects) {
+        static_cast<InstanceObject*>(o)->changeModel(nobj);
     }
 }
 
@@ -11346,8 +11306,8 @@ void opcode_03d6(const ScriptArguments& args, const ScriptString gxtEntry) {
 */
 void opcode_03d7(const ScriptArguments& args, ScriptVec3 coord) {
     auto world = args.getWorld();
-    auto& wav = world->sound.getSoundRef(world->missionAudio);
-    wav.setPosition(coord);
+    // Only sounds that loaded have a buffer
+    world->sound.setSoundPosition(world->missionAudio, coord);
 }
 
 /**
@@ -12047,6 +12007,7 @@ void opcode_0415(const ScriptArguments& args, const ScriptVehicle vehicle, const
 */
 void opcode_0417(const ScriptArguments& args, const ScriptInt arg1) {
     auto offset = args.getVM()->getFile().getMissionOffsets()[arg1];
+    args.getVM()->getPreloader().preloadMission(arg1);
     args.getVM()->startThread(offset, true);
 }
 
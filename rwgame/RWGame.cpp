@@ -12,8 +12,8 @@
 #include "states/MenuState.hpp"
 
 #include <core/Profiler.hpp>
+#include <core/TraceRecorder.hpp>
 
-#include <engine/Payphone.hpp>
 #include <engine/SaveGame.hpp>
 #include <objects/GameObject.hpp>
 
@@ -22,11 +22,15 @@
 #include <ai/AIGraphNode.hpp>
 #include <ai/PlayerController.hpp>
 #include <core/Logger.hpp>
+#include <dynamics/CollisionShape.hpp>
+#include <dynamics/PhysicsQueries.hpp>
 #include <objects/CharacterObject.hpp>
 #include <objects/VehicleObject.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -70,15 +74,54 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
         test = args->test;
         startSave = args->loadGamePath;
         benchFile = args->benchmarkPath;
+        bvhCachePath = args->bvhCachePath;
+        dataSnapshotPath = args->dataSnapshotPath;
+        sfxBankPath = args->sfxBankPath;
+        if (args->tracePath.has_value()) {
+            tracePath = *args->tracePath;
+        }
     }
 
     imgui.init();
 
     log.info("Game", "Game directory: " + config.gamedataPath());
+    if (dataSnapshotPath.has_value()) {
+        if (data.snapshot.load(*dataSnapshotPath)) {
+            log.info("Game", "Loaded " + std::to_string(data.snapshot.size()) +
+                                 " data snapshot entries from " +
+                                 *dataSnapshotPath);
+        } else {
+            log.warning("Game", "No usable data snapshot at " +
+                                    *dataSnapshotPath);
+        }
+    }
+    auto loadTimeStart = std::chrono::steady_clock::now();
     if (!data.load()) {
         throw std::runtime_error("Invalid game directory path: " +
                                  config.gamedataPath());
     }
+    auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - loadTimeStart);
+    log.info("Game", "Loading data took " + std::to_string(loadTime.count()) +
+                         " ms");
+
+    // Everything in the snapshot is read by load(), so write it now rather
+    // than waiting for a new game, which loading a save skips
+    if (dataSnapshotPath.has_value() && data.snapshot.isDirty()) {
+        if (!data.snapshot.save(*dataSnapshotPath)) {
+            log.error("Game",
+                      "Failed to write data snapshot " + *dataSnapshotPath);
+        }
+    }
+
+    if (bvhCachePath.has_value()) {
+        if (data.bvhCache.load(*bvhCachePath)) {
+            log.info("Game", "Loaded " + std::to_string(data.bvhCache.size()) +
+                                 " collision BVHs from " + *bvhCachePath);
+        } else {
+            log.warning("Game", "No usable BVH cache at " + *bvhCachePath);
+        }
+    }
 
     for (const auto& [specialModel, fileName, name] : kSpecialModels) {
         auto model = data.loadClump(fileName, name);
@@ -106,11 +149,18 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
     getRenderer().water.setWaterTable(data.waterHeights, 48, data.realWater,
                                       128 * 128);
 
+    // The map shader can't draw paletted textures
     for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
         std::ostringstream oss;
-        oss << "radar" << std::setw(2) << std::setfill('0') << m << ".txd";
-        data.loadTXD(oss.str());
+        oss << "radar" << std::setw(2) << std::setfill('0') << m;
+        data.textureSlots[oss.str()] =
+            data.loadTextureArchive(oss.str() + ".txd");
     }
+    data.keepTexturePalettes = config.paletteTextures();
+    data.packTextureArrays = config.textureArrays();
+    data.textureResidency.setBudget(
+        static_cast<size_t>(std::max(config.textureBudget(), 0)) * 1024 *
+        1024);
 
     stateManager.enter<LoadingState>(this, [=]() {
         if (benchFile.has_value()) {
@@ -137,6 +187,22 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
 
 RWGame::~RWGame() {
     log.info("Game", "Beginning cleanup");
+
+    if (TraceRecorder::isCapturing()) {
+        toggleTrace();
+    }
+
+#ifdef RW_SCRIPT_PROFILER
+    if (vm) {
+        auto path = getenv("OPENRW_SCRIPT_PROFILE");
+        std::string profile = path ? path : "script_profile";
+        if (vm->getProfiler().save(profile)) {
+            log.info("Game", "Script profile written to " + profile);
+        } else {
+            log.error("Game", "Failed to write script profile " + profile);
+        }
+    }
+#endif
 }
 
 void RWGame::newGame() {
@@ -144,17 +210,52 @@ void RWGame::newGame() {
     state = GameState();
 
     // Destroy the current world and start over
-    world = std::make_unique<GameWorld>(&log, &data);
+    world = std::make_unique<GameWorld>(&log, &data,
+                                        config.physicsMultithreaded());
     world->dynamicsWorld->setDebugDrawer(&debug);
+    world->sound.setMaxSfxSources(
+        static_cast<size_t>(std::max(config.maxSfxSources(), 0)));
+
+    if (sfxBankPath.has_value()) {
+        auto bankTimeStart = std::chrono::steady_clock::now();
+        if (world->sound.loadSfxBank(*sfxBankPath, data.workers)) {
+            auto bankTime =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - bankTimeStart);
+            log.info("Game", "Loaded " +
+                                 std::to_string(world->sound.getSfxBank().size()) +
+                                 " sfx from " + *sfxBankPath + " in " +
+                                 std::to_string(bankTime.count()) + " ms");
+        } else {
+            log.warning("Game", "Failed to load sfx bank " + *sfxBankPath);
+        }
+    }
 
     // Associate the new world with the new state and vice versa
     state.world = world.get();
     world->state = &state;
 
+    auto placeTimeStart = std::chrono::steady_clock::now();
     for (auto ipl : world->data->iplLocations) {
         world->data->loadZone(ipl.second);
         world->placeItems(ipl.second);
     }
+    auto placeTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - placeTimeStart);
+    const auto shapeKB = CollisionShape::getShapeBytes() / 1024;
+    const auto bvhKB = CollisionShape::getBvhBytes() / 1024;
+    log.info("Game", "Placing items took " +
+                         std::to_string(placeTime.count()) + " ms, " +
+                         std::to_string(CollisionShape::getShapeCount()) +
+                         " collision shapes using " +
+                         std::to_string(shapeKB) + " KB, their BVHs " +
+                         std::to_string(bvhKB) + " KB");
+
+    if (bvhCachePath.has_value() && data.bvhCache.isDirty()) {
+        if (!data.bvhCache.save(*bvhCachePath)) {
+            log.error("Game", "Failed to write BVH cache " + *bvhCachePath);
+        }
+    }
 }
 
 bool RWGame::hitWorldRay(glm::vec3 &hit, glm::vec3 &normal, GameObject **object) {
@@ -468,10 +569,15 @@ float RWGame::tickWorld(const float deltaTime, float accumulatedTime) {
 
         {
             RW_PROFILE_SCOPEC("stepSimulation", MP_DARKORANGE1);
+            auto stepStart = std::chrono::steady_clock::now();
             world->dynamicsWorld->stepSimulation(
                     deltaTimeWithTimeScale, kMaxPhysicsSubSteps, deltaTime);
+            physicsStepTime = std::chrono::duration<float, std::milli>(
+                    std::chrono::steady_clock::now() - stepStart).count();
         }
 
+        world->queries->flush();
+
         stateManager.tick(deltaTimeWithTimeScale);
 
         tick(deltaTimeWithTimeScale);
@@ -530,58 +636,10 @@ void RWGame::tick(float dt) {
     RW_PROFILE_SCOPE(__func__);
     State* currState = stateManager.states.back().get();
 
-    static float clockAccumulator = 0.f;
-    static float scriptTimerAccumulator = 0.f;
-    static ScriptInt beepTime = std::numeric_limits<ScriptInt>::max();
     if (currState->shouldWorldUpdate()) {
-        world->chase.update(dt);
-
-        // Clear out any per-tick state.
-        world->clearTickData();
-
-        state.gameTime += dt;
-
-        clockAccumulator += dt;
-        while (clockAccumulator >= 1.f) {
-            state.basic.gameMinute++;
-            while (state.basic.gameMinute >= 60) {
-                state.basic.gameMinute = 0;
-                state.basic.gameHour++;
-                while (state.basic.gameHour >= 24) {
-                    state.basic.gameHour = 0;
-                }
-            }
-            clockAccumulator -= 1.f;
-        }
-
-        constexpr float timerClockRate = 1.f / 30.f;
-
-        if (state.scriptTimerVariable && !state.scriptTimerPaused) {
-            scriptTimerAccumulator += dt;
-            while (scriptTimerAccumulator >= timerClockRate) {
-                // Original game uses milliseconds
-                (*state.scriptTimerVariable) -= timerClockRate * 1000;
-
-                //                                11 seconds
-                if (*state.scriptTimerVariable <= 11000 &&
-                    beepTime - *state.scriptTimerVariable >= 1000) {
-                    beepTime = *state.scriptTimerVariable;
+        world->tickTime(dt);
 
-                    // @todo beep
-                }
-
-                if (*state.scriptTimerVariable <= 0) {
-                    (*state.scriptTimerVariable) = 0;
-                    state.scriptTimerVariable = nullptr;
-                }
-
-                scriptTimerAccumulator -= timerClockRate;
-            }
-        }
-
-        tickObjects(dt);
-
-        state.text.tick(dt);
+        world->tickObjects(dt);
 
         if (vm) {
             try {
@@ -593,49 +651,16 @@ void RWGame::tick(float dt) {
             }
         }
 
+        world->sound.updateSfxVoices(dt);
+
         /// @todo this doesn't make sense as the condition
         if (state.playerObject) {
-            currentCam.frustum.update(currentCam.frustum.projection() *
-                                      currentCam.getView());
             // Use the current camera position to spawn pedestrians.
-            world->cleanupTraffic(currentCam);
-            // Only create new traffic outside cutscenes
-            if (!state.currentCutscene) {
-                world->createTraffic(currentCam);
-            }
+            world->updateTraffic(currentCam);
         }
     }
 }
 
-void RWGame::tickObjects(float dt) const {
-    RW_PROFILE_SCOPEC(__func__, MP_MAGENTA1);
-    world->updateEffects();
-
-    {
-        RW_PROFILE_SCOPEC("allObjects", MP_HOTPINK1);
-        RW_PROFILE_COUNTER_SET("tickObjects/allObjects", world->allObjects.size());
-        for (auto &object : world->allObjects) {
-            object->tick(dt);
-        }
-    }
-
-    {
-        RW_PROFILE_SCOPEC("garages", MP_HOTPINK2);
-        for (auto &g : world->garages) {
-            g->tick(dt);
-        }
-    }
-
-    {
-        RW_PROFILE_SCOPEC("payphones", MP_HOTPINK3);
-        for (auto &p : world->payphones) {
-            p->tick(dt);
-        }
-    }
-
-    world->destroyQueuedObjects();
-}
-
 void RWGame::render(float alpha, float time) {
     RW_PROFILE_SCOPEC(__func__, MP_CORNFLOWERBLUE);
     RW_UNUSED(time);
@@ -664,6 +689,13 @@ void RWGame::render(float alpha, float time) {
 
     world->sound.updateListenerTransform(viewCam);
 
+    data.updateTextureResidency();
+    data.textureUploader.process(TextureUploader::kDefaultFrameBudget);
+    RW_PROFILE_COUNTER_SET("textures/pendingBytes",
+                           data.textureUploader.getPendingBytes());
+    RW_PROFILE_COUNTER_SET("textures/residentBytes",
+                           data.textureResidency.getResidentBytes());
+
     glEnable(GL_DEPTH_TEST);
     glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 
@@ -804,6 +836,22 @@ void RWGame::renderDebugPaths() {
     debug.flush(renderer);
 }
 
+void RWGame::toggleTrace() {
+    if (!TraceRecorder::isCapturing()) {
+        TraceRecorder::start();
+        log.info("Game", "Recording trace");
+        return;
+    }
+#ifdef RW_PROFILER
+    log.warning("Game", "Profile scopes go to microprofile, the trace is empty");
+#endif
+    if (TraceRecorder::save(tracePath)) {
+        log.info("Game", "Trace written to " + tracePath);
+    } else {
+        log.error("Game", "Failed to write trace " + tracePath);
+    }
+}
+
 void RWGame::globalKeyEvent(const SDL_Event& event) {
     const auto toggle_debug = [&](DebugViewMode m) {
         debugview_ = debugview_ == m ? DebugViewMode::Disabled : m;
@@ -834,6 +882,9 @@ void RWGame::globalKeyEvent(const SDL_Event& event) {
         case SDLK_F4:
             toggle_debug(DebugViewMode::Objects);
             break;
+        case SDLK_F5:
+            toggleTrace();
+            break;
         default:
             break;
     }
@@ -50,8 +50,15 @@ private:
     bool inFocus = true;
     ViewCamera currentCam;
 
+    std::optional<std::string> bvhCachePath;
+    std::optional<std::string> dataSnapshotPath;
+    std::optional<std::string> sfxBankPath;
+    /// Where traces are written, F5 starts and writes them
+    std::string tracePath = "openrw_trace.json";
+
     DebugViewMode debugview_ = DebugViewMode::Disabled;
     int lastDraws{0};  /// Number of draws issued for the last frame.
+    float physicsStepTime{0.f};  /// Duration of the last physics step in ms.
 
     std::string cheatInputWindow = std::string(32, ' ');
 
@@ -98,6 +105,10 @@ public:
         return debugview_;
     }
 
+    float getPhysicsStepTime() const {
+        return physicsStepTime;
+    }
+
     bool hitWorldRay(glm::vec3& hit, glm::vec3& normal,
                      GameObject** object = nullptr);
 
@@ -124,13 +135,14 @@ private:
 
     void globalKeyEvent(const SDL_Event& event);
 
+    /// Start recording a trace, or write the one being recorded
+    void toggleTrace();
+
     bool updateInput();
 
     float tickWorld(const float deltaTime, float accumulatedTime);
 
     void renderDebugView();
-
-    void tickObjects(float dt) const;
 };
 
 #endif
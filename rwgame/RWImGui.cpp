@@ -1,6 +1,7 @@
 #include "RWImGui.hpp"
 
 #include <ai/CharacterController.hpp>
+#include <ai/TrafficDirector.hpp>
 #include <objects/CharacterObject.hpp>
 #include <objects/VehicleObject.hpp>
 
@@ -53,11 +54,38 @@ void WindowDebugStats(RWGame& game) {
                 time_max);
     ImGui::Text("Timescale %.2f",
                 static_cast<double>(world->state->basic.timeScale));
+    ImGui::Text("Physics %.3f ms (%s)",
+                static_cast<double>(game.getPhysicsStepTime()),
+                world->isPhysicsMultithreaded() ? "multithreaded"
+                                                : "sequential");
+    const auto& traffic = world->trafficDirector->getMetrics();
+    ImGui::Text("Traffic %.3f ms (peak %.3f ms) %lu spawned %lu removed",
+                static_cast<double>(traffic.updateTime + traffic.cleanupTime),
+                static_cast<double>(traffic.peakUpdateTime),
+                static_cast<unsigned long>(traffic.spawns),
+                static_cast<unsigned long>(traffic.despawns));
     ImGui::Text("%i Drawn %lu Culled", renderer.getRenderer().getDrawCount(),
                 renderer.getCulledCount());
     ImGui::Text("%i Textures %i Buffers",
                 renderer.getRenderer().getTextureCount(),
                 renderer.getRenderer().getBufferCount());
+    const auto textures = game.getGameData().getTextureMemoryReport();
+    constexpr double kMiB = 1024. * 1024.;
+    ImGui::Text("Texture memory %.1f MiB\n RGBA %lu %.1f MiB\n Paletted %lu "
+                "%.1f MiB\n Palettes %lu %.1f MiB",
+                textures.getTotalBytes() / kMiB,
+                static_cast<unsigned long>(textures.rgba.count),
+                textures.rgba.bytes / kMiB,
+                static_cast<unsigned long>(textures.paletted.count),
+                textures.paletted.bytes / kMiB,
+                static_cast<unsigned long>(textures.palettes.count),
+                textures.palettes.bytes / kMiB);
+    const auto& residency = game.getGameData().textureResidency;
+    ImGui::Text("Resident %.1f / %.1f MiB, %lu evicted (%.1f MiB)",
+                residency.getResidentBytes() / kMiB,
+                residency.getBudget() / kMiB,
+                static_cast<unsigned long>(residency.getEvictionCount()),
+                residency.getEvictedBytes() / kMiB);
     ImGui::End();
 }
 
@@ -1,17 +1,20 @@
 #define SDL_MAIN_HANDLED
 
 #include <iostream>
+#include <memory>
 
 #include "RWGame.hpp"
 #include <SDL.h>
 
 #include <core/Logger.hpp>
+#include <core/TraceRecorder.hpp>
 
 #include "RWConfig.hpp"
 
 int main(int argc, const char* argv[]) {
     // Initialise Logging before anything else happens
     StdOutReceiver logstdout;
+    std::unique_ptr<JsonFileReceiver> logfile;
     Logger logger({ &logstdout });
 
     RWArgumentParser argParser;
@@ -25,6 +28,21 @@ int main(int argc, const char* argv[]) {
         return 0;
     }
 
+    if (argLayerOpt->logFilePath.has_value()) {
+        logfile = std::make_unique<JsonFileReceiver>(*argLayerOpt->logFilePath);
+        if (logfile->isOpen()) {
+            logger.addReceiver(logfile.get());
+        } else {
+            logger.error("Logger",
+                         "Failed to open log file " + *argLayerOpt->logFilePath);
+        }
+    }
+    logger.start();
+
+    if (argLayerOpt->tracePath.has_value()) {
+        TraceRecorder::start();
+    }
+
     SDL_SetMainReady();
 
     try {
@@ -40,6 +58,7 @@ int main(int argc, const char* argv[]) {
         static constexpr char const* kErrorTitle = "Fatal Error";
 
         logger.error("exception", ex.what());
+        logger.flush();
 
         if (SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, kErrorTitle,
                                      ex.what(), nullptr) < 0) {
@@ -66,7 +66,9 @@ void BenchmarkState::exit() {
               << "Duration: " << duration << " seconds\n"
               << "Avg frametime: " << std::setprecision(3)
               << (duration / frameCounter) << " (" << (frameCounter / duration)
-              << " fps)" << '\n';
+              << " fps)" << '\n'
+              << "Avg texture binds: "
+              << (static_cast<double>(textureBinds) / frameCounter) << '\n';
 }
 
 void BenchmarkState::tick(float dt) {
@@ -94,6 +96,8 @@ void BenchmarkState::tick(float dt) {
 
 void BenchmarkState::draw(GameRenderer& r) {
     frameCounter++;
+    // The world is drawn before the states
+    textureBinds += r.getRenderer().getTextureCount();
     State::draw(r);
 }
 
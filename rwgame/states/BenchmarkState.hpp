@@ -26,6 +26,8 @@ class BenchmarkState final : public State {
     float benchmarkTime{0.f};
     float duration{0.f};
     uint32_t frameCounter{0};
+    /// Texture binds of all drawn frames
+    uint64_t textureBinds{0};
 
 public:
     BenchmarkState(RWGame* game, const std::string& benchfile);
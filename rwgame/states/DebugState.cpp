@@ -14,6 +14,7 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -188,6 +189,11 @@ void DebugState::drawVehicleMenu() {
             spawnVehicle(id);
         }
     }
+
+    ImGui::Separator();
+    if (ImGui::MenuItem("Pileup (60 vehicles)")) {
+        spawnPileup(60);
+    }
 }
 
 void DebugState::drawAIMenu() {
@@ -334,15 +340,14 @@ void DebugState::drawMissionsMenu() {
             ScriptMachine* vm = game->getScriptVM();
 
             if (vm) {
-                std::list<SCMThread>& threads = vm->getThreads();
+                auto& threads = vm->getThreads();
                 const auto& offsets = vm->getFile().getMissionOffsets();
 
                 RW_ASSERT(!offsets.empty());
 
                 for (auto& thread : threads) {
                     if (thread.baseAddress >= offsets[0]) {
-                        thread.wakeCounter = -1;
-                        thread.finished = true;
+                        vm->terminateThread(thread);
                     }
                 }
 
@@ -356,6 +361,99 @@ void DebugState::drawMissionsMenu() {
     }
 }
 
+#ifdef RW_SCRIPT_PROFILER
+void DebugState::drawScriptProfiler() {
+    static constexpr std::size_t kShownRows = 15;
+
+    ScriptMachine* vm = game->getScriptVM();
+    if (!vm) {
+        return;
+    }
+    auto& profiler = vm->getProfiler();
+
+    ImGui::Begin("Script Profiler");
+    ImGui::Text("%lu ticks, last %.3f ms, average %.3f ms",
+                static_cast<unsigned long>(profiler.getTickCount()),
+                profiler.getLastTickTime() / 1e6,
+                profiler.getTickCount() > 0
+                    ? profiler.getTotalTime() / 1e6 / profiler.getTickCount()
+                    : 0.0);
+    if (ImGui::Button("Reset")) {
+        profiler.reset(vm->getFile().getSize());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export")) {
+        profiler.save("script_profile");
+    }
+
+    if (ImGui::CollapsingHeader("Opcodes", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Columns(4, "opcodes");
+        ImGui::Text("Opcode");
+        ImGui::NextColumn();
+        ImGui::Text("Count");
+        ImGui::NextColumn();
+        ImGui::Text("Total ms");
+        ImGui::NextColumn();
+        ImGui::Text("Average us");
+        ImGui::NextColumn();
+        ImGui::Separator();
+        auto opcodes = profiler.getOpcodeStats();
+        for (std::size_t i = 0; i < std::min(opcodes.size(), kShownRows);
+             ++i) {
+            const auto& op = opcodes[i];
+            ImGui::Text("%04x %s", op.opcode,
+                        op.code ? op.code->signature.c_str() : "");
+            ImGui::NextColumn();
+            ImGui::Text("%lu", static_cast<unsigned long>(op.count));
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", op.time / 1e6);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", op.time / 1e3 / op.count);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+    }
+
+    if (ImGui::CollapsingHeader("Threads", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Columns(4, "threads");
+        ImGui::Text("Thread");
+        ImGui::NextColumn();
+        ImGui::Text("Instructions (tick)");
+        ImGui::NextColumn();
+        ImGui::Text("ms (tick)");
+        ImGui::NextColumn();
+        ImGui::Text("Peak ms");
+        ImGui::NextColumn();
+        ImGui::Separator();
+        auto threads = profiler.getThreadStats();
+        for (std::size_t i = 0; i < std::min(threads.size(), kShownRows);
+             ++i) {
+            const auto& thread = threads[i];
+            ImGui::Text("%s %06x", thread.name.c_str(), thread.baseAddress);
+            ImGui::NextColumn();
+            ImGui::Text("%lu (%lu)",
+                        static_cast<unsigned long>(thread.instructions),
+                        static_cast<unsigned long>(thread.tickInstructions));
+            ImGui::NextColumn();
+            ImGui::Text("%.3f (%.3f)", thread.time / 1e6,
+                        thread.tickTime / 1e6);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", thread.peakTickTime / 1e6);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+    }
+
+    if (ImGui::CollapsingHeader("Hot Addresses")) {
+        for (const auto& address : profiler.getHotAddresses(kShownRows)) {
+            ImGui::Text("%06x %lu", address.first,
+                        static_cast<unsigned long>(address.second));
+        }
+    }
+    ImGui::End();
+}
+#endif
+
 DebugState::DebugState(RWGame* game, const glm::vec3& vp, const glm::quat& vd)
     : State(game), _invertedY(game->getConfig().invertY()) {
     _debugCam.position = vp;
@@ -393,6 +491,9 @@ void DebugState::draw(GameRenderer& r) {
     ImGui::End();
 
     drawDebugMenu();
+#ifdef RW_SCRIPT_PROFILER
+    drawScriptProfiler();
+#endif
 
     State::draw(r);
 }
@@ -495,6 +596,25 @@ void DebugState::spawnVehicle(unsigned int id) {
     getWorld()->createVehicle(id, spawnPos, spawnRot);
 }
 
+void DebugState::spawnPileup(unsigned int count) {
+    static constexpr std::array<unsigned int, 6> kPileupVehicles{
+        {90, 110, 116, 112, 119, 105}};
+
+    auto ch = game->getWorld()->getPlayer()->getCharacter();
+    if (!ch) return;
+
+    // Drop the vehicles in a tight column so they all end up in contact
+    auto base =
+        ch->getPosition() + ch->getRotation() * glm::vec3(0.f, 10.f, 0.f);
+    for (auto i = 0u; i < count; ++i) {
+        glm::vec3 offset((i % 2) * 2.5f, ((i / 2) % 2) * 5.f,
+                         3.f + (i / 4) * 2.5f);
+        auto spawnRot = glm::quat(glm::vec3(0.f, 0.f, i * 0.4f));
+        getWorld()->createVehicle(kPileupVehicles[i % kPileupVehicles.size()],
+                                  base + offset, spawnRot);
+    }
+}
+
 void DebugState::spawnFollower(unsigned int id) {
     auto ch = game->getWorld()->getPlayer()->getCharacter();
     if (!ch) return;
@@ -25,6 +25,9 @@ class DebugState final : public State {
     void drawWeaponMenu();
     void drawWeatherMenu();
     void drawMissionsMenu();
+#ifdef RW_SCRIPT_PROFILER
+    void drawScriptProfiler();
+#endif
 
 public:
     DebugState(RWGame* game, const glm::vec3& vp = {},
@@ -43,6 +46,7 @@ public:
     void printCameraDetails();
 
     void spawnVehicle(unsigned int id);
+    void spawnPileup(unsigned int count);
     void spawnFollower(unsigned int id);
     void giveItem(int slot);
 
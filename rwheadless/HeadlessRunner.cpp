@@ -0,0 +1,312 @@
+#include "HeadlessRunner.hpp"
+
+#include <ai/PlayerController.hpp>
+#include <core/Logger.hpp>
+#include <core/Profiler.hpp>
+#include <dynamics/CollisionShape.hpp>
+#include <dynamics/PhysicsQueries.hpp>
+#include <objects/CharacterObject.hpp>
+#include <objects/GameObject.hpp>
+#include <objects/VehicleObject.hpp>
+
+#include <glm/gtc/quaternion.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <btBulletDynamicsCommon.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+constexpr float kTimestep = 1.f / 60.f;
+constexpr int kMaxPhysicsSubSteps = 2;
+
+/// Vehicles of the pileup, the same as the debug menu's
+constexpr std::array<std::uint16_t, 6> kPileupVehicles{
+    {90, 110, 116, 112, 119, 105}};
+/// On the road next to the player's start in Portland
+const glm::vec3 kPileupPosition{811.9f, -939.9f, 35.8f};
+
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+void measure(double& total, F&& work) {
+    auto start = Clock::now();
+    work();
+    total += std::chrono::duration<double, std::milli>(Clock::now() - start)
+                 .count();
+}
+
+/// FNV-1a
+class StateHash {
+public:
+    void add(const void* data, std::size_t size) {
+        auto bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    }
+
+    template <class T>
+    void add(const T& value) {
+        add(&value, sizeof(T));
+    }
+
+    /// Positions are hashed to the centimetre
+    void add(const glm::vec3& v) {
+        for (int i = 0; i < 3; ++i) {
+            add(static_cast<std::int64_t>(std::lround(v[i] * 100.f)));
+        }
+    }
+
+    std::uint64_t get() const {
+        return hash;
+    }
+
+private:
+    std::uint64_t hash = 14695981039346656037ull;
+};
+}  // namespace
+
+HeadlessRunner::HeadlessRunner(Logger& log, Options opts)
+    : log(log), options(std::move(opts)), data(&log, options.gamedataPath) {
+    log.info("Headless", "Game directory: " + options.gamedataPath);
+    if (options.dataSnapshotPath.has_value() &&
+        !data.snapshot.load(*options.dataSnapshotPath)) {
+        log.warning("Headless",
+                    "No usable data snapshot at " + *options.dataSnapshotPath);
+    }
+
+    auto loadStart = Clock::now();
+    if (!data.load()) {
+        throw std::runtime_error("Invalid game directory path: " +
+                                 options.gamedataPath);
+    }
+    data.loadDynamicObjects(
+        (std::filesystem::path{options.gamedataPath} / "data/object.dat")
+            .string());
+    data.loadGXT("text/" + options.language + ".gxt");
+
+    // No audio device, so it runs the same on machines without one
+    world = std::make_unique<GameWorld>(&log, &data,
+                                        options.multithreadedPhysics, true);
+    world->setRandomSeed(options.seed);
+    state.world = world.get();
+    world->state = &state;
+
+    for (auto ipl : world->data->iplLocations) {
+        world->data->loadZone(ipl.second);
+        world->placeItems(ipl.second);
+    }
+    loadTime = std::chrono::duration<double, std::milli>(Clock::now() -
+                                                         loadStart)
+                   .count();
+
+    if (options.dataSnapshotPath.has_value() && data.snapshot.isDirty() &&
+        !data.snapshot.save(*options.dataSnapshotPath)) {
+        log.error("Headless",
+                  "Failed to write data snapshot " + *options.dataSnapshotPath);
+    }
+
+    if (options.runScript) {
+        script = data.loadSCM(options.scriptPath);
+        if (!script) {
+            throw std::runtime_error("Failed to load SCM: " +
+                                     options.scriptPath);
+        }
+        vm = std::make_unique<ScriptMachine>(&state, script, &opcodes);
+        state.script = vm.get();
+        vm->setInstructionCacheEnabled(options.scriptInstructionCache);
+        vm->startThread(0);
+    }
+
+    if (options.inputPath.has_value()) {
+        loadInput(*options.inputPath);
+    }
+
+    spawnPileup(options.pileupVehicles);
+}
+
+void HeadlessRunner::spawnPileup(unsigned int count) {
+    if (count == 0) {
+        return;
+    }
+    // Drop the vehicles in a tight column so they all end up in contact
+    const auto base = world->getGroundAtPosition(kPileupPosition);
+    for (auto i = 0u; i < count; ++i) {
+        glm::vec3 offset((i % 2) * 2.5f, ((i / 2) % 2) * 5.f,
+                         3.f + (i / 4) * 2.5f);
+        auto rotation = glm::quat(glm::vec3(0.f, 0.f, i * 0.4f));
+        world->createVehicle(kPileupVehicles[i % kPileupVehicles.size()],
+                             base + offset, rotation);
+    }
+    log.info("Headless", "Spawned a pileup of " + std::to_string(count) +
+                             " vehicles, " +
+                             (world->isPhysicsMultithreaded()
+                                  ? "multithreaded"
+                                  : "sequential") +
+                             " physics");
+}
+
+HeadlessRunner::Report HeadlessRunner::run() {
+    Report report;
+    report.loadTime = loadTime;
+    times = {};
+
+    auto start = Clock::now();
+    for (unsigned int t = 0; t < options.ticks; ++t) {
+        RW_PROFILE_FRAME_BOUNDARY();
+        applyInput(t);
+        const auto dt = kTimestep * state.basic.timeScale;
+        tick(dt);
+        report.simulatedTime += dt;
+    }
+    report.wallTime =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+
+    report.ticks = options.ticks;
+    report.ticksPerSecond =
+        report.wallTime > 0. ? report.ticks / (report.wallTime / 1000.) : 0.;
+    report.subsystems = times;
+    report.objectCount = world->allObjects.size();
+    report.collisionShapes = CollisionShape::getShapeCount();
+    report.collisionShapeBytes = CollisionShape::getShapeBytes();
+    report.collisionBvhBytes = CollisionShape::getBvhBytes();
+    report.worldHash = hashWorldState();
+    return report;
+}
+
+void HeadlessRunner::tick(float dt) {
+    RW_PROFILE_SCOPE(__func__);
+    measure(times.physics, [&]() {
+        world->dynamicsWorld->stepSimulation(dt, kMaxPhysicsSubSteps,
+                                             kTimestep);
+    });
+    measure(times.queries, [&]() { world->queries->flush(); });
+
+    // The same world update as RWGame::tick for the ingame state
+    world->tickTime(dt);
+
+    measure(times.objects, [&]() { world->tickObjects(dt); });
+
+    if (vm) {
+        measure(times.script, [&]() { vm->execute(dt); });
+    }
+
+    // Finish the textures of models loaded by the script, as a frame would
+    world->data->textureUploader.process(TextureUploader::kDefaultFrameBudget);
+
+    // Traffic is spawned around the player, there is no camera to follow
+    auto player = world->getPlayer();
+    if (player && player->getCharacter()) {
+        measure(times.traffic, [&]() {
+            camera.position = player->getCharacter()->getPosition();
+            world->updateTraffic(camera);
+        });
+    }
+
+    state.swapInputState();
+}
+
+std::uint64_t HeadlessRunner::hashWorldState() const {
+    StateHash hash;
+    hash.add(state.basic.gameHour);
+    hash.add(state.basic.gameMinute);
+    hash.add(static_cast<std::uint64_t>(world->allObjects.size()));
+    for (const auto object : world->allObjects) {
+        hash.add(object->type());
+        hash.add(object->getGameObjectID());
+        hash.add(object->getPosition());
+    }
+    if (vm) {
+        const auto& globals = vm->getGlobalData();
+        hash.add(globals.data(), globals.size());
+    }
+    return hash.get();
+}
+
+void HeadlessRunner::printReport(std::ostream& out, const Report& report) {
+    auto perTick = [&](double total) {
+        return report.ticks > 0 ? total * 1000. / report.ticks : 0.;
+    };
+    auto line = [&](const char* name, double total) {
+        out << std::left << std::setw(14) << name << std::fixed
+            << std::setprecision(3) << total << " ms (" << perTick(total)
+            << " us/tick)\n";
+    };
+
+    out << "load time:    " << std::fixed << std::setprecision(3)
+        << report.loadTime << " ms\n";
+    out << "ticks:        " << report.ticks << " (" << std::fixed
+        << std::setprecision(1) << report.simulatedTime << " s simulated)\n";
+    out << "wall time:    " << std::setprecision(3) << report.wallTime
+        << " ms (" << std::setprecision(1) << report.ticksPerSecond
+        << " ticks/s)\n";
+    line("physics:", report.subsystems.physics);
+    line("queries:", report.subsystems.queries);
+    line("objects:", report.subsystems.objects);
+    line("script:", report.subsystems.script);
+    line("traffic:", report.subsystems.traffic);
+    out << "objects:      " << report.objectCount << "\n";
+    out << "collision:    " << report.collisionShapes << " shapes, "
+        << report.collisionShapeBytes / 1024 << " KB + "
+        << report.collisionBvhBytes / 1024 << " KB BVHs\n";
+    out << "world hash:   " << std::hex << std::setw(16) << std::setfill('0')
+        << std::right << report.worldHash << std::dec << std::setfill(' ')
+        << "\n";
+}
+
+void HeadlessRunner::loadInput(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to open input file: " + path);
+    }
+
+    // Each line sets a control to a level from a tick onwards:
+    // <tick> <control index> <level>
+    std::string text;
+    for (int lineNumber = 1; std::getline(file, text); ++lineNumber) {
+        if (text.empty() || text[0] == '#') {
+            continue;
+        }
+        std::istringstream line(text);
+        unsigned int tick;
+        int control;
+        float level;
+        if (!(line >> tick >> control >> level) || control < 0 ||
+            control >= GameInputState::_MaxControls) {
+            throw std::runtime_error("Invalid input at " + path + ":" +
+                                     std::to_string(lineNumber));
+        }
+        input.push_back(
+            {tick, static_cast<GameInputState::Control>(control), level});
+    }
+
+    std::stable_sort(input.begin(), input.end(),
+                     [](const InputEvent& a, const InputEvent& b) {
+                         return a.tick < b.tick;
+                     });
+    log.info("Headless", "Loaded " + std::to_string(input.size()) +
+                             " input events from " + path);
+}
+
+void HeadlessRunner::applyInput(unsigned int tick) {
+    while (nextInput < input.size() && input[nextInput].tick <= tick) {
+        const auto& event = input[nextInput++];
+        state.input[0].levels[event.control] = event.level;
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef RWHEADLESS_HEADLESSRUNNER_HPP
+#define RWHEADLESS_HEADLESSRUNNER_HPP
+
+#include <engine/GameData.hpp>
+#include <engine/GameInputState.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
+#include <render/ViewCamera.hpp>
+#include <script/SCMFile.hpp>
+#include <script/ScriptMachine.hpp>
+#include <script/modules/GTA3Module.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class Logger;
+
+/**
+ * @brief Steps the game simulation without a window, renderer or audio
+ *
+ * Loads the game data and the world like RWGame, then runs the fixed
+ * timestep loop for a number of ticks, feeding recorded input to the
+ * scripts. Used to measure the CPU side of the game and to check that
+ * changes don't alter the simulation.
+ */
+class HeadlessRunner {
+public:
+    struct Options {
+        std::string gamedataPath;
+        std::string language = "american";
+        std::string scriptPath = "data/main.scm";
+        bool runScript = true;
+        /// Decode script instructions once, see ScriptMachine
+        bool scriptInstructionCache = true;
+        unsigned int ticks = 3600;
+        unsigned int seed = 0;
+        bool multithreadedPhysics = false;
+        /// Vehicles dropped onto each other at the start
+        unsigned int pileupVehicles = 0;
+        std::optional<std::string> inputPath;
+        std::optional<std::string> dataSnapshotPath;
+    };
+
+    /**
+     * Total time spent in each part of the tick, in ms
+     */
+    struct SubsystemTimes {
+        double physics = 0.;
+        double queries = 0.;
+        double objects = 0.;
+        double script = 0.;
+        double traffic = 0.;
+    };
+
+    struct Report {
+        /// Time taken to load the data and the world in ms
+        double loadTime = 0.;
+        unsigned int ticks = 0;
+        double simulatedTime = 0.;
+        /// Wall clock time of the run in ms
+        double wallTime = 0.;
+        double ticksPerSecond = 0.;
+        SubsystemTimes subsystems;
+        std::size_t objectCount = 0;
+        /// Collision shapes built at the end of the run, and their memory
+        std::size_t collisionShapes = 0;
+        std::size_t collisionShapeBytes = 0;
+        std::size_t collisionBvhBytes = 0;
+        std::uint64_t worldHash = 0;
+    };
+
+    HeadlessRunner(Logger& log, Options options);
+
+    Report run();
+
+    /**
+     * @brief Hashes the objects in the world, the clock and the script
+     * globals; identical runs produce identical hashes.
+     */
+    std::uint64_t hashWorldState() const;
+
+    static void printReport(std::ostream& out, const Report& report);
+
+private:
+    struct InputEvent {
+        unsigned int tick;
+        GameInputState::Control control;
+        float level;
+    };
+
+    void spawnPileup(unsigned int count);
+    void loadInput(const std::string& path);
+    void applyInput(unsigned int tick);
+    void tick(float dt);
+
+    Logger& log;
+    Options options;
+
+    GameData data;
+    GameState state;
+    std::unique_ptr<GameWorld> world;
+
+    GTA3Module opcodes;
+    SCMFile script;
+    std::unique_ptr<ScriptMachine> vm;
+
+    std::vector<InputEvent> input;
+    std::size_t nextInput = 0;
+
+    ViewCamera camera;
+    SubsystemTimes times;
+    double loadTime = 0.;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "HeadlessRunner.hpp"
+
+#include <core/Logger.hpp>
+#include <core/TraceRecorder.hpp>
+#include <gl/NullGL.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace po = boost::program_options;
+
+int main(int argc, const char* argv[]) {
+    HeadlessRunner::Options options;
+
+    po::options_description description("Headless simulation runner");
+    // clang-format off
+    description.add_options()
+        ("help,h", "Show this help message")
+        ("gamedata,g", po::value<std::string>(&options.gamedataPath)->required(),
+            "Path to the game data")
+        ("ticks,n", po::value<unsigned int>(&options.ticks)->default_value(options.ticks),
+            "Number of ticks to simulate, at 60 ticks per second")
+        ("script", po::value<std::string>(&options.scriptPath)->default_value(options.scriptPath),
+            "Script to run")
+        ("no_script", "Don't run a script, only the world")
+        ("no_script_cache", "Decode script instructions every time they run")
+        ("input", po::value<std::string>(),
+            "Input to replay, lines of <tick> <control> <level>")
+        ("seed", po::value<unsigned int>(&options.seed)->default_value(options.seed),
+            "Seed for the world's random numbers")
+        ("physics_mt", "Use the multithreaded physics world")
+        ("pileup", po::value<unsigned int>(&options.pileupVehicles)->default_value(options.pileupVehicles),
+            "Number of vehicles to drop onto each other at the start")
+        ("data_snapshot", po::value<std::string>(),
+            "Load and store parsed data files in a snapshot file")
+        ("language", po::value<std::string>(&options.language)->default_value(options.language),
+            "Language of the game texts")
+        ("trace", po::value<std::string>(),
+            "Write a trace of the run to file, as Chrome trace events")
+        ("quiet,q", "Only print the report");
+    // clang-format on
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, description), vm);
+        if (vm.count("help")) {
+            std::cout << description << '\n';
+            return 0;
+        }
+        po::notify(vm);
+    } catch (po::error& ex) {
+        std::cerr << ex.what() << "\n" << description << '\n';
+        return 1;
+    }
+    options.runScript = vm.count("no_script") == 0;
+    options.scriptInstructionCache = vm.count("no_script_cache") == 0;
+    options.multithreadedPhysics = vm.count("physics_mt") != 0;
+    if (vm.count("input")) {
+        options.inputPath = vm["input"].as<std::string>();
+    }
+    if (vm.count("data_snapshot")) {
+        options.dataSnapshotPath = vm["data_snapshot"].as<std::string>();
+    }
+
+    StdOutReceiver logstdout;
+    Logger logger;
+    if (!vm.count("quiet")) {
+        logger.addReceiver(&logstdout);
+    }
+    logger.start();
+
+    // Models and textures are loaded without a GL context
+    installNullGL();
+
+    if (vm.count("trace")) {
+        TraceRecorder::start();
+    }
+
+    try {
+        HeadlessRunner runner(logger, options);
+        auto report = runner.run();
+        if (vm.count("trace")) {
+            const auto tracePath = vm["trace"].as<std::string>();
+            if (!TraceRecorder::save(tracePath)) {
+                logger.error("Headless", "Failed to write trace " + tracePath);
+            }
+        }
+        // Keep the log out of the report
+        logger.flush();
+        HeadlessRunner::printReport(std::cout, report);
+    } catch (std::runtime_error& ex) {
+        logger.error("exception", ex.what());
+        logger.flush();
+        std::cerr << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -5,6 +5,10 @@
 #include <glm/gtx/string_cast.hpp>
 #include "test_Globals.hpp"
 
+#include <platform/FileHandle.hpp>
+
+#include <random>
+
 BOOST_AUTO_TEST_SUITE(AnimationTests, DATA_TEST_PREDICATE)
 
 BOOST_AUTO_TEST_CASE(test_matrix) {
@@ -18,15 +22,14 @@ BOOST_AUTO_TEST_CASE(test_matrix) {
         Animator animator(test_model);
 
         animation->duration = 1.f;
-        animation->bones.emplace(
-            "player", AnimationBone(
-                          "player", 0, 0, 1.0f, AnimationBone::RT0,
-                          std::vector<AnimationKeyframe>{
-                              {glm::quat{1.0f, 0.0f, 0.0f, 0.0f},
-                               glm::vec3(0.f, 0.f, 0.f), glm::vec3(), 0.f, 0},
-                              {glm::quat{1.0f, 0.0f, 0.0f, 0.0f},
-                               glm::vec3(0.f, 1.f, 0.f), glm::vec3(), 1.0f, 1},
-                          }));
+        animation->addBone(
+            "player", AnimationBone::RT0,
+            std::vector<AnimationKeyframe>{
+                {glm::quat{1.0f, 0.0f, 0.0f, 0.0f}, glm::vec3(0.f, 0.f, 0.f),
+                 glm::vec3(), 0.f, 0},
+                {glm::quat{1.0f, 0.0f, 0.0f, 0.0f}, glm::vec3(0.f, 1.f, 0.f),
+                 glm::vec3(), 1.0f, 1},
+            });
 
         animator.playAnimation(0, animation, 1.f, false);
 
@@ -44,4 +47,112 @@ BOOST_AUTO_TEST_CASE(test_matrix) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_compressed_size) {
+    // ped.ifp and a cutscene, against a full keyframe per frame
+    for (const auto name : {"ped.ifp", "intro.ifp"}) {
+        auto file = Global::get().e->data->index.openFile(name);
+        BOOST_REQUIRE(file.data);
+        LoaderIFP loader;
+        BOOST_REQUIRE(loader.loadFromMemory(file.data.get()));
+        BOOST_REQUIRE(!loader.animations.empty());
+
+        const auto& blob = loader.animations.begin()->second->blob;
+        std::size_t frames = 0;
+        for (const auto& [animName, animation] : loader.animations) {
+            BOOST_CHECK_EQUAL(animation->blob, blob);
+            for (const auto& bone : animation->bones) {
+                frames += bone.frameCount;
+            }
+        }
+        const auto uncompressed = frames * sizeof(AnimationKeyframe);
+        const auto compressed = blob->getMemoryUsage();
+        BOOST_TEST_MESSAGE(name << ": " << frames << " frames, "
+                                << uncompressed << " bytes as keyframes, "
+                                << compressed << " bytes compressed");
+        BOOST_CHECK_LT(compressed * 3, uncompressed);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(AnimationCompressionTests)
+
+BOOST_AUTO_TEST_CASE(test_rotation_error) {
+    std::mt19937 random(1);
+    std::normal_distribution<float> dist;
+    for (int i = 0; i < 10000; ++i) {
+        auto q = glm::normalize(
+            glm::quat{dist(random), dist(random), dist(random), dist(random)});
+        auto unpacked =
+            AnimationBlob::unpackRotation(AnimationBlob::packRotation(q));
+        // q and -q are the same rotation
+        auto error = std::min(glm::length(glm::vec4(q.x, q.y, q.z, q.w) -
+                                          glm::vec4(unpacked.x, unpacked.y,
+                                                    unpacked.z, unpacked.w)),
+                              glm::length(glm::vec4(q.x, q.y, q.z, q.w) +
+                                          glm::vec4(unpacked.x, unpacked.y,
+                                                    unpacked.z, unpacked.w)));
+        BOOST_CHECK_LT(error, 1e-4f);
+    }
+
+    const glm::quat identity{1.f, 0.f, 0.f, 0.f};
+    auto unpacked =
+        AnimationBlob::unpackRotation(AnimationBlob::packRotation(identity));
+    BOOST_CHECK(unpacked == identity);
+}
+
+BOOST_AUTO_TEST_CASE(test_position_error) {
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> dist(-3.f, 3.f);
+    std::vector<AnimationKeyframe> frames;
+    for (int i = 0; i < 100; ++i) {
+        frames.emplace_back(glm::quat{1.f, 0.f, 0.f, 0.f},
+                            glm::vec3(dist(random), dist(random), 0.5f),
+                            glm::vec3(1.f), i * 0.1f, i);
+    }
+
+    Animation animation;
+    const auto& bone = animation.addBone("bone", AnimationBone::RT0, frames);
+    BOOST_REQUIRE_EQUAL(bone.frameCount, frames.size());
+    BOOST_CHECK_CLOSE(animation.duration, 9.9f, 1e-4f);
+
+    // Within a step of the bone's bounds, flat axes are exact
+    const auto bound = bone.positionExtent / 65535.f;
+    for (auto i = 0u; i < frames.size(); ++i) {
+        auto frame = bone.getFrame(i);
+        BOOST_CHECK_EQUAL(frame.starttime, frames[i].starttime);
+        for (int a = 0; a < 3; ++a) {
+            BOOST_CHECK_LE(std::abs(frame.position[a] - frames[i].position[a]),
+                           bound[a]);
+        }
+        BOOST_CHECK_EQUAL(frame.position.z, 0.5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_interpolation) {
+    Animation animation;
+    animation.addBone(
+        "b", AnimationBone::R00,
+        {{glm::quat{1.f, 0.f, 0.f, 0.f}, glm::vec3(), glm::vec3(1.f), 0.f, 0}});
+    animation.addBone(
+        "a", AnimationBone::RT0,
+        {{glm::quat{1.f, 0.f, 0.f, 0.f}, glm::vec3(0.f), glm::vec3(1.f), 0.f, 0},
+         {glm::quat{1.f, 0.f, 0.f, 0.f}, glm::vec3(2.f), glm::vec3(1.f), 1.f, 1},
+         {glm::quat{1.f, 0.f, 0.f, 0.f}, glm::vec3(0.f), glm::vec3(1.f), 2.f,
+          2}});
+
+    // Bones are sorted by name and share the blob
+    BOOST_CHECK_EQUAL(animation.findBone("a"), 0);
+    BOOST_CHECK_EQUAL(animation.findBone("b"), 1);
+    BOOST_CHECK_EQUAL(animation.findBone("c"), -1);
+    BOOST_CHECK_EQUAL(animation.blob->times.size(), 4);
+    BOOST_CHECK_EQUAL(animation.duration, 2.f);
+
+    const auto& bone = animation.bones[0];
+    BOOST_CHECK_EQUAL(bone.getInterpolatedKeyframe(0.5f).position.x, 1.f);
+    BOOST_CHECK_EQUAL(bone.getInterpolatedKeyframe(1.5f).position.x, 1.f);
+    BOOST_CHECK_EQUAL(bone.getInterpolatedKeyframe(3.f).position.x, 0.f);
+    BOOST_CHECK_EQUAL(bone.getKeyframe(1.5f).id, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,8 +1,12 @@
 #include "test_Globals.hpp"
 
 #include <engine/GameWorld.hpp>
+#include <audio/SoundBuffer.hpp>
 #include <audio/SoundSource.hpp>
 
+#include <chrono>
+#include <thread>
+
 BOOST_AUTO_TEST_SUITE(AudioLoadingTests, DATA_TEST_PREDICATE)
 
 // @todo Shfil119 implement
@@ -45,6 +49,39 @@ BOOST_FIXTURE_TEST_CASE(testDecodingFramesOfMusic, F) {
     BOOST_REQUIRE(sound.source->decodedFrames > 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(testStreamPlayLatency, F) {
+    using Clock = std::chrono::steady_clock;
+    auto audioPath =
+        Global::get().e->data->index.findFilePath("audio/A1_a.wav");
+
+    manager.loadSound("A1_a", audioPath.string());
+    auto& sound = manager.getSoundRef("A1_a");
+
+    // Playing only sends a command, it doesn't wait for the audio thread
+    auto start = Clock::now();
+    sound.play();
+    auto call = Clock::now() - start;
+    BOOST_CHECK(sound.isPlaying());
+
+    ALint state = AL_INITIAL;
+    while (state != AL_PLAYING && Clock::now() - start < std::chrono::seconds(1)) {
+        alGetSourcei(sound.buffer->source, AL_SOURCE_STATE, &state);
+        std::this_thread::yield();
+    }
+    auto audible = Clock::now() - start;
+    BOOST_REQUIRE(state == AL_PLAYING);
+    BOOST_CHECK(audible < 10 * AudioStreamer::kServiceInterval);
+    BOOST_CHECK_EQUAL(manager.getAudioStreamer().getStallCount(), 0);
+
+    BOOST_TEST_MESSAGE(
+        "stream play call "
+        << std::chrono::duration<double, std::micro>(call).count()
+        << " us, audible after "
+        << std::chrono::duration<double, std::milli>(audible).count()
+        << " ms");
+    sound.stop();
+}
+
 BOOST_FIXTURE_TEST_CASE(testDecodingFramesOfSfx, F) {
     manager.createSfxInstance(157);  // Callahan Bridge fire
 
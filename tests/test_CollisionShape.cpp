@@ -0,0 +1,115 @@
+#include <boost/test/unit_test.hpp>
+#include <data/CollisionModel.hpp>
+#include <dynamics/CollisionBvhCache.hpp>
+#include <dynamics/CollisionShape.hpp>
+#include "test_Globals.hpp"
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305 5033)
+#endif
+#include <btBulletDynamicsCommon.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305 5033)
+#endif
+
+#include <filesystem>
+#include <utility>
+
+namespace {
+
+struct CollisionModelFixture {
+    CollisionModel model;
+
+    CollisionModelFixture() {
+        model.name = "testcol";
+        model.boxes.push_back({{-1.f, -1.f, 0.f}, {1.f, 1.f, 2.f}, {}});
+        model.spheres.push_back({{0.f, 0.f, 3.f}, 1.f, {}});
+        model.vertices = {{0.f, 0.f, 0.f},
+                          {10.f, 0.f, 0.f},
+                          {0.f, 10.f, 0.f},
+                          {10.f, 10.f, 0.f}};
+        model.faces.push_back({{0, 1, 2}, {}});
+        model.faces.push_back({{1, 3, 2}, {}});
+    }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(CollisionShapeTests)
+
+BOOST_FIXTURE_TEST_CASE(test_shape_is_shared, CollisionModelFixture) {
+    auto a = CollisionShape::get(model);
+    auto b = CollisionShape::get(model);
+
+    BOOST_CHECK_EQUAL(a.get(), b.get());
+    BOOST_CHECK_EQUAL(a->getShape()->getNumChildShapes(), 3);
+    BOOST_CHECK_CLOSE(a->getBoundingHeight(), 4.f, 0.01f);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_scaled_shape, CollisionModelFixture) {
+    auto shape = CollisionShape::get(model);
+    std::vector<std::unique_ptr<btCollisionShape>> children;
+    auto scaled = shape->createScaled({2.f, 2.f, 2.f}, children);
+
+    BOOST_REQUIRE_EQUAL(scaled->getNumChildShapes(), 3);
+    BOOST_CHECK_EQUAL(children.size(), 3);
+
+    btVector3 min, max;
+    scaled->getAabb(btTransform::getIdentity(), min, max);
+    BOOST_CHECK_GE(max.x(), 20.f);
+    BOOST_CHECK_GE(max.z(), 8.f);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_shape_memory, CollisionModelFixture) {
+    const auto shapeBytes = CollisionShape::getShapeBytes();
+    const auto bvhBytes = CollisionShape::getBvhBytes();
+    {
+        CollisionShape shape(model);
+        BOOST_CHECK_GT(CollisionShape::getShapeBytes(), shapeBytes);
+        BOOST_CHECK_GT(CollisionShape::getBvhBytes(), bvhBytes);
+    }
+    BOOST_CHECK_EQUAL(CollisionShape::getShapeBytes(), shapeBytes);
+    BOOST_CHECK_EQUAL(CollisionShape::getBvhBytes(), bvhBytes);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_bvh_cache_roundtrip, CollisionModelFixture) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "openrw_test_bvh.cache";
+
+    {
+        CollisionBvhCache cache;
+        CollisionShape shape(model, &cache);
+        BOOST_CHECK(cache.isDirty());
+        BOOST_CHECK_EQUAL(cache.size(), 1);
+        BOOST_REQUIRE(cache.save(path));
+        BOOST_CHECK(!cache.isDirty());
+    }
+
+    CollisionBvhCache cache;
+    BOOST_REQUIRE(cache.load(path));
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK(cache.find(model) != nullptr);
+
+    CollisionShape shape(model, &cache);
+    BOOST_CHECK(!cache.isDirty());
+
+    btVector3 min, max;
+    shape.getShape()->getAabb(btTransform::getIdentity(), min, max);
+    BOOST_CHECK_GE(max.x(), 10.f);
+
+    // Models that changed are not served from the cache, even when they
+    // keep their vertex and face counts
+    model.vertices[3].z = 1.f;
+    BOOST_CHECK(cache.find(model) == nullptr);
+    model.vertices[3].z = 0.f;
+    std::swap(model.faces[0].tri[0], model.faces[0].tri[1]);
+    BOOST_CHECK(cache.find(model) == nullptr);
+    std::swap(model.faces[0].tri[0], model.faces[0].tri[1]);
+    BOOST_CHECK(cache.find(model) != nullptr);
+    model.faces.pop_back();
+    BOOST_CHECK(cache.find(model) == nullptr);
+
+    std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
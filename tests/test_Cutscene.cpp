@@ -1,5 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include <data/CutsceneData.hpp>
+#include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <loaders/LoaderCutsceneDAT.hpp>
 #include <platform/FileHandle.hpp>
 #include "test_Globals.hpp"
@@ -29,4 +32,26 @@ BOOST_AUTO_TEST_CASE(test_load) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_async_load) {
+    auto world = Global::get().e;
+    auto& state = *world->state;
+
+    world->loadCutscene("intro");
+    BOOST_REQUIRE(state.currentCutscene);
+    BOOST_CHECK_EQUAL(state.currentCutscene->meta.name, "intro");
+
+    // Starting waits for the data instead of blocking
+    world->startCutscene();
+    world->waitForCutscene();
+    BOOST_CHECK(world->updateCutsceneLoading());
+    BOOST_CHECK_EQUAL(state.currentCutscene->tracks.duration, 64.8f);
+    BOOST_CHECK(!world->data->animationsCutscene.empty());
+    BOOST_CHECK_GE(state.cutsceneStartTime, 0.f);
+    BOOST_CHECK(!world->isCutsceneDone());
+
+    world->clearCutscene();
+    BOOST_CHECK(!state.currentCutscene);
+    BOOST_CHECK(world->data->animationsCutscene.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+#include <boost/test/unit_test.hpp>
+#include <data/PathData.hpp>
+#include <engine/DataSnapshot.hpp>
+#include <loaders/LoaderIPL.hpp>
+#include "test_Globals.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+constexpr auto kIPLTestData = R"(
+zone
+ZONE_A, 1, -100.0, -200.00, -100.0, 100.0, 1000.0, 100.0, 1
+end
+
+inst
+101, ModelA, 10.0, 12.0, 5.0, 1, 1, 1, 0, 0, 1, 0
+112, ModelB, 11.0, 12.0, 5.0, 1, 1, 1, 0, 0, 0, 1
+end
+)";
+
+struct SnapshotFixture {
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::filesystem::path snapshotPath = dir / "openrw_test_snapshot.bin";
+    std::filesystem::path iplPath = dir / "openrw_test_snapshot.ipl";
+
+    SnapshotFixture() {
+        std::filesystem::remove(snapshotPath);
+        std::ofstream(iplPath) << kIPLTestData;
+    }
+
+    ~SnapshotFixture() {
+        std::filesystem::remove(snapshotPath);
+        std::filesystem::remove(iplPath);
+    }
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(DataSnapshotTests, SnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(test_disabled) {
+    DataSnapshot snapshot;
+    BOOST_CHECK(!snapshot.isEnabled());
+    BOOST_CHECK_EQUAL(snapshot.hashFile(iplPath), 0);
+
+    LoaderIPL ipl;
+    BOOST_REQUIRE(ipl.load(iplPath.string()));
+    snapshot.storeIPL(iplPath.string(), 0, ipl);
+    BOOST_CHECK(!snapshot.isDirty());
+    BOOST_CHECK_EQUAL(snapshot.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_ipl_roundtrip) {
+    const auto key = iplPath.string();
+    {
+        DataSnapshot snapshot;
+        BOOST_CHECK(!snapshot.load(snapshotPath));
+        BOOST_REQUIRE(snapshot.isEnabled());
+
+        LoaderIPL ipl;
+        BOOST_REQUIRE(ipl.load(key));
+        snapshot.storeIPL(key, snapshot.hashFile(iplPath), ipl);
+        BOOST_CHECK(snapshot.isDirty());
+        BOOST_REQUIRE(snapshot.save(snapshotPath));
+        BOOST_CHECK(!snapshot.isDirty());
+    }
+
+    DataSnapshot snapshot;
+    BOOST_REQUIRE(snapshot.load(snapshotPath));
+    BOOST_CHECK_EQUAL(snapshot.size(), 1);
+
+    LoaderIPL ipl;
+    BOOST_REQUIRE(snapshot.readIPL(key, snapshot.hashFile(iplPath), ipl));
+    BOOST_REQUIRE_EQUAL(ipl.m_instances.size(), 2);
+    BOOST_CHECK_EQUAL(ipl.m_instances[1].id, 112);
+    BOOST_CHECK_EQUAL(ipl.m_instances[1].model, "ModelB");
+    BOOST_CHECK_EQUAL(ipl.m_instances[1].pos.x, 11.f);
+    BOOST_CHECK_EQUAL(ipl.m_instances[1].rot.w, -1.f);
+    BOOST_REQUIRE_EQUAL(ipl.zones.size(), 1);
+    BOOST_CHECK_EQUAL(ipl.zones[0].name, "ZONE_A");
+    BOOST_CHECK_EQUAL(ipl.zones[0].min.y, -200.f);
+    BOOST_CHECK_EQUAL(ipl.zones[0].island, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_stale_entry) {
+    const auto key = iplPath.string();
+    DataSnapshot snapshot;
+    snapshot.load(snapshotPath);
+
+    LoaderIPL ipl;
+    BOOST_REQUIRE(ipl.load(key));
+    snapshot.storeIPL(key, snapshot.hashFile(iplPath), ipl);
+
+    // Editing the file invalidates its entry
+    std::ofstream(iplPath, std::ios_base::app) << "# edited\n";
+    LoaderIPL cached;
+    BOOST_CHECK(!snapshot.readIPL(key, snapshot.hashFile(iplPath), cached));
+    BOOST_CHECK(cached.m_instances.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_models_roundtrip) {
+    DataSnapshot snapshot;
+    snapshot.load(snapshotPath);
+
+    ModelInfoTable models;
+    {
+        auto simple = std::make_unique<SimpleModelInfo>();
+        simple->setModelID(100);
+        simple->name = "building";
+        simple->textureslot = "buildings";
+        simple->flags = SimpleModelInfo::DRAW_LAST;
+        simple->setNumAtomics(2);
+        simple->setLodDistance(0, 100.f);
+        simple->setLodDistance(1, 30.f);
+        simple->determineFurthest();
+        PathData path{PathData::PATH_PED, 100, "building", {}};
+        path.nodes.push_back({PathNode::EXTERNAL, -1, {1.f, 2.f, 3.f}, 1.f,
+                              1, 1});
+        simple->paths.push_back(path);
+        models.emplace(simple->id(), std::move(simple));
+
+        auto ped = std::make_unique<PedModelInfo>();
+        ped->setModelID(7);
+        ped->name = "cop";
+        ped->pedtype_ = PedModelInfo::COP;
+        ped->animgroup_ = "man";
+        ped->carsmask_ = 0x3F;
+        models.emplace(ped->id(), std::move(ped));
+    }
+    snapshot.storeModels("test.ide", 42, models);
+
+    ModelInfoTable read;
+    BOOST_CHECK(!snapshot.readModels("test.ide", 43, read));
+    BOOST_REQUIRE(snapshot.readModels("test.ide", 42, read));
+    BOOST_REQUIRE_EQUAL(read.size(), 2);
+
+    auto simple = dynamic_cast<SimpleModelInfo*>(read[100].get());
+    BOOST_REQUIRE(simple != nullptr);
+    BOOST_CHECK_EQUAL(simple->name, "building");
+    BOOST_CHECK_EQUAL(simple->flags, SimpleModelInfo::DRAW_LAST);
+    BOOST_CHECK_EQUAL(simple->getNumAtomics(), 2);
+    BOOST_CHECK_EQUAL(simple->getLargestLodDistance(), 30.f);
+    BOOST_REQUIRE_EQUAL(simple->paths.size(), 1);
+    BOOST_REQUIRE_EQUAL(simple->paths[0].nodes.size(), 1);
+    BOOST_CHECK_EQUAL(simple->paths[0].nodes[0].position.z, 3.f);
+
+    auto ped = dynamic_cast<PedModelInfo*>(read[7].get());
+    BOOST_REQUIRE(ped != nullptr);
+    BOOST_CHECK_EQUAL(ped->pedtype_, PedModelInfo::COP);
+    BOOST_CHECK_EQUAL(ped->animgroup_, "man");
+    BOOST_CHECK_EQUAL(ped->carsmask_, 0x3F);
+}
+
+BOOST_AUTO_TEST_CASE(test_load_benchmark, DATA_TEST_PREDICATE) {
+    const auto& ipls = Global::get().d->iplLocations;
+
+    DataSnapshot snapshot;
+    snapshot.load(snapshotPath);
+
+    size_t textInstances = 0;
+    std::vector<LoaderIPL> parsed(ipls.size());
+    BenchmarkTimer timer;
+    auto it = parsed.begin();
+    for (const auto& ipl : ipls) {
+        BOOST_REQUIRE(it->load(ipl.second));
+        textInstances += (it++)->m_instances.size();
+    }
+    auto text = timer.elapsed();
+
+    it = parsed.begin();
+    for (const auto& ipl : ipls) {
+        snapshot.storeIPL(ipl.second, snapshot.hashFile(ipl.second), *it++);
+    }
+    BOOST_REQUIRE(snapshot.save(snapshotPath));
+
+    timer.restart();
+    DataSnapshot loaded;
+    BOOST_REQUIRE(loaded.load(snapshotPath));
+    size_t snapshotInstances = 0;
+    for (const auto& ipl : ipls) {
+        LoaderIPL loader;
+        BOOST_REQUIRE(
+            loaded.readIPL(ipl.second, loaded.hashFile(ipl.second), loader));
+        snapshotInstances += loader.m_instances.size();
+    }
+    auto cached = timer.elapsed();
+
+    BOOST_CHECK_EQUAL(textInstances, snapshotInstances);
+    BOOST_TEST_MESSAGE(ipls.size() << " IPLs, " << textInstances
+                                   << " instances: text " << text
+                                   << " ms, snapshot " << cached << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
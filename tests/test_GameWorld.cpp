@@ -4,6 +4,8 @@
 #include <objects/InstanceObject.hpp>
 #include "test_Globals.hpp"
 
+#include <memory>
+
 BOOST_AUTO_TEST_SUITE(GameWorldTests, DATA_TEST_PREDICATE)
 
 BOOST_AUTO_TEST_CASE(test_gameobject_id) {
@@ -15,6 +17,99 @@ BOOST_AUTO_TEST_CASE(test_gameobject_id) {
     BOOST_CHECK_NE(object1->getGameObjectID(), object2->getGameObjectID());
 }
 
+BOOST_AUTO_TEST_CASE(test_gameobject_handles) {
+    auto& gw = *Global::get().e;
+
+    auto object1 = gw.createInstance(1337, glm::vec3(100.f, 0.f, 0.f));
+    auto object2 = gw.createInstance(1337, glm::vec3(100.f, 0.f, 100.f));
+    const auto id1 = object1->getGameObjectID();
+    const auto id2 = object2->getGameObjectID();
+    BOOST_CHECK_EQUAL(gw.instancePool.find(id1), object1);
+    BOOST_CHECK_EQUAL(gw.instancePool.find(id2), object2);
+
+    // The lowest free ID is handed out again
+    gw.destroyObject(object1);
+    BOOST_CHECK(gw.instancePool.find(id1) == nullptr);
+    auto object3 = gw.createInstance(1337, glm::vec3(100.f, 0.f, 0.f));
+    BOOST_CHECK_EQUAL(object3->getGameObjectID(), id1);
+    BOOST_CHECK_EQUAL(gw.instancePool.find(id1), object3);
+
+    gw.destroyObject(object2);
+    gw.destroyObject(object3);
+}
+
+BOOST_AUTO_TEST_CASE(test_object_grid) {
+    auto& gw = *Global::get().e;
+
+    auto near = gw.createInstance(1337, glm::vec3(1000.f, 1000.f, 0.f));
+    auto far = gw.createInstance(1337, glm::vec3(1030.f, 1000.f, 0.f));
+    // Outside of the world grid, stored in the edge cell
+    auto outside = gw.createInstance(1337, glm::vec3(5000.f, 1000.f, 0.f));
+
+    const auto& grid = gw.instancePool.getGrid();
+    BOOST_CHECK_EQUAL(grid.findNearest(glm::vec3(1010.f, 1000.f, 0.f), 50.f),
+                      near);
+    BOOST_CHECK_EQUAL(
+        grid.findNearest(glm::vec3(1010.f, 1000.f, 0.f), 50.f,
+                         [&](GameObject* object) { return object != near; }),
+        far);
+    BOOST_CHECK(grid.findNearest(glm::vec3(1200.f, 1000.f, 0.f), 50.f) ==
+                nullptr);
+    BOOST_CHECK_EQUAL(grid.findNearest(glm::vec3(4990.f, 1000.f, 0.f), 20.f),
+                      outside);
+
+    std::vector<GameObject*> within;
+    grid.findWithin(glm::vec3(1015.f, 1000.f, 0.f), 20.f, within);
+    BOOST_REQUIRE_EQUAL(within.size(), 2);
+    BOOST_CHECK_EQUAL(within[0], near);
+    BOOST_CHECK_EQUAL(within[1], far);
+
+    // Moved objects are moved to their new cell
+    near->setPosition(glm::vec3(1500.f, 1000.f, 0.f));
+    BOOST_CHECK_EQUAL(grid.findNearest(glm::vec3(1500.f, 1000.f, 0.f), 10.f),
+                      near);
+    BOOST_CHECK(grid.findNearest(glm::vec3(1000.f, 1000.f, 0.f), 10.f) ==
+                nullptr);
+    far->updateTransform(glm::vec3(1000.f, 1500.f, 0.f), far->getRotation());
+    BOOST_CHECK_EQUAL(grid.findNearest(glm::vec3(1000.f, 1500.f, 0.f), 10.f),
+                      far);
+    BOOST_CHECK_EQUAL(grid.size(), gw.instancePool.objects.size());
+
+    gw.destroyObject(near);
+    gw.destroyObject(far);
+    gw.destroyObject(outside);
+    BOOST_CHECK(gw.instancePool.getGrid().findNearest(
+                    glm::vec3(1010.f, 1000.f, 0.f), 50.f) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_object_pool_duplicate_id) {
+    auto& gw = *Global::get().e;
+
+    GameWorld::ObjectPool pool;
+    auto first = std::make_unique<InstanceObject>(
+        &gw, glm::vec3(1000.f, 1000.f, 0.f), glm::quat{1.f, 0.f, 0.f, 0.f},
+        glm::vec3(1.f), nullptr, nullptr);
+    auto second = std::make_unique<InstanceObject>(
+        &gw, glm::vec3(1000.f, 1000.f, 0.f), glm::quat{1.f, 0.f, 0.f, 0.f},
+        glm::vec3(1.f), nullptr, nullptr);
+    first->setGameObjectID(5);
+    second->setGameObjectID(5);
+    auto replacement = second.get();
+    pool.insert(std::move(first));
+    pool.insert(std::move(second));
+
+    // The replaced object is gone from the grid as well
+    BOOST_CHECK_EQUAL(pool.find(5), replacement);
+    BOOST_CHECK_EQUAL(pool.objects.size(), 1);
+    BOOST_CHECK_EQUAL(pool.getGrid().size(), 1);
+    BOOST_CHECK_EQUAL(
+        pool.getGrid().findNearest(glm::vec3(1000.f, 1000.f, 0.f), 10.f),
+        replacement);
+
+    pool.remove(replacement);
+    BOOST_CHECK_EQUAL(pool.getGrid().size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(test_offsetgametime) {
     auto& gw = *Global::get().e;
     gw.state = new GameState();
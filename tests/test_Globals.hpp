@@ -19,6 +19,7 @@
 #include <objects/GameObject.hpp>
 #include <glm/gtx/string_cast.hpp>
 
+#include <chrono>
 #include <memory>
 
 #define DATA_TEST_PREDICATE * boost::unit_test_framework::label("data-test")\
@@ -88,6 +89,26 @@ BOOST_NS_MAGIC_CLOSING
 #undef BOOST_NS_MAGIC
 #undef BOOST_NS_MAGIC_CLOSING
 
+/**
+ * Wall time for the benchmark test cases, in milliseconds
+ */
+class BenchmarkTimer {
+public:
+    /// Milliseconds since construction or the last restart()
+    double elapsed() const {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    }
+
+    void restart() {
+        start = Clock::now();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+};
+
 class Global {
 public:
     GameWindow window;
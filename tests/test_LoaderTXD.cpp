@@ -0,0 +1,284 @@
+#include <boost/test/unit_test.hpp>
+#include <loaders/LoaderTXD.hpp>
+#include <loaders/RWBinaryStream.hpp>
+#include <platform/FileHandle.hpp>
+#include "test_Globals.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+template <class T>
+void append(std::vector<char>& out, const T& value) {
+    auto bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void appendHeader(std::vector<char>& out, uint32_t id, size_t size) {
+    append(out, RW::BSSectionHeader{id, static_cast<uint32_t>(size), 0});
+}
+
+RW::BSTextureNative makeNative(uint32_t rasterformat, uint16_t width,
+                               uint16_t height, uint8_t mipmaps = 1) {
+    RW::BSTextureNative native{};
+    native.platform = 8;
+    native.filterflags = RW::BSTextureNative::FILTER_LINEAR;
+    native.wrapU = RW::BSTextureNative::WRAP_WRAP;
+    native.wrapV = RW::BSTextureNative::WRAP_CLAMP;
+    std::strcpy(native.diffuseName, "Test");
+    native.rasterformat = rasterformat;
+    native.width = width;
+    native.height = height;
+    native.nummipmaps = mipmaps;
+    return native;
+}
+
+/// Build a TXD holding one texture, raster is what follows the fields
+/// before datasize: the palette if any, then the size and data of each level
+FileContentsInfo makeTXD(const RW::BSTextureNative& native,
+                         const std::vector<uint8_t>& raster) {
+    const auto fields = offsetof(RW::BSTextureNative, datasize);
+    std::vector<char> structure(reinterpret_cast<const char*>(&native),
+                                reinterpret_cast<const char*>(&native) +
+                                    fields);
+    structure.insert(structure.end(), raster.begin(), raster.end());
+
+    std::vector<char> texture;
+    appendHeader(texture, RW::SID_Struct, structure.size());
+    texture.insert(texture.end(), structure.begin(), structure.end());
+
+    std::vector<char> dictionary;
+    appendHeader(dictionary, RW::SID_Struct, sizeof(RW::BSTextureDictionary));
+    append(dictionary, RW::BSTextureDictionary{1, 0});
+    appendHeader(dictionary, RW::SID_TextureNative, texture.size());
+    dictionary.insert(dictionary.end(), texture.begin(), texture.end());
+
+    std::vector<char> file;
+    appendHeader(file, RW::SID_TextureDictionary, dictionary.size());
+    file.insert(file.end(), dictionary.begin(), dictionary.end());
+
+    auto data = std::make_unique<char[]>(file.size());
+    std::memcpy(data.get(), file.data(), file.size());
+    return {std::move(data), file.size()};
+}
+
+void appendLevel(std::vector<uint8_t>& raster,
+                 const std::vector<uint8_t>& pixels) {
+    const auto size = static_cast<uint32_t>(pixels.size());
+    auto bytes = reinterpret_cast<const uint8_t*>(&size);
+    raster.insert(raster.end(), bytes, bytes + sizeof(size));
+    raster.insert(raster.end(), pixels.begin(), pixels.end());
+}
+
+std::vector<DecodedTexture> decode(const FileContentsInfo& file) {
+    std::vector<DecodedTexture> textures;
+    BOOST_REQUIRE(TextureLoader::decode(file, textures));
+    BOOST_REQUIRE_EQUAL(textures.size(), 1);
+    return textures;
+}
+
+/// A 2x2 RGBA texture with two levels filled with value
+DecodedTexture makeDecoded(const std::string& name, uint8_t value) {
+    DecodedTexture texture;
+    texture.name = name;
+    texture.size = {2, 2};
+    texture.levels = {std::vector<uint8_t>(16, value),
+                      std::vector<uint8_t>(4, value)};
+    return texture;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(LoaderTXDTests)
+
+BOOST_AUTO_TEST_CASE(test_decode_palette) {
+    std::vector<uint8_t> raster(1024, 0);
+    // Index 1 is red, index 2 is transparent blue
+    const uint8_t red[] = {255, 0, 0, 255};
+    const uint8_t blue[] = {0, 0, 255, 0};
+    std::memcpy(&raster[4], red, 4);
+    std::memcpy(&raster[8], blue, 4);
+    appendLevel(raster, {1, 1, 2, 2});
+
+    auto textures = decode(makeTXD(
+        makeNative(RW::BSTextureNative::FORMAT_EXT_PAL8 |
+                       RW::BSTextureNative::FORMAT_8888,
+                   2, 2),
+        raster));
+    const auto& texture = textures[0];
+    BOOST_CHECK_EQUAL(texture.name, "test");
+    BOOST_CHECK(texture.transparent);
+    BOOST_CHECK_EQUAL(texture.wrapS, GL_REPEAT);
+    BOOST_CHECK_EQUAL(texture.wrapT, GL_CLAMP_TO_EDGE);
+
+    // The 1x1 level is generated
+    BOOST_REQUIRE_EQUAL(texture.levels.size(), 2);
+    const std::vector<uint8_t> level0{255, 0, 0, 255, 255, 0, 0, 255,
+                                      0,   0, 255, 0, 0, 0, 255, 0};
+    BOOST_CHECK(texture.levels[0] == level0);
+    const std::vector<uint8_t> level1{128, 0, 128, 128};
+    BOOST_CHECK(texture.levels[1] == level1);
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_keep_palette) {
+    std::vector<uint8_t> raster(1024, 0);
+    // Index 3 is closest to the average of 1 and 2
+    const uint8_t red[] = {255, 0, 0, 255};
+    const uint8_t blue[] = {0, 0, 255, 0};
+    const uint8_t purple[] = {128, 0, 128, 128};
+    std::memcpy(&raster[4], red, 4);
+    std::memcpy(&raster[8], blue, 4);
+    std::memcpy(&raster[12], purple, 4);
+    const std::vector<uint8_t> palette(raster.begin(), raster.end());
+    appendLevel(raster, {1, 2});
+
+    std::vector<DecodedTexture> textures;
+    BOOST_REQUIRE(TextureLoader::decode(
+        makeTXD(makeNative(RW::BSTextureNative::FORMAT_EXT_PAL8 |
+                               RW::BSTextureNative::FORMAT_8888,
+                           2, 1),
+                raster),
+        textures, true));
+    BOOST_REQUIRE_EQUAL(textures.size(), 1);
+    const auto& texture = textures[0];
+    BOOST_CHECK(texture.isPaletted());
+    BOOST_CHECK(texture.palette == palette);
+
+    BOOST_REQUIRE_EQUAL(texture.levels.size(), 2);
+    const std::vector<uint8_t> level0{1, 2};
+    BOOST_CHECK(texture.levels[0] == level0);
+    const std::vector<uint8_t> level1{3};
+    BOOST_CHECK(texture.levels[1] == level1);
+
+    // Other formats are still expanded
+    raster.clear();
+    appendLevel(raster, {0, 0, 0, 0});
+    textures.clear();
+    BOOST_REQUIRE(TextureLoader::decode(
+        makeTXD(makeNative(RW::BSTextureNative::FORMAT_8888, 1, 1), raster),
+        textures, true));
+    BOOST_REQUIRE_EQUAL(textures.size(), 1);
+    BOOST_CHECK(!textures[0].isPaletted());
+    BOOST_CHECK_EQUAL(textures[0].levels[0].size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_stored_mipmaps) {
+    std::vector<uint8_t> raster;
+    // BGRA, the alpha of 888 rasters is ignored
+    appendLevel(raster, {10, 20, 30, 0, 10, 20, 30, 0, 10, 20, 30, 0, 10, 20,
+                         30, 0, 10, 20, 30, 0, 10, 20, 30, 0, 10, 20, 30, 0,
+                         10, 20, 30, 0});
+    appendLevel(raster, {1, 2, 3, 0, 1, 2, 3, 0});
+
+    auto textures = decode(makeTXD(
+        makeNative(RW::BSTextureNative::FORMAT_888 |
+                       RW::BSTextureNative::FORMAT_EXT_MIPMAP,
+                   4, 2, 2),
+        raster));
+    const auto& texture = textures[0];
+    BOOST_CHECK(!texture.transparent);
+    BOOST_REQUIRE_EQUAL(texture.levels.size(), 3);
+    BOOST_CHECK_EQUAL(texture.levels[0].size(), 4 * 2 * 4);
+    BOOST_CHECK_EQUAL(texture.levels[0][0], 30);
+    BOOST_CHECK_EQUAL(texture.levels[0][2], 10);
+    BOOST_CHECK_EQUAL(texture.levels[0][3], 255);
+
+    // The stored level is used rather than a generated one
+    const std::vector<uint8_t> level1{3, 2, 1, 255, 3, 2, 1, 255};
+    BOOST_CHECK(texture.levels[1] == level1);
+    const std::vector<uint8_t> level2{3, 2, 1, 255};
+    BOOST_CHECK(texture.levels[2] == level2);
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_1555) {
+    std::vector<uint8_t> raster;
+    // Opaque red and transparent green
+    appendLevel(raster, {0x00, 0xFC, 0xE0, 0x03});
+
+    auto textures = decode(makeTXD(
+        makeNative(RW::BSTextureNative::FORMAT_1555, 2, 1), raster));
+    const std::vector<uint8_t> level0{255, 0, 0, 255, 0, 255, 0, 0};
+    BOOST_REQUIRE_EQUAL(textures[0].levels.size(), 2);
+    BOOST_CHECK(textures[0].levels[0] == level0);
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_errors) {
+    std::vector<uint8_t> raster;
+    appendLevel(raster, {1, 2});
+
+    // Unsupported format
+    auto textures = decode(makeTXD(
+        makeNative(RW::BSTextureNative::FORMAT_565, 1, 1), raster));
+    BOOST_CHECK_EQUAL(textures[0].size.x, 2);
+    BOOST_CHECK_EQUAL(textures[0].levels.size(), 1);
+
+    // Truncated raster
+    textures = decode(makeTXD(
+        makeNative(RW::BSTextureNative::FORMAT_8888, 4, 4), raster));
+    BOOST_CHECK_EQUAL(textures[0].size.x, 2);
+    BOOST_CHECK_EQUAL(textures[0].levels.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_pack_arrays) {
+    std::vector<DecodedTexture> textures;
+    textures.push_back(makeDecoded("a", 1));
+    textures.push_back(makeDecoded("b", 2));
+    textures.back().transparent = true;
+    textures.push_back(makeDecoded("c", 3));
+    // Different sampling, paletted and lone textures stay as they are
+    textures.push_back(makeDecoded("clamped", 4));
+    textures.back().wrapS = GL_CLAMP_TO_EDGE;
+    textures.push_back(makeDecoded("paletted", 5));
+    textures.back().palette.resize(DecodedTexture::kPaletteSize);
+
+    TextureLoader::packArrays(textures);
+    BOOST_REQUIRE_EQUAL(textures.size(), 3);
+    BOOST_CHECK_EQUAL(textures[0].name, "clamped");
+    BOOST_CHECK(!textures[0].isArray());
+    BOOST_CHECK_EQUAL(textures[1].name, "paletted");
+    BOOST_CHECK(!textures[1].isArray());
+
+    const auto& array = textures[2];
+    BOOST_REQUIRE(array.isArray());
+    BOOST_REQUIRE_EQUAL(array.layers.size(), 3);
+    BOOST_CHECK_EQUAL(array.layers[0].name, "a");
+    BOOST_CHECK(!array.layers[0].transparent);
+    BOOST_CHECK_EQUAL(array.layers[1].name, "b");
+    BOOST_CHECK(array.layers[1].transparent);
+    BOOST_CHECK_EQUAL(array.layers[2].name, "c");
+    BOOST_CHECK(array.transparent);
+    BOOST_CHECK_EQUAL(array.size.x, 2);
+
+    // Each level holds the layers one after the other
+    BOOST_REQUIRE_EQUAL(array.levels.size(), 2);
+    BOOST_REQUIRE_EQUAL(array.levels[0].size(), 48);
+    BOOST_REQUIRE_EQUAL(array.levels[1].size(), 12);
+    BOOST_CHECK_EQUAL(array.levels[0][0], 1);
+    BOOST_CHECK_EQUAL(array.levels[0][16], 2);
+    BOOST_CHECK_EQUAL(array.levels[0][47], 3);
+    BOOST_CHECK_EQUAL(array.levels[1][4], 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_benchmark, DATA_TEST_PREDICATE) {
+    auto file = Global::get().d->index.openFile("particle.txd");
+    BOOST_REQUIRE(file.data != nullptr);
+
+    BenchmarkTimer timer;
+    std::vector<DecodedTexture> textures;
+    BOOST_REQUIRE(TextureLoader::decode(file, textures));
+    auto decoding = timer.elapsed();
+
+    size_t bytes = 0;
+    for (const auto& texture : textures) {
+        BOOST_CHECK(!texture.levels.empty());
+        for (const auto& level : texture.levels) {
+            bytes += level.size();
+        }
+    }
+    BOOST_TEST_MESSAGE(textures.size() << " textures, " << bytes
+                                       << " bytes decoded in " << decoding
+                                       << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,13 @@
 #include <boost/test/unit_test.hpp>
 #include <core/Logger.hpp>
 
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
 class CallbackReceiver : public Logger::MessageReceiver {
 public:
     std::function<void(const Logger::LogMessage&)> func;
@@ -33,4 +40,90 @@ BOOST_AUTO_TEST_CASE(test_receiver) {
     BOOST_CHECK_EQUAL(lastMessage.message, "Test");
 }
 
+BOOST_AUTO_TEST_CASE(test_async_threads) {
+    constexpr int kThreads = 4;
+    constexpr int kMessages = 100;
+    std::vector<std::vector<int>> received(kThreads);
+    CallbackReceiver receiver([&](const Logger::LogMessage& m) {
+        received[std::stoi(m.component)].push_back(std::stoi(m.message));
+    });
+
+    Logger log{&receiver};
+    log.start();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&log, t]() {
+            for (int i = 0; i < kMessages; ++i) {
+                log.info(std::to_string(t), std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    log.stop();
+
+    // Each thread's messages arrive in order
+    BOOST_CHECK_EQUAL(log.getDroppedCount(), 0);
+    for (const auto& messages : received) {
+        BOOST_REQUIRE_EQUAL(messages.size(), kMessages);
+        for (int i = 0; i < kMessages; ++i) {
+            BOOST_CHECK_EQUAL(messages[i], i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_async_truncate) {
+    std::string message;
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage& m) { message = m.message; });
+
+    Logger log{&receiver};
+    log.start();
+    log.error("Tests", std::string(Logger::kRecordTextSize, 'x'));
+    log.flush();
+    BOOST_CHECK_EQUAL(message.size(),
+                      Logger::kRecordTextSize - 5 + std::string("...").size());
+}
+
+BOOST_AUTO_TEST_CASE(test_rate_limit) {
+    std::vector<std::string> messages;
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage& m) { messages.push_back(m.message); });
+
+    {
+        Logger log{&receiver};
+        for (unsigned int i = 0; i < Logger::kMaxRepeats + 3; ++i) {
+            log.error("Tests", "Repeated");
+        }
+        log.error("Tests", "Other");
+        BOOST_CHECK_EQUAL(messages.size(), Logger::kMaxRepeats + 1);
+        BOOST_CHECK_EQUAL(log.getSuppressedCount(), 3);
+    }
+
+    // The count is reported once the window is over
+    BOOST_REQUIRE_EQUAL(messages.size(), Logger::kMaxRepeats + 2);
+    BOOST_CHECK_EQUAL(messages.back(), "Suppressed 3 repeats of: Repeated");
+}
+
+BOOST_AUTO_TEST_CASE(test_json_file) {
+    const std::string path = "test_logger.jsonl";
+    {
+        JsonFileReceiver receiver(path);
+        BOOST_REQUIRE(receiver.isOpen());
+        Logger log{&receiver};
+        log.warning("Tests", "Quote \" and\nnew line");
+    }
+
+    std::ifstream file(path);
+    std::string line;
+    BOOST_REQUIRE(std::getline(file, line));
+    BOOST_CHECK(line.find(R"("severity":"W","component":"Tests",)"
+                          R"("message":"Quote \" and\nnew line"})") !=
+                std::string::npos);
+    BOOST_CHECK(!std::getline(file, line));
+    file.close();
+    std::remove(path.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+#include <boost/test/unit_test.hpp>
+#include <core/TaskScheduler.hpp>
+#include <dynamics/PhysicsQueries.hpp>
+#ifdef _MSC_VER
+#pragma warning(disable : 4305 5033)
+#endif
+#include <btBulletDynamicsCommon.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305 5033)
+#endif
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct QueryFixture {
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher collisionDispatcher;
+    btDbvtBroadphase broadphase;
+    btSequentialImpulseConstraintSolver solver;
+    btDiscreteDynamicsWorld dynamicsWorld;
+    TaskScheduler tasks{3};
+    PhysicsQueries queries;
+
+    btBoxShape box{{1.f, 1.f, 1.f}};
+    std::vector<std::unique_ptr<btRigidBody>> bodies;
+
+    QueryFixture()
+        : collisionDispatcher{&collisionConfig}
+        , dynamicsWorld{&collisionDispatcher, &broadphase, &solver,
+                        &collisionConfig}
+        , queries{broadphase, tasks} {
+        // A 20x20 grid of static boxes on the ground
+        for (int x = 0; x < 20; ++x) {
+            for (int y = 0; y < 20; ++y) {
+                btTransform t;
+                t.setIdentity();
+                t.setOrigin({x * 4.f, y * 4.f, 0.f});
+                btRigidBody::btRigidBodyConstructionInfo info{0.f, nullptr,
+                                                              &box};
+                info.m_startWorldTransform = t;
+                auto body = std::make_unique<btRigidBody>(info);
+                dynamicsWorld.addRigidBody(body.get());
+                bodies.push_back(std::move(body));
+            }
+        }
+        dynamicsWorld.updateAabbs();
+    }
+
+    ~QueryFixture() {
+        for (auto& body : bodies) {
+            dynamicsWorld.removeRigidBody(body.get());
+        }
+    }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(PhysicsQueriesTests)
+
+BOOST_FIXTURE_TEST_CASE(test_cast_ray_hits_box, QueryFixture) {
+    const auto hit = queries.castRay({4.f, 4.f, 10.f}, {4.f, 4.f, -10.f});
+    BOOST_REQUIRE(hit.hit);
+    BOOST_CHECK_CLOSE(hit.position.z, 1.f, 5.f);
+    BOOST_CHECK_EQUAL(hit.body, bodies[21].get());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_cast_ray_ignores_body, QueryFixture) {
+    const auto hit = queries.castRay({4.f, 4.f, 10.f}, {4.f, 4.f, -10.f},
+                                     bodies[21].get());
+    BOOST_CHECK(!hit.hit);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_sphere_test, QueryFixture) {
+    BOOST_CHECK_EQUAL(queries.sphereTest({2.f, 2.f, 0.f}, 1.2f).size(), 4);
+    BOOST_CHECK(queries.sphereTest({2.f, 2.f, 10.f}, 1.2f).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_handles_expire, QueryFixture) {
+    auto ray = queries.queueRay({4.f, 4.f, 10.f}, {4.f, 4.f, -10.f});
+    auto sphere = queries.queueSphere({2.f, 2.f, 0.f}, 1.2f);
+    BOOST_CHECK(queries.getRay(ray) == nullptr);
+
+    queries.flush();
+    BOOST_REQUIRE(queries.getRay(ray) != nullptr);
+    BOOST_CHECK(queries.getRay(ray)->hit);
+    BOOST_REQUIRE(queries.getSphere(sphere) != nullptr);
+    BOOST_CHECK_EQUAL(queries.getSphere(sphere)->size(), 4);
+
+    queries.flush();
+    BOOST_CHECK(queries.getRay(ray) == nullptr);
+    BOOST_CHECK(queries.getSphere(sphere) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_batch_matches_world_raytest, QueryFixture) {
+    constexpr int kRays = 10000;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-5.f, 85.f);
+
+    std::vector<std::pair<glm::vec3, glm::vec3>> rays;
+    std::vector<PhysicsQueries::Handle> handles;
+    for (int i = 0; i < kRays; ++i) {
+        glm::vec3 from(coord(rng), coord(rng), 10.f);
+        glm::vec3 to(coord(rng), coord(rng), -10.f);
+        rays.emplace_back(from, to);
+        handles.push_back(queries.queueRay(from, to));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    queries.flush();
+    auto batched = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<bool> expected;
+    for (const auto& [from, to] : rays) {
+        btVector3 f(from.x, from.y, from.z), t(to.x, to.y, to.z);
+        btCollisionWorld::ClosestRayResultCallback cb(f, t);
+        dynamicsWorld.rayTest(f, t, cb);
+        expected.push_back(cb.hasHit());
+    }
+    auto sequential = std::chrono::steady_clock::now() - start;
+
+    for (int i = 0; i < kRays; ++i) {
+        BOOST_REQUIRE_EQUAL(queries.getRay(handles[i])->hit, expected[i]);
+    }
+
+    using ms = std::chrono::duration<double, std::milli>;
+    BOOST_TEST_MESSAGE("10k rays: batched " << ms(batched).count()
+                                            << " ms, rayTest "
+                                            << ms(sequential).count()
+                                            << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,8 +1,263 @@
 #include <boost/test/unit_test.hpp>
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+#include <gl/TextureUploader.hpp>
+#include <loaders/LoaderTXD.hpp>
 #include <render/GameRenderer.hpp>
+#include <render/GameShaders.hpp>
+#include <render/OpenGLRenderer.hpp>
+#include "test_Globals.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+struct QuadVertex {
+    static const AttributeList vertex_attributes() {
+        return {{ATRS_Position, 3, sizeof(QuadVertex), 0ul},
+                {ATRS_Colour, 4, sizeof(QuadVertex), 3ul * sizeof(float)},
+                {ATRS_TexCoord, 2, sizeof(QuadVertex), 7ul * sizeof(float)}};
+    }
+
+    glm::vec3 position;
+    glm::vec4 colour;
+    glm::vec2 texCoords;
+};
+
+constexpr GLsizei kTargetSize = 64;
+
+/// The world shader with its blocks and samplers set up like GameRenderer
+std::unique_ptr<Renderer::ShaderProgram> createWorldProgram(
+    OpenGLRenderer& renderer) {
+    auto program =
+        renderer.createShader(GameShaders::WorldObject::VertexShader,
+                              GameShaders::WorldObject::FragmentShader);
+    renderer.setProgramBlockBinding(program.get(), "SceneData", 1);
+    renderer.setProgramBlockBinding(program.get(), "ObjectData", 2);
+    // Samplers of different types can't share a unit
+    renderer.setUniformTexture(program.get(), "tex", 0);
+    renderer.setUniformTexture(program.get(), "palette", 1);
+    renderer.setUniformTexture(program.get(), "texArray",
+                               Renderer::kTextureArrayUnit);
+    return program;
+}
+
+/// Draw a quad covering the target with the world shader
+std::vector<uint8_t> renderQuad(OpenGLRenderer& renderer,
+                                Renderer::ShaderProgram* program,
+                                const TextureData& texture, float repeat) {
+    GeometryBuffer geometry;
+    geometry.uploadVertices<QuadVertex>(
+        {{{-1.f, -1.f, 0.f}, glm::vec4(1.f), {0.f, 0.f}},
+         {{1.f, -1.f, 0.f}, glm::vec4(1.f), {repeat, 0.f}},
+         {{-1.f, 1.f, 0.f}, glm::vec4(1.f), {0.f, repeat}},
+         {{1.f, 1.f, 0.f}, glm::vec4(1.f), {repeat, repeat}}});
+    DrawBuffer draw;
+    draw.addGeometry(&geometry);
+    draw.setFaceType(GL_TRIANGLE_STRIP);
+
+    Renderer::SceneUniformData scene;
+    scene.fogStart = 1000.f;
+    scene.fogEnd = 2000.f;
+    renderer.setSceneParameters(scene);
+    renderer.useProgram(program);
+
+    Renderer::DrawParameters dp;
+    dp.count = 4;
+    dp.colour = {255, 255, 255, 255};
+    dp.depthMode = DepthMode::OFF;
+    dp.textures = {{texture.getName(), texture.getPaletteName()}};
+    dp.paletted = texture.isPaletted();
+
+    renderer.clear(glm::vec4(0.f));
+    renderer.drawArrays(glm::mat4(1.f), &draw, dp);
+
+    std::vector<uint8_t> pixels(kTargetSize * kTargetSize * 4);
+    glReadPixels(0, 0, kTargetSize, kTargetSize, GL_RGBA, GL_UNSIGNED_BYTE,
+                 pixels.data());
+    return pixels;
+}
+
+/// Texture binds of kBindDraws draws that alternate between the textures
+/// of a TXD, with the textures packed into arrays or not
+int countTextureBinds(bool pack) {
+    constexpr int kBindTextures = 16;
+    constexpr int kBindDraws = 256;
+
+    // Most textures share a size, as they do in the world TXDs
+    std::vector<DecodedTexture> decoded;
+    for (int i = 0; i < kBindTextures; ++i) {
+        DecodedTexture texture;
+        texture.name = "texture" + std::to_string(i);
+        const int size = i < 12 ? 64 : 32;
+        texture.size = {size, size};
+        for (int level = size; level >= 1; level /= 2) {
+            texture.levels.emplace_back(level * level * 4, uint8_t(i));
+        }
+        decoded.push_back(std::move(texture));
+    }
+    if (pack) {
+        TextureLoader::packArrays(decoded);
+    }
+
+    TextureArchive textures;
+    for (const auto& texture : decoded) {
+        if (!texture.isArray()) {
+            textures[texture.name] = TextureUploader::upload(texture);
+            continue;
+        }
+        std::shared_ptr<TextureData> array = TextureUploader::upload(texture);
+        const auto count = static_cast<int>(texture.layers.size());
+        for (int i = 0; i < count; ++i) {
+            textures[texture.layers[i].name] = TextureData::createLayer(
+                array, i, count, texture.layers[i].transparent);
+        }
+    }
+
+    GeometryBuffer geometry;
+    geometry.uploadVertices<QuadVertex>(
+        {{{-1.f, -1.f, 0.f}, glm::vec4(1.f), {0.f, 0.f}},
+         {{1.f, -1.f, 0.f}, glm::vec4(1.f), {1.f, 0.f}},
+         {{-1.f, 1.f, 0.f}, glm::vec4(1.f), {0.f, 1.f}},
+         {{1.f, 1.f, 0.f}, glm::vec4(1.f), {1.f, 1.f}}});
+    DrawBuffer draw;
+    draw.addGeometry(&geometry);
+    draw.setFaceType(GL_TRIANGLE_STRIP);
+
+    // Consecutive draws never share a texture, as in the depth sorted list
+    RenderList list;
+    for (int i = 0; i < kBindDraws; ++i) {
+        const auto& texture =
+            textures["texture" + std::to_string(i * 7 % kBindTextures)];
+        Renderer::DrawParameters dp;
+        dp.count = 4;
+        dp.colour = {255, 255, 255, 255};
+        dp.textures = {{texture->getName(), texture->getPaletteName()}};
+        if (texture->isArrayLayer()) {
+            dp.textureLayer = texture->getLayer();
+        }
+        list.emplace_back(0, glm::mat4(1.f), &draw, dp);
+    }
+
+    // A new renderer, so no texture is bound yet
+    OpenGLRenderer renderer;
+    auto program = createWorldProgram(renderer);
+    renderer.useProgram(program.get());
+    renderer.drawBatched(list);
+    return renderer.getTextureCount();
+}
+
+double meanDifference(const std::vector<uint8_t>& a,
+                      const std::vector<uint8_t>& b) {
+    double sum = 0.;
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += std::abs(int(a[i]) - int(b[i]));
+    }
+    return sum / a.size();
+}
+}  // namespace
 
 BOOST_AUTO_TEST_SUITE(RendererTests)
 
+BOOST_AUTO_TEST_CASE(test_paletted_matches_rgba, DATA_TEST_PREDICATE) {
+    auto& data = *Global::get().d;
+
+    // Find a palettized texture large enough to be minified
+    DecodedTexture paletted;
+    DecodedTexture rgba;
+    for (const auto name : {"infernus.txd", "generic.txd", "particle.txd"}) {
+        auto file = data.index.openFile(name);
+        if (!file.data) {
+            continue;
+        }
+        std::vector<DecodedTexture> palettedTextures;
+        std::vector<DecodedTexture> rgbaTextures;
+        BOOST_REQUIRE(TextureLoader::decode(file, palettedTextures, true));
+        BOOST_REQUIRE(TextureLoader::decode(file, rgbaTextures));
+        for (size_t i = 0; i < palettedTextures.size(); ++i) {
+            const auto& size = palettedTextures[i].size;
+            if (palettedTextures[i].isPaletted() && size.x >= kTargetSize &&
+                size.y >= kTargetSize) {
+                paletted = std::move(palettedTextures[i]);
+                rgba = std::move(rgbaTextures[i]);
+                break;
+            }
+        }
+        if (paletted.isPaletted()) {
+            break;
+        }
+    }
+    BOOST_REQUIRE(paletted.isPaletted());
+
+    auto palettedTexture = TextureUploader::upload(paletted);
+    auto rgbaTexture = TextureUploader::upload(rgba);
+    BOOST_CHECK_LT(palettedTexture->getMemorySize() * 3,
+                   rgbaTexture->getMemorySize());
+
+    OpenGLRenderer renderer;
+    auto program = createWorldProgram(renderer);
+
+    GLuint target = 0;
+    glGenTextures(1, &target);
+    glBindTexture(GL_TEXTURE_2D, target);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kTargetSize, kTargetSize, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GLuint framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, target, 0);
+    BOOST_REQUIRE_EQUAL(glCheckFramebufferStatus(GL_FRAMEBUFFER),
+                        GL_FRAMEBUFFER_COMPLETE);
+    glViewport(0, 0, kTargetSize, kTargetSize);
+
+    // Magnified the filtering matches closely, minified the generated mip
+    // levels are limited to the palette colours
+    const float texels = static_cast<float>(paletted.size.x);
+    const struct {
+        float repeat;
+        double tolerance;
+    } cases[] = {{kTargetSize / texels / 4.f, 2.},
+                 {4.f * texels / kTargetSize, 12.}};
+    for (const auto& c : cases) {
+        const auto expected =
+            renderQuad(renderer, program.get(), *rgbaTexture, c.repeat);
+        BOOST_CHECK_EQUAL(glGetError(), GL_NO_ERROR);
+        const auto actual =
+            renderQuad(renderer, program.get(), *palettedTexture, c.repeat);
+        BOOST_CHECK_EQUAL(glGetError(), GL_NO_ERROR);
+        // Two blank renders would match as well
+        BOOST_CHECK(std::any_of(expected.begin(), expected.end(),
+                                [](uint8_t value) { return value != 0; }));
+        const auto difference = meanDifference(expected, actual);
+        BOOST_TEST_MESSAGE(paletted.name << " repeated " << c.repeat
+                                         << " times differs by "
+                                         << difference);
+        BOOST_CHECK_LE(difference, c.tolerance);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &target);
+}
+
+BOOST_AUTO_TEST_CASE(test_texture_array_binds, DATA_TEST_PREDICATE) {
+    // Only needed for the GL context
+    Global::get();
+
+    const auto unpacked = countTextureBinds(false);
+    const auto packed = countTextureBinds(true);
+    BOOST_TEST_MESSAGE("Texture binds: " << unpacked << " unpacked, "
+                                         << packed << " packed");
+    // Every draw binds. Packed, only switching between the 64 and the 32
+    // pixel array does, which the draw order does 8 times per 16 draws.
+    BOOST_CHECK_EQUAL(unpacked, 256);
+    BOOST_CHECK_EQUAL(packed, 1 + 8 * 16);
+}
+
 BOOST_AUTO_TEST_CASE(frustum_test_visible) {
     {
         ViewFrustum f(0.1f, 100.f, glm::half_pi<float>(), 1.f);
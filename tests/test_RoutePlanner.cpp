@@ -0,0 +1,134 @@
+#include <boost/test/unit_test.hpp>
+#include "test_Globals.hpp"
+
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
+#include <ai/RoutePlanner.hpp>
+#include <core/TaskScheduler.hpp>
+#include <data/PathData.hpp>
+
+namespace {
+
+/// Two pedestrian paths joining at (0,0) and (20,0), one straight and one
+/// making a detour through (10,30)
+struct RouteFixture {
+    ai::AIGraph graph;
+    TaskScheduler tasks{1};
+    ai::RoutePlanner planner{graph, tasks};
+
+    RouteFixture() {
+        PathData straight{PathData::PATH_PED,
+                          0,
+                          "",
+                          {
+                              {PathNode::EXTERNAL, 1, {0.f, 0.f, 0.f}, 1.f, 0, 0},
+                              {PathNode::INTERNAL, 2, {10.f, 0.f, 0.f}, 1.f, 0, 0},
+                              {PathNode::EXTERNAL, -1, {20.f, 0.f, 0.f}, 1.f, 0, 0},
+                          }};
+        PathData detour{PathData::PATH_PED,
+                        1,
+                        "",
+                        {
+                            {PathNode::EXTERNAL, 1, {0.f, 0.f, 0.f}, 1.f, 0, 0},
+                            {PathNode::INTERNAL, 2, {10.f, 30.f, 0.f}, 1.f, 0, 0},
+                            {PathNode::EXTERNAL, -1, {20.f, 0.f, 0.f}, 1.f, 0, 0},
+                        }};
+        const glm::quat identity{1.0f, 0.0f, 0.0f, 0.0f};
+        graph.createPathNodes(glm::vec3(), identity, straight);
+        graph.createPathNodes(glm::vec3(), identity, detour);
+    }
+
+    ai::AIGraphNode* nodeAt(const glm::vec3& position) {
+        return graph.findNearestNode(position, ai::NodeType::Pedestrian);
+    }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(RoutePlannerTests)
+
+BOOST_FIXTURE_TEST_CASE(test_nearest_node, RouteFixture) {
+    BOOST_CHECK_EQUAL(graph.nodes.size(), 4);
+
+    auto node = nodeAt({9.f, 1.f, 0.f});
+    BOOST_REQUIRE(node != nullptr);
+    BOOST_CHECK(node->position == glm::vec3(10.f, 0.f, 0.f));
+
+    // Nodes several grid cells away are still found
+    node = nodeAt({10.f, 500.f, 0.f});
+    BOOST_REQUIRE(node != nullptr);
+    BOOST_CHECK(node->position == glm::vec3(10.f, 30.f, 0.f));
+
+    BOOST_CHECK(graph.findNearestNode({0.f, 0.f, 0.f},
+                                      ai::NodeType::Vehicle) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_shortest_route, RouteFixture) {
+    auto route = planner.findRoute({0.f, 0.f, 0.f}, {20.f, 0.f, 0.f},
+                                   ai::NodeType::Pedestrian);
+    BOOST_REQUIRE_EQUAL(route.size(), 3);
+    BOOST_CHECK(route[0]->position == glm::vec3(0.f, 0.f, 0.f));
+    BOOST_CHECK(route[1]->position == glm::vec3(10.f, 0.f, 0.f));
+    BOOST_CHECK(route[2]->position == glm::vec3(20.f, 0.f, 0.f));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_disabled_nodes_avoided, RouteFixture) {
+    nodeAt({10.f, 0.f, 0.f})->disabled = true;
+    planner.invalidate();
+
+    auto route = planner.findRoute(nodeAt({0.f, 0.f, 0.f}),
+                                   nodeAt({20.f, 0.f, 0.f}));
+    BOOST_REQUIRE_EQUAL(route.size(), 3);
+    BOOST_CHECK(route[1]->position == glm::vec3(10.f, 30.f, 0.f));
+
+    nodeAt({10.f, 30.f, 0.f})->disabled = true;
+    planner.invalidate();
+
+    route = planner.findRoute(nodeAt({0.f, 0.f, 0.f}),
+                              nodeAt({20.f, 0.f, 0.f}));
+    BOOST_CHECK(route.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_route_cache, RouteFixture) {
+    auto start = nodeAt({0.f, 0.f, 0.f});
+    auto goal = nodeAt({20.f, 0.f, 0.f});
+
+    auto first = planner.findRoute(start, goal);
+    auto second = planner.findRoute(start, goal);
+    BOOST_CHECK(first == second);
+    BOOST_CHECK_EQUAL(planner.getSearchCount(), 1);
+    BOOST_CHECK_EQUAL(planner.getCacheHitCount(), 1);
+    BOOST_CHECK_EQUAL(planner.getCacheSize(), 1);
+
+    planner.invalidate();
+    BOOST_CHECK_EQUAL(planner.getCacheSize(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_route_cache_eviction, RouteFixture) {
+    ai::RoutePlanner small(graph, tasks, 2);
+    auto a = nodeAt({0.f, 0.f, 0.f});
+    auto b = nodeAt({10.f, 0.f, 0.f});
+    auto c = nodeAt({20.f, 0.f, 0.f});
+
+    small.findRoute(a, b);
+    small.findRoute(a, c);
+    small.findRoute(a, b);
+    small.findRoute(b, c);
+    BOOST_CHECK_EQUAL(small.getCacheSize(), 2);
+
+    // a -> c was the least recently used route
+    small.findRoute(a, b);
+    small.findRoute(a, c);
+    BOOST_CHECK_EQUAL(small.getSearchCount(), 4);
+    BOOST_CHECK_EQUAL(small.getCacheHitCount(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_async_route, RouteFixture) {
+    auto future = planner.findRouteAsync({-1.f, 0.f, 0.f}, {21.f, 0.f, 0.f},
+                                         ai::NodeType::Pedestrian);
+    auto route = future.get();
+    BOOST_REQUIRE_EQUAL(route.size(), 3);
+    BOOST_CHECK(route[1]->position == glm::vec3(10.f, 0.f, 0.f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,16 @@
 #include <boost/test/unit_test.hpp>
+#include <core/Logger.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
+#include <objects/CharacterObject.hpp>
 #include <script/SCMFile.hpp>
 #include <script/ScriptMachine.hpp>
+#include <script/ScriptModule.hpp>
+#include <script/modules/GTA3Module.hpp>
+#include "test_Globals.hpp"
+
+#include <algorithm>
+#include <vector>
 
 SCMByte data[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
                   0x01, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -8,6 +18,119 @@ SCMByte data[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
                   0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                   0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
+namespace {
+void testWait(const ScriptArguments& args, const ScriptInt time) {
+    args.getThread()->wakeCounter = time > 0 ? time : -1;
+}
+
+void testGoto(const ScriptArguments& args, const ScriptLabel label) {
+    args.getThread()->programCounter = label;
+}
+
+void testAdd(const ScriptArguments&, ScriptInt& var, const ScriptInt value) {
+    var += value;
+}
+
+/// Header from data followed by code
+SCMFile loadProgram(const std::vector<SCMByte>& code) {
+    std::vector<SCMByte> program(data, data + 0x28);
+    program.insert(program.end(), code.begin(), code.end());
+
+    SCMFile f;
+    f.loadFile(program.data(), program.size());
+    return f;
+}
+
+/// Header from data followed by a loop incrementing the global at offset 4
+/// once per tick
+SCMFile loadLoopProgram() {
+    return loadProgram({
+        0x08, 0x00, 0x02, 0x04, 0x00, 0x04, 0x01,  // 0x28: global 4 += 1
+        0x01, 0x00, 0x04, 0x00,                    // 0x2F: wait 0
+        0x02, 0x00, 0x01, 0x28, 0x00, 0x00, 0x00,  // 0x33: goto 0x28
+    });
+}
+
+std::vector<int> executed;
+
+void testRecord(const ScriptArguments&, const ScriptInt id) {
+    executed.push_back(id);
+}
+
+void testSkippableWait(const ScriptArguments& args, const ScriptInt time) {
+    args.getThread()->wakeCounter = time;
+    args.getThread()->allowWaitSkip = true;
+}
+
+/// Writes the instructions of the scheduler tests, code starts at 0x28
+struct TestAssembler {
+    std::vector<SCMByte> code;
+
+    SCMAddress here() const {
+        return static_cast<SCMAddress>(0x28 + code.size());
+    }
+
+    void int16(int value) {
+        code.insert(code.end(), {0x05, static_cast<SCMByte>(value & 0xFF),
+                                 static_cast<SCMByte>((value >> 8) & 0xFF)});
+    }
+
+    void record(int id) {
+        code.insert(code.end(), {0x03, 0x00});
+        int16(id);
+    }
+
+    void wait(int ms) {
+        code.insert(code.end(), {0x01, 0x00});
+        int16(ms);
+    }
+
+    void skippableWait(int ms) {
+        code.insert(code.end(), {0x04, 0x00});
+        int16(ms);
+    }
+
+    void jump(SCMAddress label) {
+        code.insert(code.end(), {0x02, 0x00, 0x01});
+        for (int i = 0; i < 4; ++i) {
+            code.push_back(static_cast<SCMByte>((label >> (i * 8)) & 0xFF));
+        }
+    }
+
+    /// Records id and waits in a loop
+    SCMAddress loop(int id, int ms) {
+        auto start = here();
+        record(id);
+        wait(ms);
+        jump(start);
+        return start;
+    }
+};
+
+struct ErrorCounter final : Logger::MessageReceiver {
+    int errors = 0;
+
+    void messageReceived(const Logger::LogMessage& message) override {
+        if (message.severity == Logger::Error) {
+            ++errors;
+        }
+    }
+};
+
+ScriptModule& schedulerModule() {
+    static ScriptModule module("scheduler");
+    static bool bound = false;
+    if (!bound) {
+        module.bind<0x0001, 1, testWait>();
+        module.bind<0x0002, 1, testGoto>();
+        module.bind<0x0003, 1, testRecord>();
+        module.bind<0x0004, 1, testSkippableWait>();
+        bound = true;
+    }
+    return module;
+}
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(ScriptMachineTests)
 
 BOOST_AUTO_TEST_CASE(scmfile_test) {
@@ -19,4 +142,334 @@ BOOST_AUTO_TEST_CASE(scmfile_test) {
     BOOST_CHECK_EQUAL(f.getCodeSection(), 0x28);
 }
 
+BOOST_AUTO_TEST_CASE(test_module_lookup) {
+    ScriptModule module("test");
+    module.bind<0x0008, 2, testAdd>();
+    module.bind<0x0002, 1, testGoto>();
+
+    ScriptFunctionMeta* code = nullptr;
+    BOOST_REQUIRE(module.findOpcode(0x0008, &code));
+    BOOST_CHECK_EQUAL(code->arguments, 2);
+    BOOST_CHECK(code->function != nullptr);
+    BOOST_CHECK(module.findOpcode(0x0002, &code));
+    BOOST_CHECK(!module.findOpcode(0x0001, &code));
+    BOOST_CHECK(!module.findOpcode(0x0009, &code));
+    BOOST_CHECK(!module.findOpcode(0x7FFF, &code));
+}
+
+BOOST_AUTO_TEST_CASE(test_instruction_cache, DATA_TEST_PREDICATE) {
+    ScriptModule module("test");
+    module.bind<0x0001, 1, testWait>();
+    module.bind<0x0002, 1, testGoto>();
+    module.bind<0x0008, 2, testAdd>();
+
+    for (bool cached : {false, true}) {
+        auto file = loadLoopProgram();
+        GameState state;
+        state.world = Global::get().e;
+        ScriptMachine machine(&state, file, &module);
+        machine.setInstructionCacheEnabled(cached);
+        machine.startThread(0x28);
+
+        for (int tick = 0; tick < 100; ++tick) {
+            machine.execute(1.f / 60.f);
+        }
+
+        auto counter = *reinterpret_cast<ScriptInt*>(machine.getGlobals() + 4);
+        BOOST_CHECK_EQUAL(counter, 100);
+        BOOST_CHECK_EQUAL(machine.getCachedInstructionCount(), cached ? 3 : 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_out_of_bounds_not_run, DATA_TEST_PREDICATE) {
+    ScriptModule module("test");
+    module.bind<0x0001, 1, testWait>();
+    // A jump that doesn't end a basic block, like the code after it was data
+    module.bind<0x0005, 1, testGoto>();
+    module.bind<0x0008, 2, testAdd>();
+
+    auto file = loadProgram({
+        0x01, 0x00, 0x04, 0x00,                    // 0x28: wait 0
+        0x05, 0x00, 0x01, 0x28, 0x00, 0x00, 0x00,  // 0x2C: jump 0x28
+        0x08, 0x00, 0x03, 0x00, 0x01, 0x04, 0x01,  // 0x33: local 256 += 1
+    });
+    GameState state;
+    state.world = Global::get().e;
+    ScriptMachine machine(&state, file, &module);
+
+    ErrorCounter counter;
+    auto logger = state.world->logger;
+    logger->addReceiver(&counter);
+
+    machine.startThread(0x28);
+    for (int tick = 0; tick < 10; ++tick) {
+        machine.execute(1.f / 60.f);
+    }
+    // The data was decoded ahead, but never ran
+    BOOST_CHECK_EQUAL(machine.getCachedInstructionCount(), 3);
+
+    bool outOfBounds = false;
+    machine.scanCode(0x28, static_cast<SCMAddress>(file.getSize()),
+                     [&](const SCMInstruction&, const SCMParams& params) {
+                         for (const auto& param : params) {
+                             outOfBounds |= param.outOfBounds;
+                         }
+                         return true;
+                     });
+    BOOST_CHECK(outOfBounds);
+
+    logger->flush();
+    logger->removeReceiver(&counter);
+    BOOST_CHECK_EQUAL(counter.errors, 0);
+}
+
+namespace {
+/// The unloaded models that a mission requests with immediate values
+std::vector<ModelID> findMissionModels(ScriptMachine& machine,
+                                       unsigned int mission) {
+    auto data = Global::get().d;
+    const auto& file = machine.getFile();
+    const auto& offsets = file.getMissionOffsets();
+    auto end = mission + 1 < offsets.size()
+                   ? offsets[mission + 1]
+                   : static_cast<SCMAddress>(file.getSize());
+    std::vector<ModelID> models;
+    machine.scanCode(offsets[mission], end,
+                     [&](const SCMInstruction& instruction,
+                         const SCMParams& params) {
+                         if (instruction.opcode != 0x0247 ||
+                             params[0].isLvalue()) {
+                             return true;
+                         }
+                         int id = params[0].integerValue();
+                         if (id < 0) {
+                             id = data->findModelObject(file.getModels()[-id]);
+                         }
+                         auto info = data->modelinfo.find(id);
+                         if (info != data->modelinfo.end() &&
+                             !info->second->isLoaded() &&
+                             std::find(models.begin(), models.end(), id) ==
+                                 models.end()) {
+                             models.push_back(id);
+                         }
+                         return true;
+                     });
+    return models;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_mission_preload, DATA_TEST_PREDICATE) {
+    GTA3Module module;
+    auto file = Global::get().d->loadSCM("main.scm");
+    BOOST_REQUIRE(file);
+    GameState state;
+    state.world = Global::get().e;
+    ScriptMachine machine(&state, file, &module);
+    auto& preloader = machine.getPreloader();
+    auto data = Global::get().d;
+
+    // Find a mission that requests models that aren't loaded
+    unsigned int mission = 0;
+    std::vector<ModelID> models;
+    for (; mission < file.getMissionOffsets().size(); ++mission) {
+        models = findMissionModels(machine, mission);
+        if (!models.empty()) {
+            break;
+        }
+    }
+    BOOST_REQUIRE(!models.empty());
+
+    BOOST_CHECK_GE(preloader.preloadMission(mission), models.size());
+    BOOST_CHECK_GT(data->getPrefetchedFileCount(), 0);
+
+    // Models only report as loaded once they have been created
+    auto model = models.front();
+    data->waitForModel(model);
+    BOOST_CHECK(preloader.isModelLoaded(model));
+    BOOST_CHECK(data->modelinfo[model]->isLoaded());
+    BOOST_CHECK_EQUAL(preloader.getRequestedCount(), 1);
+    preloader.releaseModel(model);
+    BOOST_CHECK_EQUAL(preloader.getRequestedCount(), 0);
+
+    data->modelinfo[model]->unload();
+
+    // Releasing a model that isn't loaded yet drops its files
+    if (models.size() > 1) {
+        auto other = models[1];
+        preloader.requestModel(other);
+        const auto prefetched = data->getPrefetchedFileCount();
+        preloader.releaseModel(other);
+        BOOST_CHECK_LT(data->getPrefetchedFileCount(), prefetched);
+        BOOST_CHECK(!data->modelinfo[other]->isLoaded());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_mission_preload_benchmark, DATA_TEST_PREDICATE) {
+    // Compares the time the main thread spends loading the models of a
+    // mission when they are loaded as they are requested, and when their
+    // files were prefetched while the mission started.
+    GTA3Module module;
+    auto file = Global::get().d->loadSCM("main.scm");
+    BOOST_REQUIRE(file);
+    GameState state;
+    state.world = Global::get().e;
+    ScriptMachine machine(&state, file, &module);
+    auto data = Global::get().d;
+
+    unsigned int mission = 0;
+    std::vector<ModelID> models;
+    for (auto i = 0u; i < file.getMissionOffsets().size(); ++i) {
+        auto found = findMissionModels(machine, i);
+        if (found.size() > models.size()) {
+            mission = i;
+            models = found;
+        }
+    }
+    BOOST_REQUIRE(!models.empty());
+
+    auto unload = [&]() {
+        for (auto model : models) {
+            data->modelinfo[model]->unload();
+        }
+    };
+
+    BenchmarkTimer timer;
+    for (auto model : models) {
+        data->loadModel(model);
+    }
+    auto synchronous = timer.elapsed();
+    unload();
+
+    timer.restart();
+    machine.getPreloader().preloadMission(mission);
+    auto preload = timer.elapsed();
+    for (auto model : models) {
+        data->waitForModel(model);
+    }
+    auto read = timer.elapsed();
+    timer.restart();
+    for (auto model : models) {
+        data->loadModel(model);
+    }
+    auto prefetched = timer.elapsed();
+    unload();
+
+    BOOST_TEST_MESSAGE("mission " << mission << " " << models.size()
+                                  << " models: synchronous " << synchronous
+                                  << " ms, preloading " << preload
+                                  << " ms + " << prefetched
+                                  << " ms after files were read in " << read
+                                  << " ms");
+}
+
+BOOST_AUTO_TEST_CASE(test_scheduler_order, DATA_TEST_PREDICATE) {
+    TestAssembler a;
+    auto first = a.loop(1, 0);
+    auto second = a.loop(2, 1250);
+    auto third = a.loop(3, 500);
+    auto fourth = a.loop(4, 0);
+    auto file = loadProgram(a.code);
+
+    GameState state;
+    state.world = Global::get().e;
+    ScriptMachine machine(&state, file, &schedulerModule());
+    machine.startThread(first);
+    machine.startThread(second);
+    machine.startThread(third);
+
+    // Sleeping threads wake on the first tick where the time passed since
+    // their wait reaches the wait time, in the order they were started.
+    const std::vector<std::vector<int>> expected{
+        {1, 2, 3}, {1, 3}, {1, 3, 4}, {1, 2, 3, 4}, {1, 3, 4}};
+    for (std::size_t tick = 0; tick < expected.size(); ++tick) {
+        executed.clear();
+        machine.execute(0.5f);
+        BOOST_CHECK_EQUAL_COLLECTIONS(executed.begin(), executed.end(),
+                                      expected[tick].begin(),
+                                      expected[tick].end());
+        if (tick == 0) {
+            BOOST_CHECK_EQUAL(machine.getSleepingThreadCount(), 2);
+        }
+        if (tick == 1) {
+            machine.startThread(fourth);
+        }
+    }
+
+    machine.terminateThread(machine.getThreads()[1]);
+    executed.clear();
+    machine.execute(0.5f);
+    machine.execute(0.5f);
+    BOOST_CHECK_EQUAL(machine.getThreads().size(), 3);
+    BOOST_CHECK(std::find(executed.begin(), executed.end(), 2) ==
+                executed.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_scheduler_wait_skip, DATA_TEST_PREDICATE) {
+    TestAssembler a;
+    auto start = a.here();
+    a.record(1);
+    a.skippableWait(30000);
+    a.jump(start);
+    auto file = loadProgram(a.code);
+
+    GameState state;
+    state.world = Global::get().e;
+    ScriptMachine machine(&state, file, &schedulerModule());
+    machine.startThread(start);
+
+    executed.clear();
+    machine.execute(0.5f);
+    machine.execute(0.5f);
+    machine.execute(0.5f);
+    BOOST_CHECK_EQUAL(executed.size(), 1);
+
+    state.input[0].levels[GameInputState::Jump] = 1.f;
+    machine.execute(0.5f);
+    BOOST_CHECK_EQUAL(executed.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_scheduler_wasted, DATA_TEST_PREDICATE) {
+    TestAssembler a;
+    auto mission = a.loop(1, 1000);
+    auto handler = a.loop(9, 30000);
+    auto other = a.loop(2, 100);
+    auto file = loadProgram(a.code);
+
+    auto world = Global::get().e;
+    auto playerID = 9999;
+    auto character = world->createPlayer({0.f, 0.f, 0.f},
+                                         {1.f, 0.f, 0.f, 0.f}, playerID);
+    BOOST_REQUIRE(character != nullptr);
+    world->state->playerObject = playerID;
+
+    GameState state;
+    state.world = world;
+    ScriptMachine machine(&state, file, &schedulerModule());
+    machine.startThread(mission, true);
+    machine.getThreads().back().calls[0] = handler;
+    machine.startThread(other);
+
+    executed.clear();
+    machine.execute(0.5f);
+    const std::vector<int> started{1, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(executed.begin(), executed.end(),
+                                  started.begin(), started.end());
+
+    // The sleeping mission thread is sent to its handler but keeps waiting
+    character->SetDead();
+    executed.clear();
+    machine.execute(0.5f);
+    BOOST_CHECK(machine.getThreads()[0].wastedOrBusted);
+    BOOST_CHECK_EQUAL(machine.getThreads()[0].programCounter, handler);
+    BOOST_CHECK_EQUAL(executed.size(), 1);
+
+    executed.clear();
+    machine.execute(0.5f);
+    const std::vector<int> handled{9, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(executed.begin(), executed.end(),
+                                  handled.begin(), handled.end());
+
+    world->destroyObject(character);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+#include <boost/test/unit_test.hpp>
+#include <script/ScriptMachine.hpp>
+#include <script/ScriptProfiler.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+namespace {
+struct ProfilerFixture {
+    ScriptProfiler profiler;
+    SCMThread thread{};
+    SCMThread idle{};
+    ScriptFunctionMeta wait{nullptr, 1, "wait", ""};
+    ScriptFunctionMeta jump{nullptr, 1, "goto", ""};
+
+    ProfilerFixture() {
+        profiler.reset(0x40);
+        strncpy(thread.name, "MAIN", 16);
+        thread.baseAddress = 0x10;
+        strncpy(idle.name, "IDLE", 16);
+        idle.baseAddress = 0x30;
+
+        profiler.beginTick();
+        profiler.beginThread(thread);
+        profiler.recordInstruction(&wait, 0x0001, 0x10,
+                                   std::chrono::microseconds(5));
+        profiler.recordInstruction(&wait, 0x8001, 0x10,
+                                   std::chrono::microseconds(5));
+        profiler.recordInstruction(&jump, 0x0002, 0x14,
+                                   std::chrono::microseconds(1));
+        profiler.endThread(thread);
+        profiler.beginThread(idle);
+        profiler.endThread(idle);
+        profiler.endTick();
+    }
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ScriptProfilerTests)
+
+BOOST_FIXTURE_TEST_CASE(test_opcode_stats, ProfilerFixture) {
+    BOOST_CHECK_EQUAL(profiler.getTickCount(), 1);
+
+    auto opcodes = profiler.getOpcodeStats();
+    BOOST_REQUIRE_EQUAL(opcodes.size(), 2);
+    // Negated conditions are counted with their opcode
+    BOOST_CHECK_EQUAL(opcodes[0].opcode, 0x0001);
+    BOOST_CHECK_EQUAL(opcodes[0].count, 2);
+    BOOST_CHECK_EQUAL(opcodes[0].time, 10000);
+    BOOST_CHECK_EQUAL(opcodes[0].code, &wait);
+    BOOST_CHECK_EQUAL(opcodes[1].opcode, 0x0002);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_thread_stats, ProfilerFixture) {
+    // Threads that didn't execute anything are left out
+    auto threads = profiler.getThreadStats();
+    BOOST_REQUIRE_EQUAL(threads.size(), 1);
+    BOOST_CHECK_EQUAL(threads[0].name, "MAIN");
+    BOOST_CHECK_EQUAL(threads[0].baseAddress, 0x10);
+    BOOST_CHECK_EQUAL(threads[0].ticks, 1);
+    BOOST_CHECK_EQUAL(threads[0].instructions, 3);
+    BOOST_CHECK_EQUAL(threads[0].tickInstructions, 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_hot_addresses, ProfilerFixture) {
+    auto hot = profiler.getHotAddresses(1);
+    BOOST_REQUIRE_EQUAL(hot.size(), 1);
+    BOOST_CHECK_EQUAL(hot[0].first, 0x10);
+    BOOST_CHECK_EQUAL(hot[0].second, 2);
+
+    BOOST_CHECK_EQUAL(profiler.getHotAddresses(10).size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_export, ProfilerFixture) {
+    std::stringstream csv;
+    profiler.writeCSV(csv);
+    BOOST_CHECK(csv.str().find("opcode,0001,\"wait\",,2,10\n") !=
+                std::string::npos);
+    BOOST_CHECK(csv.str().find("thread,16,\"MAIN\",1,3,") !=
+                std::string::npos);
+
+    std::stringstream json;
+    profiler.writeJSON(json);
+    BOOST_CHECK(json.str().find("\"opcode\": \"0002\", \"name\": \"goto\"") !=
+                std::string::npos);
+    BOOST_CHECK(json.str().find("\"hot_addresses\"") != std::string::npos);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_reset, ProfilerFixture) {
+    profiler.reset();
+    BOOST_CHECK_EQUAL(profiler.getTickCount(), 0);
+    BOOST_CHECK(profiler.getOpcodeStats().empty());
+    BOOST_CHECK(profiler.getThreadStats().empty());
+    BOOST_CHECK(profiler.getHotAddresses(10).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+#include <boost/test/unit_test.hpp>
+#include <audio/SfxBank.hpp>
+#include <audio/SoundSource.hpp>
+#include <core/TaskScheduler.hpp>
+#include <loaders/LoaderSDT.hpp>
+#include "test_Globals.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace {
+struct SfxBankFixture {
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::filesystem::path sdtPath = dir / "openrw_test_sfx.sdt";
+    std::filesystem::path rawPath = dir / "openrw_test_sfx.raw";
+    std::filesystem::path bankPath = dir / "openrw_test_sfx.bank";
+
+    std::vector<std::vector<int16_t>> samples{
+        {1, -2, 3}, {}, {100, 200, 300, 400, 500, -32768, 32767}};
+
+    SfxBankFixture() {
+        std::filesystem::remove(bankPath);
+        writeArchive();
+    }
+
+    ~SfxBankFixture() {
+        std::filesystem::remove(sdtPath);
+        std::filesystem::remove(rawPath);
+        std::filesystem::remove(bankPath);
+    }
+
+    void writeArchive() {
+        std::vector<LoaderSDTFile> assets;
+        std::vector<int16_t> raw;
+        for (const auto& entry : samples) {
+            LoaderSDTFile asset{};
+            asset.offset = static_cast<uint32_t>(raw.size() * 2);
+            asset.size = static_cast<uint32_t>(entry.size() * 2);
+            asset.sampleRate = 22050;
+            asset.loopStart = 1;
+            asset.loopEnd = ~0u;
+            assets.push_back(asset);
+            raw.insert(raw.end(), entry.begin(), entry.end());
+        }
+
+        FILE* sdt = std::fopen(sdtPath.string().c_str(), "wb");
+        std::fwrite(assets.data(), sizeof(LoaderSDTFile), assets.size(), sdt);
+        std::fclose(sdt);
+        FILE* rawFile = std::fopen(rawPath.string().c_str(), "wb");
+        std::fwrite(raw.data(), sizeof(int16_t), raw.size(), rawFile);
+        std::fclose(rawFile);
+    }
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SfxBankTests, SfxBankFixture)
+
+BOOST_AUTO_TEST_CASE(test_build_and_load) {
+    LoaderSDT sdt;
+    BOOST_REQUIRE(sdt.load(sdtPath, rawPath));
+
+    SfxBank bank;
+    BOOST_CHECK(!bank.load(bankPath, sdt));
+    BOOST_CHECK(!bank.isLoaded());
+
+    TaskScheduler workers(2);
+    BOOST_REQUIRE(SfxBank::build(sdt, bankPath, workers));
+    BOOST_REQUIRE(bank.load(bankPath, sdt));
+    BOOST_REQUIRE_EQUAL(bank.size(), samples.size());
+    BOOST_CHECK(bank.get(samples.size()) == nullptr);
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        auto entry = bank.get(i);
+        BOOST_REQUIRE(entry != nullptr);
+        BOOST_CHECK_EQUAL(entry->sampleRate, 22050);
+        BOOST_CHECK_EQUAL(entry->channels, 1);
+        BOOST_CHECK_EQUAL(entry->loopStart, 1);
+        BOOST_CHECK_EQUAL(entry->loopEnd, -1);
+        BOOST_REQUIRE_EQUAL(entry->sampleCount, samples[i].size());
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            entry->samples, entry->samples + entry->sampleCount,
+            samples[i].begin(), samples[i].end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_stale_bank) {
+    LoaderSDT sdt;
+    BOOST_REQUIRE(sdt.load(sdtPath, rawPath));
+    TaskScheduler workers(0);
+    BOOST_REQUIRE(SfxBank::build(sdt, bankPath, workers));
+
+    // A different archive mustn't use the bank
+    samples[0].push_back(4);
+    writeArchive();
+    LoaderSDT changed;
+    BOOST_REQUIRE(changed.load(sdtPath, rawPath));
+
+    SfxBank bank;
+    BOOST_CHECK(!bank.load(bankPath, changed));
+    BOOST_CHECK_EQUAL(bank.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_load_benchmark, DATA_TEST_PREDICATE) {
+    const auto& index = Global::get().d->index;
+
+    LoaderSDT sdt;
+    BOOST_REQUIRE(sdt.load(index.findFilePath("audio/sfx.SDT"),
+                           index.findFilePath("audio/sfx.RAW")));
+    const auto count = std::min<size_t>(sdt.getAssetCount(), 500);
+
+    BenchmarkTimer timer;
+    std::vector<SoundSource> decoded(count);
+    for (size_t i = 0; i < count; ++i) {
+        decoded[i].loadSfx(sdt, i);
+    }
+    auto decoding = timer.elapsed();
+
+    timer.restart();
+    BOOST_REQUIRE(SfxBank::build(sdt, bankPath, Global::get().d->workers));
+    SfxBank bank;
+    BOOST_REQUIRE(bank.load(bankPath, sdt));
+    auto cold = timer.elapsed();
+
+    timer.restart();
+    SfxBank warm;
+    BOOST_REQUIRE(warm.load(bankPath, sdt));
+    std::vector<SoundSource> loaded(count);
+    for (size_t i = 0; i < count; ++i) {
+        loaded[i].loadSfx(*warm.get(i));
+    }
+    auto cached = timer.elapsed();
+
+    BOOST_CHECK_EQUAL(warm.size(), sdt.getAssetCount());
+    BOOST_TEST_MESSAGE(count << " sfx: decoding " << decoding
+                             << " ms, bank cold " << cold << " ms (all "
+                             << sdt.getAssetCount() << " sfx), bank warm "
+                             << cached << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
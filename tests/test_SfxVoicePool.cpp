@@ -0,0 +1,142 @@
+#include <boost/test/unit_test.hpp>
+#include <audio/SfxVoicePool.hpp>
+
+#include <set>
+
+namespace {
+using Emitter = SfxVoicePool::Emitter;
+
+auto ignore = [](size_t) {};
+
+const glm::vec3 kListener{0.f, 0.f, 0.f};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SfxVoicePoolTests)
+
+BOOST_AUTO_TEST_CASE(test_acquire_free_voices) {
+    SfxVoicePool pool(4, 4);
+    std::set<size_t> voices;
+    for (int i = 0; i < 4; ++i) {
+        auto handle = pool.acquire(Emitter{}, kListener, ignore);
+        BOOST_REQUIRE(handle != SfxVoicePool::kNoVoice);
+        voices.insert(pool.find(handle));
+    }
+    BOOST_CHECK_EQUAL(voices.size(), 4);
+    BOOST_CHECK_EQUAL(pool.getActiveCount(), 4);
+    BOOST_CHECK_EQUAL(pool.getStolenCount(), 0);
+
+    pool.release(2);
+    BOOST_CHECK_EQUAL(pool.getActiveCount(), 3);
+    auto handle = pool.acquire(Emitter{}, kListener, ignore);
+    BOOST_CHECK_EQUAL(pool.find(handle), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_release_finished) {
+    SfxVoicePool pool(2, 2);
+    auto once = pool.find(pool.acquire(Emitter{}, kListener, ignore));
+    auto looped = pool.find(pool.acquire(Emitter{}, kListener, ignore));
+    pool.start(once, false, 1.f);
+    pool.start(looped, true, 1.f);
+
+    std::set<size_t> demoted;
+    auto demote = [&](size_t voice) { demoted.insert(voice); };
+    pool.update(kListener, 0.5f, demote, ignore);
+    BOOST_CHECK_EQUAL(pool.getSourceCount(), 2);
+
+    // The one-shot sound ends and gives up its source
+    pool.update(kListener, 0.75f, demote, ignore);
+    BOOST_CHECK_EQUAL(pool.getActiveCount(), 1);
+    BOOST_CHECK(demoted == std::set<size_t>{once});
+    BOOST_CHECK(pool.hasSource(looped));
+    BOOST_CHECK_CLOSE(pool.getPlayTime(looped), 0.25f, 0.01f);
+}
+
+BOOST_AUTO_TEST_CASE(test_steal_quietest) {
+    SfxVoicePool pool(2, 2);
+    auto near = pool.acquire(Emitter{{5.f, 0.f, 0.f}, 50.f, 1.f}, kListener,
+                             ignore);
+    auto far = pool.acquire(Emitter{{40.f, 0.f, 0.f}, 50.f, 1.f}, kListener,
+                            ignore);
+    pool.start(pool.find(far), true, 1.f);
+    pool.update(kListener, 0.f, ignore, ignore);
+
+    // Further away than both playing sounds
+    auto dropped = pool.acquire(Emitter{{45.f, 0.f, 0.f}, 50.f, 1.f},
+                                kListener, ignore);
+    BOOST_CHECK_EQUAL(dropped, SfxVoicePool::kNoVoice);
+
+    std::set<size_t> demoted;
+    auto stolen =
+        pool.acquire(Emitter{{10.f, 0.f, 0.f}, 50.f, 1.f}, kListener,
+                     [&](size_t voice) { demoted.insert(voice); });
+    BOOST_REQUIRE(stolen != SfxVoicePool::kNoVoice);
+    BOOST_CHECK_EQUAL(pool.getStolenCount(), 1);
+    BOOST_CHECK(pool.find(near) != SfxVoicePool::kNoVoice);
+    // The handle of the stolen voice is stale now
+    BOOST_CHECK_EQUAL(pool.find(far), SfxVoicePool::kNoVoice);
+    BOOST_CHECK(stolen != far);
+    // And its source was given up
+    BOOST_CHECK(demoted == std::set<size_t>{pool.find(stolen)});
+    BOOST_CHECK(!pool.hasSource(pool.find(stolen)));
+}
+
+BOOST_AUTO_TEST_CASE(test_virtual_voices) {
+    SfxVoicePool pool(8, 2);
+    std::vector<size_t> voices;
+    // Three audible voices and one out of range
+    for (float x : {10.f, 20.f, 30.f, 200.f}) {
+        auto voice = pool.find(pool.acquire(
+            Emitter{{x, 0.f, 0.f}, 50.f, 1.f}, kListener, ignore));
+        pool.start(voice, true, 2.f);
+        voices.push_back(voice);
+    }
+
+    size_t promotions = 0;
+    auto promote = [&](size_t) { promotions++; };
+    pool.update(kListener, 0.f, ignore, promote);
+    BOOST_CHECK_EQUAL(promotions, 2);
+    BOOST_CHECK_EQUAL(pool.getSourceCount(), 2);
+    BOOST_CHECK(pool.hasSource(voices[0]));
+    BOOST_CHECK(pool.hasSource(voices[1]));
+    BOOST_CHECK(!pool.hasSource(voices[2]));
+    BOOST_CHECK(!pool.hasSource(voices[3]));
+
+    // Walking to the far sounds moves the sources to them
+    std::set<size_t> demoted;
+    pool.update(
+        glm::vec3(190.f, 0.f, 0.f), 0.5f,
+        [&](size_t voice) { demoted.insert(voice); }, promote);
+    BOOST_CHECK(demoted == (std::set<size_t>{voices[0], voices[1]}));
+    BOOST_CHECK(!pool.hasSource(voices[0]));
+    BOOST_CHECK(!pool.hasSource(voices[1]));
+    BOOST_CHECK(!pool.hasSource(voices[2]));
+    BOOST_CHECK(pool.hasSource(voices[3]));
+    BOOST_CHECK_EQUAL(pool.getSourceCount(), 1);
+
+    // Virtual voices kept playing
+    BOOST_CHECK_CLOSE(pool.getPlayTime(voices[0]), 0.5f, 0.01f);
+
+    // A lower cap takes effect on the next update
+    pool.update(glm::vec3(15.f, 0.f, 0.f), 0.f, ignore, ignore);
+    BOOST_CHECK_EQUAL(pool.getSourceCount(), 2);
+    pool.setMaxSources(1);
+    pool.update(glm::vec3(15.f, 0.f, 0.f), 0.f, ignore, ignore);
+    BOOST_CHECK_EQUAL(pool.getSourceCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_audibility) {
+    Emitter emitter{{0.f, 31.f, 0.f}, 61.f, 0.5f};
+    BOOST_CHECK_CLOSE(SfxVoicePool::getAudibility(emitter, kListener), 0.25f,
+                      0.01f);
+    BOOST_CHECK_EQUAL(
+        SfxVoicePool::getAudibility(emitter, glm::vec3(0.f, 100.f, 0.f)),
+        0.f);
+
+    // No max distance
+    emitter.maxDistance = -1.f;
+    BOOST_CHECK_EQUAL(
+        SfxVoicePool::getAudibility(emitter, glm::vec3(0.f, 1000.f, 0.f)),
+        0.5f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
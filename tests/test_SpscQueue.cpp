@@ -0,0 +1,67 @@
+#include <boost/test/unit_test.hpp>
+#include <core/SpscQueue.hpp>
+
+#include <memory>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(SpscQueueTests)
+
+BOOST_AUTO_TEST_CASE(test_fifo) {
+    SpscQueue<int, 4> queue;
+    BOOST_CHECK(queue.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        BOOST_CHECK(queue.push(int(i)));
+    }
+    // Full
+    BOOST_CHECK(!queue.push(4));
+
+    int value;
+    for (int i = 0; i < 4; ++i) {
+        BOOST_REQUIRE(queue.pop(value));
+        BOOST_CHECK_EQUAL(value, i);
+    }
+    BOOST_CHECK(!queue.pop(value));
+    BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_failed_push_keeps_value) {
+    SpscQueue<std::unique_ptr<int>, 1> queue;
+    BOOST_CHECK(queue.push(std::make_unique<int>(1)));
+
+    auto value = std::make_unique<int>(2);
+    BOOST_CHECK(!queue.push(std::move(value)));
+    BOOST_REQUIRE(value != nullptr);
+    BOOST_CHECK_EQUAL(*value, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_threads) {
+    constexpr int kCount = 100000;
+    SpscQueue<int, 64> queue;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < kCount; ++i) {
+            while (!queue.push(int(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    while (expected < kCount) {
+        int value;
+        if (queue.pop(value)) {
+            ordered = ordered && value == expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    BOOST_CHECK(ordered);
+    BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,41 @@
+#include <boost/test/unit_test.hpp>
+#include <core/TaskScheduler.hpp>
+
+#include <atomic>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(TaskSchedulerTests)
+
+BOOST_AUTO_TEST_CASE(test_submit_returns_result) {
+    TaskScheduler tasks(2);
+    auto result = tasks.submit([]() { return 42; });
+    BOOST_CHECK_EQUAL(result.get(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(test_submit_without_workers) {
+    TaskScheduler tasks(0);
+    auto result = tasks.submit([]() { return 7; });
+    BOOST_CHECK_EQUAL(result.get(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_visits_each_index_once) {
+    TaskScheduler tasks(3);
+    std::vector<std::atomic<int>> visits(1000);
+    tasks.parallelFor(0, 1000, 7, [&](int first, int last) {
+        for (int i = first; i < last; ++i) {
+            visits[i]++;
+        }
+    });
+    for (const auto& v : visits) {
+        BOOST_REQUIRE_EQUAL(v.load(), 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_empty_range) {
+    TaskScheduler tasks(2);
+    bool called = false;
+    tasks.parallelFor(5, 5, 1, [&](int, int) { called = true; });
+    BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
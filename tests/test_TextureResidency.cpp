@@ -0,0 +1,116 @@
+#include <boost/test/unit_test.hpp>
+#include <data/Clump.hpp>
+#include <engine/TextureResidency.hpp>
+#include <gl/TextureUploader.hpp>
+#include "test_Globals.hpp"
+
+namespace {
+TextureArchive makeSlot() {
+    // Only needed for the GL context
+    Global::get();
+
+    DecodedTexture texture;
+    texture.name = "texture";
+    texture.size = {16, 16};
+    for (int size = 16; size >= 1; size /= 2) {
+        texture.levels.emplace_back(size * size * 4);
+    }
+    TextureArchive textures;
+    textures[texture.name] = TextureUploader::upload(texture);
+    return textures;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TextureResidencyTests)
+
+BOOST_AUTO_TEST_CASE(test_evict_least_recently_used, DATA_TEST_PREDICATE) {
+    std::unordered_map<std::string, TextureArchive> slots;
+    TextureResidency residency;
+    for (const auto name : {"a", "b", "c", "d"}) {
+        slots[name] = makeSlot();
+        residency.add(name, slots[name]);
+    }
+    const auto slotBytes = slots["a"]["texture"]->getMemorySize();
+    BOOST_CHECK_EQUAL(residency.getResidentBytes(), slotBytes * 4);
+
+    // Within the budget nothing is evicted
+    residency.setBudget(slotBytes * 4);
+    for (auto i = 0u; i < TextureResidency::kMinIdleFrames + 2; ++i) {
+        residency.beginFrame();
+    }
+    BOOST_CHECK_EQUAL(residency.evict(slots, {}), 0);
+
+    // a was drawn recently, b is used by a model, so c and d are left.
+    // c was used before d.
+    residency.setBudget(slotBytes * 3);
+    slots["a"]["texture"]->markUsed(residency.getFrame());
+    slots["c"]["texture"]->markUsed(1);
+    slots["d"]["texture"]->markUsed(2);
+    BOOST_CHECK_EQUAL(residency.evict(slots, {"b"}), 1);
+    BOOST_CHECK_EQUAL(slots.count("c"), 0);
+    BOOST_CHECK_EQUAL(slots.size(), 3);
+    BOOST_CHECK(!residency.isTracked("c"));
+    BOOST_CHECK_EQUAL(residency.getResidentBytes(), slotBytes * 3);
+    BOOST_CHECK_EQUAL(residency.getEvictionCount(), 1);
+    BOOST_CHECK_EQUAL(residency.getEvictedBytes(), slotBytes);
+
+    // Pinned slots stay, even past the budget
+    residency.setBudget(0);
+    residency.pin("d");
+    BOOST_CHECK_EQUAL(residency.evict(slots, {"b"}), 0);
+    BOOST_CHECK_EQUAL(slots.size(), 3);
+    BOOST_CHECK(residency.isOverBudget());
+}
+
+BOOST_AUTO_TEST_CASE(test_recently_loaded_kept, DATA_TEST_PREDICATE) {
+    std::unordered_map<std::string, TextureArchive> slots;
+    TextureResidency residency;
+    residency.setBudget(0);
+    residency.beginFrame();
+    slots["a"] = makeSlot();
+    residency.add("a", slots["a"]);
+
+    // Not drawn yet, but only just loaded
+    BOOST_CHECK_EQUAL(residency.evict(slots, {}), 0);
+    for (auto i = 0u; i < TextureResidency::kMinIdleFrames; ++i) {
+        residency.beginFrame();
+    }
+    BOOST_CHECK_EQUAL(residency.evict(slots, {}), 1);
+    BOOST_CHECK(slots.empty());
+    BOOST_CHECK_EQUAL(residency.getResidentBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_bound_slot_kept, DATA_TEST_PREDICATE) {
+    std::unordered_map<std::string, TextureArchive> slots;
+    TextureResidency residency;
+    residency.setBudget(0);
+    slots["a"] = makeSlot();
+    residency.add("a", slots["a"]);
+    for (auto i = 0u; i < TextureResidency::kMinIdleFrames; ++i) {
+        residency.beginFrame();
+    }
+
+    // A clump of an unloaded model still points to the textures
+    auto clump = std::make_shared<Clump>();
+    auto geometry = std::make_shared<Geometry>();
+    geometry->materials.emplace_back();
+    geometry->materials.back().textures.emplace_back(
+        "texture", "", slots["a"]["texture"].get());
+    auto atomic = std::make_shared<Atomic>();
+    atomic->setGeometry(geometry);
+    clump->addAtomic(atomic);
+    residency.bind("a", geometry);
+    geometry.reset();
+    atomic.reset();
+
+    BOOST_CHECK(residency.isBound("a"));
+    BOOST_CHECK_EQUAL(residency.evict(slots, {}), 0);
+    BOOST_CHECK_EQUAL(slots.count("a"), 1);
+
+    clump.reset();
+    BOOST_CHECK(!residency.isBound("a"));
+    BOOST_CHECK_EQUAL(residency.evict(slots, {}), 1);
+    BOOST_CHECK(slots.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
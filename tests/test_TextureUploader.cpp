@@ -0,0 +1,67 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/TextureUploader.hpp>
+#include "test_Globals.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr int kTextureSize = 256;
+constexpr std::size_t kLevelBytes = kTextureSize * kTextureSize * 4;
+
+/// An RGBA texture with all of its mip levels
+DecodedTexture makeTexture() {
+    DecodedTexture texture;
+    texture.name = "texture";
+    texture.size = {kTextureSize, kTextureSize};
+    for (int size = kTextureSize; size >= 1; size /= 2) {
+        texture.levels.emplace_back(size * size * 4);
+    }
+    return texture;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TextureUploaderTests)
+
+BOOST_AUTO_TEST_CASE(test_frame_budget, DATA_TEST_PREDICATE) {
+    // Only needed for the GL context
+    Global::get();
+
+    TextureUploader uploader;
+    std::vector<std::unique_ptr<TextureData>> textures;
+    for (int i = 0; i < 4; ++i) {
+        textures.push_back(uploader.add(makeTexture()));
+    }
+    // Levels up to 16KB go up right away, the 64KB and 256KB ones wait
+    BOOST_CHECK_EQUAL(uploader.getPendingCount(), 4);
+    BOOST_CHECK_EQUAL(uploader.getPendingBytes(),
+                      4 * (kLevelBytes + kLevelBytes / 4));
+
+    // Less than a level 0, which still goes up on its own
+    const std::size_t budget = kLevelBytes * 5 / 8;
+    int frames = 0;
+    while (uploader.getPendingCount() > 0 && frames < 100) {
+        const auto pendingBytes = uploader.getPendingBytes();
+        const auto uploaded = uploader.process(budget);
+        BOOST_CHECK_GT(uploaded, 0);
+        BOOST_CHECK(uploaded <= budget || uploaded == kLevelBytes);
+        BOOST_CHECK_EQUAL(uploader.getPendingBytes(), pendingBytes - uploaded);
+        frames++;
+    }
+    BOOST_CHECK_EQUAL(uploader.getPendingCount(), 0);
+    BOOST_CHECK_EQUAL(uploader.getPendingBytes(), 0);
+    // Each texture takes two frames, level 1 and then level 0 on its own
+    BOOST_CHECK_EQUAL(frames, 8);
+    BOOST_CHECK_EQUAL(uploader.process(budget), 0);
+
+    // Within the budget everything goes up at once
+    for (int i = 0; i < 4; ++i) {
+        textures.push_back(uploader.add(makeTexture()));
+    }
+    BOOST_CHECK_EQUAL(uploader.process(TextureUploader::kDefaultFrameBudget),
+                      4 * (kLevelBytes + kLevelBytes / 4));
+    BOOST_CHECK_EQUAL(uploader.getPendingCount(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
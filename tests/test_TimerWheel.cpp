@@ -0,0 +1,92 @@
+#include <boost/test/unit_test.hpp>
+#include <core/TimerWheel.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(TimerWheelTests)
+
+BOOST_AUTO_TEST_CASE(test_expires_at_time) {
+    TimerWheel wheel;
+    std::vector<std::uint32_t> expired;
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 5);
+    BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+    wheel.advance(4, expired);
+    BOOST_CHECK(expired.empty());
+
+    wheel.advance(10, expired);
+    BOOST_REQUIRE_EQUAL(expired.size(), 2);
+    BOOST_CHECK_EQUAL(expired[0], 2);
+    BOOST_CHECK_EQUAL(expired[1], 1);
+    BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_past_timers_expire_on_next_advance) {
+    TimerWheel wheel(100);
+    std::vector<std::uint32_t> expired;
+    wheel.schedule(7, 50);
+    wheel.schedule(8, 100);
+    wheel.advance(100, expired);
+    BOOST_REQUIRE_EQUAL(expired.size(), 2);
+    BOOST_CHECK_EQUAL(expired[0], 7);
+    BOOST_CHECK_EQUAL(expired[1], 8);
+}
+
+BOOST_AUTO_TEST_CASE(test_matches_linear_scan) {
+    // Timers spread over every level and the overflow, advanced in uneven
+    // steps, must expire on the first advance that reaches their time.
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<std::uint64_t> delay(0, 20000000);
+    std::uniform_int_distribution<std::uint64_t> step(1, 5000);
+
+    TimerWheel wheel;
+    std::vector<std::uint64_t> times;
+    for (std::uint32_t id = 0; id < 2000; ++id) {
+        times.push_back(id % 4 == 0 ? delay(rng) % 100 : delay(rng));
+        wheel.schedule(id, times.back());
+    }
+
+    std::vector<bool> fired(times.size(), false);
+    std::vector<std::uint32_t> expired;
+    std::uint64_t now = 0;
+    while (wheel.size() > 0) {
+        now += step(rng) * (now > 1000000 ? 200 : 1);
+        expired.clear();
+        wheel.advance(now, expired);
+        for (auto id : expired) {
+            BOOST_REQUIRE(!fired[id]);
+            BOOST_REQUIRE(times[id] <= now);
+            fired[id] = true;
+        }
+        for (std::uint32_t id = 0; id < times.size(); ++id) {
+            BOOST_REQUIRE(fired[id] || times[id] > now);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_remap) {
+    TimerWheel wheel;
+    std::vector<std::uint32_t> expired;
+    wheel.schedule(0, 10);
+    wheel.schedule(1, 5000);
+    wheel.schedule(2, 300000);
+
+    wheel.remap([](std::uint32_t& id) {
+        if (id == 1) {
+            return false;
+        }
+        id += 10;
+        return true;
+    });
+    BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+    wheel.advance(400000, expired);
+    BOOST_REQUIRE_EQUAL(expired.size(), 2);
+    BOOST_CHECK_EQUAL(expired[0], 10);
+    BOOST_CHECK_EQUAL(expired[1], 12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+#include <boost/test/unit_test.hpp>
+#include <core/TraceRecorder.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(TraceRecorderTests)
+
+// Other threads, like the audio streamer's, can record during a capture,
+// so only the test thread's events are counted
+BOOST_AUTO_TEST_CASE(test_records_only_while_capturing) {
+    TraceRecorder::start();
+    TraceRecorder::stop();
+    {
+        TraceScope scope("Ignored");
+    }
+    BOOST_CHECK_EQUAL(TraceRecorder::getThreadEventCount(), 0);
+
+    TraceRecorder::start();
+    {
+        TraceScope scope("Recorded");
+    }
+    TraceRecorder::instant("Frame");
+    TraceRecorder::stop();
+    BOOST_CHECK_EQUAL(TraceRecorder::getThreadEventCount(), 2);
+
+    // The events of the last capture are kept until the next one starts
+    {
+        TraceScope scope("Ignored");
+    }
+    BOOST_CHECK_EQUAL(TraceRecorder::getThreadEventCount(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_chrome_trace) {
+    TraceRecorder::start();
+    std::thread worker([]() {
+        TraceRecorder::setThreadName("Test worker");
+        TraceScope scope("Worker \"scope\"");
+        TraceRecorder::record(TraceRecorder::EventType::CounterAdd, "count",
+                              TraceRecorder::now(), 2);
+    });
+    worker.join();
+    {
+        TraceScope scope("Main scope");
+        TraceRecorder::record(TraceRecorder::EventType::CounterAdd, "count",
+                              TraceRecorder::now(), 3);
+    }
+
+    std::ostringstream out;
+    TraceRecorder::write(out);
+    BOOST_CHECK(!TraceRecorder::isCapturing());
+
+    const auto trace = out.str();
+    BOOST_CHECK_EQUAL(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+    BOOST_CHECK(trace.find(R"({"name":"thread_name","ph":"M")") !=
+                std::string::npos);
+    BOOST_CHECK(trace.find(R"("args":{"name":"Test worker"})") !=
+                std::string::npos);
+    BOOST_CHECK(trace.find(R"({"name":"Worker \"scope\"","ph":"X")") !=
+                std::string::npos);
+    BOOST_CHECK(trace.find(R"({"name":"Main scope","ph":"X")") !=
+                std::string::npos);
+    // Counters are added up in time order over the threads
+    BOOST_CHECK(trace.find(R"("args":{"value":2})") != std::string::npos);
+    BOOST_CHECK(trace.find(R"("args":{"value":5})") != std::string::npos);
+    BOOST_CHECK_EQUAL(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+BOOST_AUTO_TEST_CASE(test_ring_keeps_latest_events) {
+    TraceRecorder::start();
+    for (size_t i = 0; i < TraceRecorder::kBufferSize + 10; ++i) {
+        TraceRecorder::instant("Frame");
+    }
+    TraceRecorder::stop();
+    BOOST_CHECK_EQUAL(TraceRecorder::getThreadEventCount(),
+                      TraceRecorder::kBufferSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include "test_Globals.hpp"
 
+#include <cmath>
+
 #include <ai/AIGraph.hpp>
 #include <ai/AIGraphNode.hpp>
 #include <ai/TrafficDirector.hpp>
@@ -166,4 +168,50 @@ BOOST_AUTO_TEST_CASE(test_create_traffic) {
     // Global::get().e->destroyObject(created[0]);
 }
 
+BOOST_AUTO_TEST_CASE(test_budgeted_update) {
+    ai::AIGraph graph;
+
+    // A ring of spawn points around the camera, outside of half the radius so
+    // the view frustum doesn't matter
+    const glm::vec3 center{1000.f, 1000.f, 0.f};
+    PathData path{PathData::PATH_PED, 0, "", {}};
+    for (int i = 0; i < 6; ++i) {
+        const float angle = glm::radians(60.f * static_cast<float>(i));
+        path.nodes.push_back({PathNode::EXTERNAL, i < 5 ? i + 1 : -1,
+                              center + glm::vec3(std::cos(angle) * 70.f,
+                                                 std::sin(angle) * 70.f, 0.f),
+                              1.f, 0, 0});
+    }
+
+    graph.createPathNodes(glm::vec3(), glm::quat{1.0f,0.0f,0.0f,0.0f}, path);
+
+    // Missing models are only loaded once the workers have read them, the
+    // cop is always one of the spawned models
+    Global::get().e->data->loadModel(1);
+
+    ai::TrafficDirector director(&graph, Global::get().e);
+    director.setPopulationLimits(1000, 0);
+    director.setBudget(1, 1000.f);
+
+    ViewCamera camera(center);
+    director.update(camera, 100.f);
+
+    BOOST_CHECK_EQUAL(director.getCandidateCount(), 6);
+    BOOST_CHECK_EQUAL(director.getMetrics().spawns, 1);
+
+    for (int tick = 0; tick < 10; ++tick) {
+        director.update(camera, 100.f);
+    }
+
+    // Occupied nodes are blocked, so every node gets exactly one ped
+    BOOST_CHECK_EQUAL(director.getMetrics().spawns, 6);
+
+    // Looking away from the peds
+    ViewCamera far(-center, glm::angleAxis(glm::pi<float>(),
+                                            glm::vec3(0.f, 0.f, 1.f)));
+    far.frustum.update(far.frustum.projection() * far.getView());
+    director.cleanup(far, 100.f);
+    BOOST_CHECK_GE(director.getMetrics().despawns, 6);
+}
+
 BOOST_AUTO_TEST_SUITE_END()